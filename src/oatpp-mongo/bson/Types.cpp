@@ -33,6 +33,11 @@ namespace __class {
   const ClassId InlineArray::CLASS_ID("oatpp::mongo::InlineArray");
   const ClassId ObjectId::CLASS_ID("oatpp::mongo::ObjectId");
   const ClassId DateTime::CLASS_ID("oatpp::mongo::DateTime");
+  const ClassId Binary::CLASS_ID("oatpp::mongo::Binary");
+  const ClassId Decimal128::CLASS_ID("oatpp::mongo::Decimal128");
+  const ClassId RawValue::CLASS_ID("oatpp::mongo::RawValue");
+  const ClassId Document::CLASS_ID("oatpp::mongo::Document");
+  const ClassId JsonDocument::CLASS_ID("oatpp::mongo::JsonDocument");
 
 }
 
@@ -27,6 +27,11 @@
 #define oatpp_mongo_bson_Types_hpp
 
 #include "type/ObjectId.hpp"
+#include "type/Binary.hpp"
+#include "type/Decimal128.hpp"
+#include "type/RawValue.hpp"
+#include "type/Document.hpp"
+#include "oatpp/data/share/MemoryLabel.hpp"
 #include "oatpp/Types.hpp"
 
 namespace oatpp { namespace mongo { namespace bson {
@@ -198,19 +203,153 @@ namespace __class {
 
   };
 
+  class Binary {
+  public:
+    static const ClassId CLASS_ID;
+
+    static Type *getType() {
+      static Type type(CLASS_ID);
+      return &type;
+    }
+
+  };
+
+  class Decimal128 {
+  public:
+    static const ClassId CLASS_ID;
+
+    static Type *getType() {
+      static Type type(CLASS_ID);
+      return &type;
+    }
+
+  };
+
+  class RawValue {
+  public:
+    static const ClassId CLASS_ID;
+
+    static Type *getType() {
+      static Type type(CLASS_ID);
+      return &type;
+    }
+
+  };
+
+  class Document {
+  public:
+    static const ClassId CLASS_ID;
+
+    static Type *getType() {
+      static Type type(CLASS_ID);
+      return &type;
+    }
+
+  };
+
+  class JsonDocument {
+  public:
+    static const ClassId CLASS_ID;
+
+    static Type *getType() {
+      static Type type(CLASS_ID);
+      return &type;
+    }
+
+  };
+
 }
 
+/**
+ * ObjectWrapper over ref-counted slice of a binary buffer containing a valid BSON document. <br>
+ * The slice is &id:oatpp::data::share::MemoryLabel;. It holds the memory handle of the source buffer,
+ * so the document bytes are never copied - neither on deserialization nor on serialization. <br>
+ * Note: the slice keeps the whole source buffer alive. Call `captureToOwnMemory()` on the label to detach it.
+ * @tparam Clazz - class of the inline type.
+ */
+template<class Clazz>
+class InlineDocumentWrapper : public oatpp::data::type::ObjectWrapper<data::share::MemoryLabel, Clazz> {
+private:
+  typedef oatpp::data::type::ObjectWrapper<data::share::MemoryLabel, Clazz> Base;
+public:
+
+  InlineDocumentWrapper()
+  {}
+
+  InlineDocumentWrapper(std::nullptr_t)
+  {}
+
+  InlineDocumentWrapper(const std::shared_ptr<data::share::MemoryLabel>& ptr)
+    : Base(ptr)
+  {}
+
+  InlineDocumentWrapper(const std::shared_ptr<data::share::MemoryLabel>& ptr, const Type* const valueType)
+    : Base(ptr, valueType)
+  {}
+
+  /**
+   * Wrap the whole buffer. The buffer is not copied.
+   * @param buffer - buffer containing the BSON document.
+   */
+  InlineDocumentWrapper(const std::shared_ptr<std::string>& buffer)
+    : Base(buffer ? std::make_shared<data::share::MemoryLabel>(buffer) : nullptr)
+  {}
+
+  /**
+   * Wrap the whole buffer. The buffer is not copied.
+   * @param buffer - buffer containing the BSON document.
+   */
+  InlineDocumentWrapper(const oatpp::String& buffer)
+    : InlineDocumentWrapper(buffer.getPtr())
+  {}
+
+  /**
+   * Wrap a slice of the buffer. The buffer is not copied.
+   * @param memoryHandle - buffer holding the data.
+   * @param data - pointer to the BSON document within the buffer.
+   * @param size - size of the BSON document.
+   */
+  InlineDocumentWrapper(const std::shared_ptr<std::string>& memoryHandle, const void* data, v_buff_size size)
+    : Base(std::make_shared<data::share::MemoryLabel>(memoryHandle, data, size))
+  {}
+
+  /**
+   * Pointer to the BSON document.
+   * @return
+   */
+  const char* getData() const {
+    return (const char*) this->m_ptr->getData();
+  }
+
+  /**
+   * Size of the BSON document.
+   * @return
+   */
+  v_buff_size getSize() const {
+    return this->m_ptr->getSize();
+  }
+
+  /**
+   * Copy the BSON document to a new string.
+   * @return
+   */
+  oatpp::String toString() const {
+    return this->m_ptr->toString();
+  }
+
+};
+
 /**
  * Inline Document - is a binary buffer containing a valid BSON document. <br>
- * May be useful in some cases.
+ * May be useful in some cases. See &l:InlineDocumentWrapper;.
  */
-typedef oatpp::data::type::ObjectWrapper<std::string, __class::InlineDocument> InlineDocument;
+typedef InlineDocumentWrapper<__class::InlineDocument> InlineDocument;
 
 /**
  * Inline Array - is a binary buffer containing a valid BSON Array. <br>
- * May be useful in some cases.
+ * May be useful in some cases. See &l:InlineDocumentWrapper;.
  */
-typedef oatpp::data::type::ObjectWrapper<std::string, __class::InlineArray> InlineArray;
+typedef InlineDocumentWrapper<__class::InlineArray> InlineArray;
 
 /**
  * ObjectId as oatpp primitive type.
@@ -222,6 +361,71 @@ typedef oatpp::data::type::Primitive<type::ObjectId, __class::ObjectId> ObjectId
  */
 typedef oatpp::data::type::Primitive<v_int64, __class::DateTime> DateTime;
 
+/**
+ * Binary as oatpp primitive type. See &id:oatpp::mongo::bson::type::Binary;.
+ */
+typedef oatpp::data::type::Primitive<type::Binary, __class::Binary> Binary;
+
+/**
+ * Decimal128 as oatpp primitive type. See &id:oatpp::mongo::bson::type::Decimal128;.
+ */
+typedef oatpp::data::type::Primitive<type::Decimal128, __class::Decimal128> Decimal128;
+
+/**
+ * RawValue as oatpp primitive type. See &id:oatpp::mongo::bson::type::RawValue;. <br>
+ * Field of this type accepts element of any BSON type.
+ */
+typedef oatpp::data::type::Primitive<type::RawValue, __class::RawValue> RawValue;
+
+/**
+ * ObjectWrapper over a string containing a JSON object. Extended JSON wrappers are supported. <br>
+ * Serializer transcodes it to a BSON document with &id:oatpp::mongo::bson::json::JsonToBson; in a single pass -
+ * no DTOs are created. Deserializer reads a BSON document to it with &id:oatpp::mongo::bson::json::BsonToJson;. <br>
+ * Can be a DTO field or a root object of the mapper.
+ */
+class JsonDocument : public oatpp::data::type::ObjectWrapper<std::string, __class::JsonDocument> {
+private:
+  typedef oatpp::data::type::ObjectWrapper<std::string, __class::JsonDocument> Base;
+public:
+
+  JsonDocument()
+  {}
+
+  JsonDocument(std::nullptr_t)
+  {}
+
+  JsonDocument(const std::shared_ptr<std::string>& ptr)
+    : Base(ptr)
+  {}
+
+  JsonDocument(const std::shared_ptr<std::string>& ptr, const Type* const valueType)
+    : Base(ptr, valueType)
+  {}
+
+  /**
+   * Wrap JSON string. The string is not copied.
+   * @param json - JSON object.
+   */
+  JsonDocument(const oatpp::String& json)
+    : Base(json.getPtr())
+  {}
+
+  /**
+   * Get JSON as `oatpp::String`. The string is not copied.
+   * @return
+   */
+  oatpp::String toString() const {
+    return oatpp::String(this->m_ptr);
+  }
+
+};
+
+/**
+ * Document as oatpp primitive type. See &id:oatpp::mongo::bson::type::Document;. <br>
+ * Ref-counted view of a BSON document. Can be a DTO field, a root object of the mapper, or a command/reply document.
+ */
+typedef oatpp::data::type::Primitive<type::Document, __class::Document> Document;
+
 }}}
 
 #endif // oatpp_mongo_bson_Types_hpp
@@ -29,8 +29,10 @@
 
 namespace oatpp { namespace mongo { namespace bson {
 
-Utils::BO_TYPE Utils::INT_BO = detectIntBO();
-Utils::BO_TYPE Utils::FLOAT_BO = detectFloatBO();
+constexpr bool Utils::HOST_LITTLE_ENDIAN;
+constexpr Utils::BO_TYPE Utils::INT_BO;
+constexpr Utils::BO_TYPE Utils::FLOAT_BO;
+constexpr v_buff_size Utils::ARRAY_CHUNK_SIZE;
 
 Utils::BO_TYPE Utils::detectIntBO() {
   BO_TYPE result = BO_TYPE::UNKNOWN;
@@ -67,6 +69,74 @@ oatpp::String Utils::readCString(utils::parser::Caret& caret) {
   return nullptr;
 }
 
+void Utils::skipCString(utils::parser::Caret& caret) {
+  caret.findChar(0);
+  if(!caret.canContinueAtChar(0, 1)) {
+    caret.setError("[oatpp::mongo::bson::Utils::skipCString()]: Error. Unterminated CString.");
+  }
+}
+
+void Utils::skipSizedElement(utils::parser::Caret& caret, v_int32 additionalBytes) {
+  v_int32 size = readInt32(caret);
+  if (size + caret.getPosition() + additionalBytes > caret.getDataSize() || size + additionalBytes < 0) {
+    caret.setError("[oatpp::mongo::bson::Utils::skipSizedElement()]: Error. Invalid element size.");
+  }
+  caret.inc(size + additionalBytes);
+}
+
+void Utils::skipElement(utils::parser::Caret& caret, v_char8 bsonTypeCode) {
+
+  switch(bsonTypeCode) {
+
+    case TypeCode::DOUBLE: caret.inc(8);                            break;
+    case TypeCode::STRING: skipSizedElement(caret);                 break;
+    case TypeCode::DOCUMENT_EMBEDDED: skipSizedElement(caret, -4);  break;
+    case TypeCode::DOCUMENT_ARRAY: skipSizedElement(caret, -4);     break;
+    case TypeCode::BINARY: skipSizedElement(caret, 1);              break;
+    case TypeCode::UNDEFINED:                                       break;
+    case TypeCode::OBJECT_ID: caret.inc(12);                        break;
+    case TypeCode::BOOLEAN: caret.inc();                            break;
+    case TypeCode::DATE_TIME: caret.inc(8);                         break;
+    case TypeCode::NULL_VALUE:                                      break;
+    case TypeCode::REGEXP: skipCString(caret); skipCString(caret);  break;
+    case TypeCode::BD_POINTER: skipSizedElement(caret, 12);         break;
+    case TypeCode::JAVASCRIPT_CODE: skipSizedElement(caret);        break;
+    case TypeCode::SYMBOL: skipSizedElement(caret);                 break;
+    case TypeCode::JAVASCRIPT_CODE_WS: skipSizedElement(caret, -4); break;
+    case TypeCode::INT_32: caret.inc(4);                            break;
+    case TypeCode::TIMESTAMP: caret.inc(8);                         break;
+    case TypeCode::INT_64: caret.inc(8);                            break;
+    case TypeCode::DECIMAL_128: caret.inc(16);                      break;
+
+    case TypeCode::MIN_KEY:                                         break;
+    case TypeCode::MAX_KEY:                                         break;
+
+    default:
+      caret.setError("[oatpp::mongo::bson::Utils::skipElement()]: Error. Unknown element type-code.");
+      return;
+  }
+
+}
+
+v_int32 Utils::countElements(const char* data, v_buff_size size) {
+
+  utils::parser::Caret caret(data, size);
+  v_int32 count = 0;
+
+  while(caret.canContinue() && caret.getPosition() < size - 1) {
+    v_char8 typeCode;
+    skipKey(caret, typeCode);
+    skipElement(caret, typeCode);
+    if(caret.hasError()) {
+      return -1;
+    }
+    ++ count;
+  }
+
+  return count;
+
+}
+
 void Utils::writeKey(ConsistentOutputStream *stream, TypeCode typeCode, const StringKeyLabel &key) {
   if (key) {
     stream->writeCharSimple(typeCode);
@@ -89,223 +159,59 @@ oatpp::String Utils::readKey(utils::parser::Caret& caret, v_char8& typeCode) {
   return nullptr;
 }
 
-void Utils::writeInt32(ConsistentOutputStream *stream, v_int32 value, BO_TYPE valueBO) {
-
-  switch(valueBO) {
-
-    case BO_TYPE::LITTLE:
-      stream->writeSimple(&value, 4);
-      break;
-
-    default: {
-      v_uint8 data[4];
-      data[0] = (v_uint8) (0xFF & value);
-      data[1] = (v_uint8) (0xFF & (value >> 8));
-      data[2] = (v_uint8) (0xFF & (value >> 16));
-      data[3] = (v_uint8) (0xFF & (value >> 24));
-      stream->writeSimple(data, 4);
-    }
-
-  }
-
-}
-
-v_int32 Utils::readInt32(utils::parser::Caret& caret, BO_TYPE valueBO) {
-
-  if(caret.getDataSize() - caret.getPosition() < 4) {
-    caret.setError("[oatpp::mongo::bson::Utils::readInt32()]: Error. Invalid Int32 value.");
-    return 0;
-  }
-
-  v_int32 result;
-
-  switch(valueBO) {
-
-    case BO_TYPE::LITTLE:
-      result = *((p_int32) caret.getCurrData());
-      break;
-
-    default: {
-      auto data = caret.getCurrData();
-      result = data[0] | (data[1] << 8) | (data[2] << 16) | (data[3] << 24);
-    }
-
+Utils::StringKeyLabel Utils::readKeyLabel(utils::parser::Caret& caret, v_char8& typeCode) {
+  typeCode = *caret.getCurrData();
+  caret.inc();
+  auto label = caret.putLabel();
+  if(caret.findChar(0)) {
+    label.end();
+    caret.inc();
+    return StringKeyLabel(nullptr, label.getData(), label.getSize());
   }
 
-  caret.inc(4);
-  return result;
-
-}
-
-void Utils::writeInt64(ConsistentOutputStream *stream, v_int64 value, BO_TYPE valueBO) {
-  switch(valueBO) {
-
-    case BO_TYPE::LITTLE:
-      stream->writeSimple(&value, 8);
-      break;
-
-    default: {
-      v_uint8 data[8];
-      data[0] = (v_uint8) (0xFF & value);
-      data[1] = (v_uint8) (0xFF & (value >> 8));
-      data[2] = (v_uint8) (0xFF & (value >> 16));
-      data[3] = (v_uint8) (0xFF & (value >> 24));
-
-      data[4] = (v_uint8) (0xFF & (value >> 32));
-      data[5] = (v_uint8) (0xFF & (value >> 40));
-      data[6] = (v_uint8) (0xFF & (value >> 48));
-      data[7] = (v_uint8) (0xFF & (value >> 56));
-      stream->writeSimple(data, 8);
-    }
-
-  }
+  caret.setError("[oatpp::mongo::bson::Utils::readKeyLabel()]: Error. Unterminated cstring.");
+  return nullptr;
 }
 
-v_int64 Utils::readInt64(utils::parser::Caret& caret, BO_TYPE valueBO) {
-
-  if(caret.getDataSize() - caret.getPosition() < 8) {
-    caret.setError("[oatpp::mongo::bson::Utils::readInt64()]: Error. Invalid Int64 value.");
-    return 0;
-  }
-
-  v_int64 result;
+bool Utils::readArrayKey(utils::parser::Caret& caret, v_char8& typeCode, v_int32 expectedIndex) {
 
-  switch(valueBO) {
-
-    case BO_TYPE::LITTLE:
-      result = *((p_int64) caret.getCurrData());
-      break;
-
-    default: {
-      p_char8 data = (p_char8) caret.getCurrData();
-      result = ((v_int64) data[0]      ) | ((v_int64) data[1] <<  8) | ((v_int64) data[2] << 16) | ((v_int64) data[3] << 24) |
-               ((v_int64) data[4] << 32) | ((v_int64) data[5] << 40) | ((v_int64) data[6] << 48) | ((v_int64) data[7] << 56);
-    }
+  typeCode = *caret.getCurrData();
+  caret.inc();
 
+  if(expectedIndex < 0) {
+    return false;
   }
 
-  caret.inc(8);
-  return result;
-
-}
-
-void Utils::writeUInt64(ConsistentOutputStream *stream, v_uint64 value, BO_TYPE valueBO) {
-  switch(valueBO) {
+  v_char8 digits[10];
+  v_int32 digitsCount = 0;
+  do {
+    digits[digitsCount ++] = (v_char8) ('0' + expectedIndex % 10);
+    expectedIndex /= 10;
+  } while(expectedIndex > 0);
 
-    case BO_TYPE::LITTLE:
-      stream->writeSimple(&value, 8);
-      break;
+  const v_char8* data = (const v_char8*) caret.getCurrData();
+  v_buff_size available = caret.getDataSize() - caret.getPosition();
 
-    default: {
-      v_uint8 data[8];
-      data[0] = (v_uint8) (0xFF & value);
-      data[1] = (v_uint8) (0xFF & (value >> 8));
-      data[2] = (v_uint8) (0xFF & (value >> 16));
-      data[3] = (v_uint8) (0xFF & (value >> 24));
-
-      data[4] = (v_uint8) (0xFF & (value >> 32));
-      data[5] = (v_uint8) (0xFF & (value >> 40));
-      data[6] = (v_uint8) (0xFF & (value >> 48));
-      data[7] = (v_uint8) (0xFF & (value >> 56));
-      stream->writeSimple(data, 8);
+  if(available > digitsCount) {
+    bool match = (data[digitsCount] == 0);
+    for(v_int32 i = 0; i < digitsCount && match; i ++) {
+      match = (data[i] == digits[digitsCount - 1 - i]);
     }
-
-  }
-}
-
-v_uint64 Utils::readUInt64(utils::parser::Caret& caret, BO_TYPE valueBO) {
-
-  if(caret.getDataSize() - caret.getPosition() < 8) {
-    caret.setError("[oatpp::mongo::bson::Utils::readUInt64()]: Error. Invalid UInt64 value.");
-    return 0;
-  }
-
-  v_uint64 result;
-
-  switch(valueBO) {
-
-    case BO_TYPE::LITTLE:
-      result = *((p_uint64) caret.getCurrData());
-      break;
-
-    default: {
-      p_char8 data = (p_char8) caret.getCurrData();
-      result = ((v_uint64) data[0]      ) | ((v_uint64) data[1] <<  8) | ((v_uint64) data[2] << 16) | ((v_uint64) data[3] << 24) |
-               ((v_uint64) data[4] << 32) | ((v_uint64) data[5] << 40) | ((v_uint64) data[6] << 48) | ((v_uint64) data[7] << 56);
+    if(match) {
+      caret.inc(digitsCount + 1);
+      return true;
     }
-
   }
 
-  caret.inc(8);
-  return result;
+  skipCString(caret);
+  return false;
 
 }
 
-void Utils::writeFloat64(ConsistentOutputStream *stream, v_float64 value, BO_TYPE valueBO) {
-
-  switch(valueBO) {
-
-    case BO_TYPE::LITTLE:
-      stream->writeSimple(&value, 8);
-      break;
-
-    case BO_TYPE::NETWORK: {
-      p_char8 v = (p_char8) &value;
-      v_char8 vi[8] = {v[7], v[6], v[5], v[4], v[3], v[2], v[1], v[0]};
-      stream->writeSimple(vi, 8);
-      break;
-    }
-
-    default: {
-      throw std::runtime_error("[oatpp::mongo::bson::Utils::writeFloat64()]: Error. Can't serialize float64. Value has unknown byte-order.");
-    }
-
-  }
-
-}
-
-v_float64 Utils::readFloat64(utils::parser::Caret& caret, BO_TYPE valueBO) {
-
-  if(caret.getDataSize() - caret.getPosition() < 8) {
-    caret.setError("[oatpp::mongo::bson::Utils::readFloat64()]: Error. Invalid Float64 value.");
-    return 0;
-  }
-
-  v_float64 result;
-
-  switch(valueBO) {
-
-    case BO_TYPE::LITTLE:
-      result = *((p_float64) caret.getCurrData());
-      break;
-
-    case BO_TYPE::NETWORK: {
-
-      p_float64 rp = &result;
-      p_float64 vp = (p_float64) caret.getCurrData();
-
-      rp[7] = vp[0];
-      rp[6] = vp[1];
-      rp[5] = vp[2];
-      rp[4] = vp[3];
-      rp[3] = vp[4];
-      rp[2] = vp[5];
-      rp[1] = vp[6];
-      rp[0] = vp[7];
-
-      break;
-
-    }
-
-    default: {
-      throw std::runtime_error("[oatpp::mongo::bson::Utils::readFloat64()]: Error. Can't deserialize float64. Host has unknown byte-order.");
-    }
-
-  }
-
-  caret.inc(8);
-  return result;
-
+void Utils::skipKey(utils::parser::Caret& caret, v_char8& typeCode) {
+  typeCode = *caret.getCurrData();
+  caret.inc();
+  skipCString(caret);
 }
 
 void Utils::writePrimitive(ConsistentOutputStream *stream, const StringKeyLabel &key, v_int8 value) {
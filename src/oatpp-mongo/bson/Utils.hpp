@@ -32,8 +32,104 @@
 #include "oatpp/data/share/MemoryLabel.hpp"
 #include "oatpp/data/stream/Stream.hpp"
 
+#include <cstring>
+
+/**
+ * Host byte-order is resolved at compile time.
+ * Define `OATPP_MONGO_BSON_HOST_BIG_ENDIAN` to `1` or `0` to override the detection.
+ */
+#ifndef OATPP_MONGO_BSON_HOST_BIG_ENDIAN
+  #if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    #define OATPP_MONGO_BSON_HOST_BIG_ENDIAN 1
+  #else
+    #define OATPP_MONGO_BSON_HOST_BIG_ENDIAN 0
+  #endif
+#endif
+
 namespace oatpp { namespace mongo { namespace bson {
 
+namespace __utils {
+
+/**
+ * Loads and stores of little-endian values. Specialized by the host byte-order.
+ */
+template<bool HostLittleEndian>
+struct ByteOrder;
+
+template<>
+struct ByteOrder<true> {
+
+  template<typename T>
+  static T load(const void* data) {
+    T result;
+    std::memcpy(&result, data, sizeof(T));
+    return result;
+  }
+
+  template<typename T>
+  static void store(void* data, T value) {
+    std::memcpy(data, &value, sizeof(T));
+  }
+
+  template<typename T>
+  static void loadArray(const void* data, T* values, v_buff_size count) {
+    std::memcpy(values, data, count * sizeof(T));
+  }
+
+  template<typename T>
+  static void storeArray(void* data, const T* values, v_buff_size count) {
+    std::memcpy(data, values, count * sizeof(T));
+  }
+
+};
+
+template<>
+struct ByteOrder<false> {
+
+  template<typename T>
+  static T load(const void* data) {
+    const v_char8* src = (const v_char8*) data;
+    v_char8 bytes[sizeof(T)];
+    for(v_buff_size i = 0; i < (v_buff_size) sizeof(T); i ++) {
+      bytes[i] = src[sizeof(T) - 1 - i];
+    }
+    T result;
+    std::memcpy(&result, bytes, sizeof(T));
+    return result;
+  }
+
+  template<typename T>
+  static void store(void* data, T value) {
+    v_char8 bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    v_char8* dst = (v_char8*) data;
+    for(v_buff_size i = 0; i < (v_buff_size) sizeof(T); i ++) {
+      dst[i] = bytes[sizeof(T) - 1 - i];
+    }
+  }
+
+  /* plain loops over fixed-size swaps - left for the compiler to vectorize */
+
+  template<typename T>
+  static void loadArray(const void* data, T* values, v_buff_size count) {
+    const v_char8* src = (const v_char8*) data;
+    for(v_buff_size i = 0; i < count; i ++) {
+      values[i] = load<T>(src + i * sizeof(T));
+    }
+  }
+
+  template<typename T>
+  static void storeArray(void* data, const T* values, v_buff_size count) {
+    v_char8* dst = (v_char8*) data;
+    for(v_buff_size i = 0; i < count; i ++) {
+      store<T>(dst + i * sizeof(T), values[i]);
+    }
+  }
+
+};
+
+}
+
 /**
  * Utils for BSON serialization/deserialization.
  */
@@ -52,6 +148,50 @@ private:
     return false;
   }
 
+  template<typename T>
+  static T readLE(utils::parser::Caret& caret, const char* errorMessage) {
+    if(caret.getDataSize() - caret.getPosition() < (v_buff_size) sizeof(T)) {
+      caret.setError(errorMessage);
+      return 0;
+    }
+    T result = loadLE<T>(caret.getCurrData());
+    caret.inc(sizeof(T));
+    return result;
+  }
+
+  template<typename T>
+  static void writeLE(ConsistentOutputStream *stream, T value) {
+    v_char8 data[sizeof(T)];
+    storeLE<T>(data, value);
+    stream->writeSimple(data, sizeof(T));
+  }
+
+  template<typename T>
+  static bool readLEArray(utils::parser::Caret& caret, T* values, v_buff_size count, const char* errorMessage) {
+    if(count < 0 || (caret.getDataSize() - caret.getPosition()) / (v_buff_size) sizeof(T) < count) {
+      caret.setError(errorMessage);
+      return false;
+    }
+    loadLEArray<T>(caret.getCurrData(), values, count);
+    caret.inc(count * sizeof(T));
+    return true;
+  }
+
+  template<typename T>
+  static void writeLEArray(ConsistentOutputStream *stream, const T* values, v_buff_size count) {
+    if(HOST_LITTLE_ENDIAN) {
+      stream->writeSimple(values, count * sizeof(T));
+      return;
+    }
+    const v_buff_size chunkSize = ARRAY_CHUNK_SIZE / sizeof(T);
+    v_char8 data[ARRAY_CHUNK_SIZE];
+    for(v_buff_size i = 0; i < count; i += chunkSize) {
+      v_buff_size size = count - i < chunkSize ? count - i : chunkSize;
+      storeLEArray<T>(data, values + i, size);
+      stream->writeSimple(data, size * sizeof(T));
+    }
+  }
+
 public:
 
   enum BO_TYPE : v_int32 {
@@ -66,33 +206,257 @@ public:
     v_char8 bytes[8];
   };
 
+  /**
+   * Runtime check of the integer byte-order. Should agree with &l:Utils::INT_BO;.
+   * @return - &l:Utils::BO_TYPE;.
+   */
   static BO_TYPE detectIntBO();
+
+  /**
+   * Runtime check of the float byte-order. Should agree with &l:Utils::FLOAT_BO;.
+   * @return - &l:Utils::BO_TYPE;.
+   */
   static BO_TYPE detectFloatBO();
 
 public:
 
-  static BO_TYPE INT_BO;
-  static BO_TYPE FLOAT_BO;
+  /**
+   * `true` if host is little-endian. BSON values are little-endian so no byte swapping is needed then.
+   */
+  static constexpr bool HOST_LITTLE_ENDIAN = (OATPP_MONGO_BSON_HOST_BIG_ENDIAN == 0);
+
+  static constexpr BO_TYPE INT_BO = HOST_LITTLE_ENDIAN ? BO_TYPE::LITTLE : BO_TYPE::NETWORK;
+  static constexpr BO_TYPE FLOAT_BO = INT_BO;
+
+  /**
+   * Size of the stack buffer used by array writers to convert values on big-endian hosts.
+   */
+  static constexpr v_buff_size ARRAY_CHUNK_SIZE = 1024;
+
+public:
+
+  /**
+   * Load little-endian value from memory. Memory doesn't have to be aligned. Doesn't check bounds.
+   * @tparam T - integer or float type.
+   * @param data - pointer to `sizeof(T)` bytes.
+   * @return - value in host byte-order.
+   */
+  template<typename T>
+  static T loadLE(const void* data) {
+    return __utils::ByteOrder<HOST_LITTLE_ENDIAN>::template load<T>(data);
+  }
+
+  /**
+   * Store value to memory in little-endian byte-order. Memory doesn't have to be aligned. Doesn't check bounds.
+   * @tparam T - integer or float type.
+   * @param data - pointer to `sizeof(T)` bytes.
+   * @param value - value in host byte-order.
+   */
+  template<typename T>
+  static void storeLE(void* data, T value) {
+    __utils::ByteOrder<HOST_LITTLE_ENDIAN>::template store<T>(data, value);
+  }
+
+  /**
+   * Load `count` little-endian values from memory. Plain memcpy on little-endian hosts. Doesn't check bounds.
+   * @tparam T - integer or float type.
+   * @param data - pointer to `count * sizeof(T)` bytes.
+   * @param values - output array of `count` values.
+   * @param count - number of values.
+   */
+  template<typename T>
+  static void loadLEArray(const void* data, T* values, v_buff_size count) {
+    __utils::ByteOrder<HOST_LITTLE_ENDIAN>::template loadArray<T>(data, values, count);
+  }
+
+  /**
+   * Store `count` values to memory in little-endian byte-order. Plain memcpy on little-endian hosts. Doesn't check bounds.
+   * @tparam T - integer or float type.
+   * @param data - pointer to `count * sizeof(T)` bytes.
+   * @param values - array of `count` values.
+   * @param count - number of values.
+   */
+  template<typename T>
+  static void storeLEArray(void* data, const T* values, v_buff_size count) {
+    __utils::ByteOrder<HOST_LITTLE_ENDIAN>::template storeArray<T>(data, values, count);
+  }
 
 public:
 
   static oatpp::String readCString(utils::parser::Caret& caret);
 
+  /**
+   * Skip cstring including the terminating `\0`.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   */
+  static void skipCString(utils::parser::Caret& caret);
+
+  /**
+   * Skip element which is prefixed with int32 size.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   * @param additionalBytes - bytes to skip in addition to the size read from the prefix.
+   */
+  static void skipSizedElement(utils::parser::Caret& caret, v_int32 additionalBytes = 0);
+
+  /**
+   * Skip element value of the given type.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   * @param bsonTypeCode - type code of the element.
+   */
+  static void skipElement(utils::parser::Caret& caret, v_char8 bsonTypeCode);
+
+  /**
+   * Count elements of the document by skipping keys and values.
+   * @param data - document data right after the size prefix.
+   * @param size - size of the data including the terminating `\0`.
+   * @return - number of elements or `-1` if document is malformed.
+   */
+  static v_int32 countElements(const char* data, v_buff_size size);
+
   static void writeKey(ConsistentOutputStream *stream, TypeCode typeCode, const StringKeyLabel &key);
   static oatpp::String readKey(utils::parser::Caret& caret, v_char8& typeCode);
 
-  static void writeInt32(ConsistentOutputStream *stream, v_int32 value, BO_TYPE valueBO = INT_BO);
-  static v_int32 readInt32(utils::parser::Caret& caret, BO_TYPE valueBO = INT_BO);
+  /**
+   * Read type-code and key without copying the key.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   * @param typeCode - out parameter for the element type-code.
+   * @return - key label pointing to the caret data. Valid as long as the caret data.
+   */
+  static StringKeyLabel readKeyLabel(utils::parser::Caret& caret, v_char8& typeCode);
 
-  static void writeInt64(ConsistentOutputStream *stream, v_int64 value, BO_TYPE valueBO = INT_BO);
-  static v_int64 readInt64(utils::parser::Caret& caret, BO_TYPE valueBO = INT_BO);
+  /**
+   * Read type-code and key of the array element and compare the key against the expected index in place.
+   * Doesn't allocate.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   * @param typeCode - out parameter for the element type-code.
+   * @param expectedIndex - expected array index.
+   * @return - `true` if key equals to the decimal representation of `expectedIndex`.
+   */
+  static bool readArrayKey(utils::parser::Caret& caret, v_char8& typeCode, v_int32 expectedIndex);
 
-  static void writeUInt64(ConsistentOutputStream *stream, v_uint64 value, BO_TYPE valueBO = INT_BO);
-  static v_uint64 readUInt64(utils::parser::Caret& caret, BO_TYPE valueBO = INT_BO);
+  /**
+   * Read type-code and skip the key.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   * @param typeCode - out parameter for the element type-code.
+   */
+  static void skipKey(utils::parser::Caret& caret, v_char8& typeCode);
+
+  static void writeInt32(ConsistentOutputStream *stream, v_int32 value) {
+    writeLE<v_int32>(stream, value);
+  }
+
+  static v_int32 readInt32(utils::parser::Caret& caret) {
+    return readLE<v_int32>(caret, "[oatpp::mongo::bson::Utils::readInt32()]: Error. Invalid Int32 value.");
+  }
+
+  static void writeInt64(ConsistentOutputStream *stream, v_int64 value) {
+    writeLE<v_int64>(stream, value);
+  }
+
+  static v_int64 readInt64(utils::parser::Caret& caret) {
+    return readLE<v_int64>(caret, "[oatpp::mongo::bson::Utils::readInt64()]: Error. Invalid Int64 value.");
+  }
+
+  static void writeUInt64(ConsistentOutputStream *stream, v_uint64 value) {
+    writeLE<v_uint64>(stream, value);
+  }
+
+  static v_uint64 readUInt64(utils::parser::Caret& caret) {
+    return readLE<v_uint64>(caret, "[oatpp::mongo::bson::Utils::readUInt64()]: Error. Invalid UInt64 value.");
+  }
+
+  static void writeFloat64(ConsistentOutputStream *stream, v_float64 value) {
+    writeLE<v_float64>(stream, value);
+  }
+
+  static v_float64 readFloat64(utils::parser::Caret& caret) {
+    return readLE<v_float64>(caret, "[oatpp::mongo::bson::Utils::readFloat64()]: Error. Invalid Float64 value.");
+  }
+
+  /**
+   * Write `count` Int32 values as a contiguous little-endian array (no BSON keys).
+   * @param stream - &id:oatpp::data::stream::ConsistentOutputStream;.
+   * @param values - array of values.
+   * @param count - number of values.
+   */
+  static void writeInt32Array(ConsistentOutputStream *stream, const v_int32* values, v_buff_size count) {
+    writeLEArray<v_int32>(stream, values, count);
+  }
+
+  /**
+   * Read `count` Int32 values from a contiguous little-endian array. Bounds are checked once for the whole array.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   * @param values - output array of `count` values.
+   * @param count - number of values.
+   * @return - `false` and caret error is set if there is not enough data.
+   */
+  static bool readInt32Array(utils::parser::Caret& caret, v_int32* values, v_buff_size count) {
+    return readLEArray<v_int32>(caret, values, count, "[oatpp::mongo::bson::Utils::readInt32Array()]: Error. Not enough data for Int32 array.");
+  }
+
+  /**
+   * Write `count` Int64 values as a contiguous little-endian array (no BSON keys).
+   * @param stream - &id:oatpp::data::stream::ConsistentOutputStream;.
+   * @param values - array of values.
+   * @param count - number of values.
+   */
+  static void writeInt64Array(ConsistentOutputStream *stream, const v_int64* values, v_buff_size count) {
+    writeLEArray<v_int64>(stream, values, count);
+  }
+
+  /**
+   * Read `count` Int64 values from a contiguous little-endian array. Bounds are checked once for the whole array.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   * @param values - output array of `count` values.
+   * @param count - number of values.
+   * @return - `false` and caret error is set if there is not enough data.
+   */
+  static bool readInt64Array(utils::parser::Caret& caret, v_int64* values, v_buff_size count) {
+    return readLEArray<v_int64>(caret, values, count, "[oatpp::mongo::bson::Utils::readInt64Array()]: Error. Not enough data for Int64 array.");
+  }
+
+  /**
+   * Write `count` Float32 values as a contiguous little-endian array (no BSON keys).
+   * @param stream - &id:oatpp::data::stream::ConsistentOutputStream;.
+   * @param values - array of values.
+   * @param count - number of values.
+   */
+  static void writeFloat32Array(ConsistentOutputStream *stream, const v_float32* values, v_buff_size count) {
+    writeLEArray<v_float32>(stream, values, count);
+  }
+
+  /**
+   * Read `count` Float32 values from a contiguous little-endian array. Bounds are checked once for the whole array.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   * @param values - output array of `count` values.
+   * @param count - number of values.
+   * @return - `false` and caret error is set if there is not enough data.
+   */
+  static bool readFloat32Array(utils::parser::Caret& caret, v_float32* values, v_buff_size count) {
+    return readLEArray<v_float32>(caret, values, count, "[oatpp::mongo::bson::Utils::readFloat32Array()]: Error. Not enough data for Float32 array.");
+  }
+
+  /**
+   * Write `count` Float64 values as a contiguous little-endian array (no BSON keys).
+   * @param stream - &id:oatpp::data::stream::ConsistentOutputStream;.
+   * @param values - array of values.
+   * @param count - number of values.
+   */
+  static void writeFloat64Array(ConsistentOutputStream *stream, const v_float64* values, v_buff_size count) {
+    writeLEArray<v_float64>(stream, values, count);
+  }
+
+  /**
+   * Read `count` Float64 values from a contiguous little-endian array. Bounds are checked once for the whole array.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   * @param values - output array of `count` values.
+   * @param count - number of values.
+   * @return - `false` and caret error is set if there is not enough data.
+   */
+  static bool readFloat64Array(utils::parser::Caret& caret, v_float64* values, v_buff_size count) {
+    return readLEArray<v_float64>(caret, values, count, "[oatpp::mongo::bson::Utils::readFloat64Array()]: Error. Not enough data for Float64 array.");
+  }
 
-  static void writeFloat64(ConsistentOutputStream *stream, v_float64 value, BO_TYPE valueBO = FLOAT_BO);
-  static v_float64 readFloat64(utils::parser::Caret& caret, BO_TYPE valueBO = FLOAT_BO);
-  
   static void writePrimitive(ConsistentOutputStream *stream, const StringKeyLabel &key, v_int8 value);
   static void readPrimitive(utils::parser::Caret& caret, v_int8& value, v_char8 bsonTypeCode);
   
@@ -0,0 +1,341 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "Validator.hpp"
+
+#include "./Utils.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace mongo { namespace bson {
+
+constexpr v_int32 Validator::MAX_DEPTH;
+
+Validator::Result Validator::error(const char* message, v_buff_size position) {
+  Result result;
+  result.valid = false;
+  result.errorMessage = message;
+  result.errorPosition = position;
+  return result;
+}
+
+bool Validator::checkUtf8(const v_char8* data, v_buff_size size) {
+
+  v_buff_size i = 0;
+
+  while(i < size) {
+
+    v_uint8 a = data[i];
+
+    if(a < 0x80) {
+      i ++;
+      continue;
+    }
+
+    v_buff_size length;
+    v_uint32 code;
+
+    if((a & 0xE0) == 0xC0) {
+      length = 2; code = a & 0x1F;
+    } else if((a & 0xF0) == 0xE0) {
+      length = 3; code = a & 0x0F;
+    } else if((a & 0xF8) == 0xF0) {
+      length = 4; code = a & 0x07;
+    } else {
+      return false;
+    }
+
+    if(i + length > size) {
+      return false;
+    }
+
+    for(v_buff_size j = 1; j < length; j ++) {
+      v_uint8 b = data[i + j];
+      if((b & 0xC0) != 0x80) {
+        return false;
+      }
+      code = (code << 6) | (b & 0x3F);
+    }
+
+    /* overlong encodings, surrogates, and out of range code points */
+    if((length == 2 && code < 0x80) ||
+       (length == 3 && code < 0x800) ||
+       (length == 4 && code < 0x10000) ||
+       (code >= 0xD800 && code <= 0xDFFF) ||
+       code > 0x10FFFF)
+    {
+      return false;
+    }
+
+    i += length;
+
+  }
+
+  return true;
+
+}
+
+bool Validator::checkArrayIndex(const v_char8* key, v_buff_size size, v_int32 expectedIndex) {
+
+  if(size == 0 || size > 10 || (size > 1 && key[0] == '0')) {
+    return false;
+  }
+
+  v_int64 index = 0;
+  for(v_buff_size i = 0; i < size; i ++) {
+    v_char8 c = key[i];
+    if(c < '0' || c > '9') {
+      return false;
+    }
+    index = index * 10 + (c - '0');
+  }
+
+  return index == expectedIndex;
+
+}
+
+bool Validator::readString(const v_char8* data, v_buff_size& pos, v_buff_size end, bool utf8) {
+
+  if(end - pos < 4) {
+    return false;
+  }
+
+  v_int32 size = Utils::loadLE<v_int32>(&data[pos]);
+  if(size < 1 || size > end - pos - 4 || data[pos + 4 + size - 1] != 0) {
+    return false;
+  }
+
+  if(utf8 && !checkUtf8(&data[pos + 4], size - 1)) {
+    return false;
+  }
+
+  pos += 4 + size;
+  return true;
+
+}
+
+Validator::Result Validator::validate(const void* buffer, v_buff_size size, const Options& options) {
+
+  const v_char8* data = (const v_char8*) buffer;
+
+  if(data == nullptr || size < 5) {
+    return error("[oatpp::mongo::bson::Validator::validate()]: Error. Document is too small.", 0);
+  }
+
+  if(Utils::loadLE<v_int32>(data) != size) {
+    return error("[oatpp::mongo::bson::Validator::validate()]: Error. Document size doesn't match buffer size.", 0);
+  }
+
+  v_int32 maxDepth = options.maxDepth;
+  if(maxDepth > MAX_DEPTH || maxDepth < 1) {
+    maxDepth = MAX_DEPTH;
+  }
+
+  Frame stack[MAX_DEPTH];
+  v_int32 depth = 1;
+  stack[0].end = size - 1;
+  stack[0].nextIndex = 0;
+  stack[0].isArray = false;
+
+  v_buff_size pos = 4;
+
+  while(depth > 0) {
+
+    Frame& frame = stack[depth - 1];
+    const v_buff_size end = frame.end;
+
+    v_char8 typeCode = data[pos];
+
+    if(typeCode == 0) {
+      if(pos != end) {
+        return error("[oatpp::mongo::bson::Validator::validate()]: Error. Unexpected document terminator.", pos);
+      }
+      pos ++;
+      depth --;
+      continue;
+    }
+
+    if(pos == end) {
+      return error("[oatpp::mongo::bson::Validator::validate()]: Error. Document is not terminated.", pos);
+    }
+
+    pos ++;
+
+    const v_char8* key = &data[pos];
+    const v_char8* keyEnd = (const v_char8*) std::memchr(key, 0, end - pos);
+    if(keyEnd == nullptr) {
+      return error("[oatpp::mongo::bson::Validator::validate()]: Error. Unterminated key.", pos);
+    }
+    v_buff_size keySize = keyEnd - key;
+
+    if(frame.isArray && options.checkArrayIndexes) {
+      if(!checkArrayIndex(key, keySize, frame.nextIndex)) {
+        return error("[oatpp::mongo::bson::Validator::validate()]: Error. Invalid array index.", pos);
+      }
+      frame.nextIndex ++;
+    } else if(options.checkUtf8 && !checkUtf8(key, keySize)) {
+      return error("[oatpp::mongo::bson::Validator::validate()]: Error. Key is not valid UTF-8.", pos);
+    }
+
+    pos += keySize + 1;
+
+    v_buff_size valueSize = 0;
+
+    switch(typeCode) {
+
+      case TypeCode::UNDEFINED:
+      case TypeCode::NULL_VALUE:
+      case TypeCode::MIN_KEY:
+      case TypeCode::MAX_KEY:
+        break;
+
+      case TypeCode::BOOLEAN:
+        if(pos >= end || data[pos] > 1) {
+          return error("[oatpp::mongo::bson::Validator::validate()]: Error. Invalid boolean value.", pos);
+        }
+        pos ++;
+        break;
+
+      case TypeCode::INT_32: valueSize = 4; break;
+
+      case TypeCode::DOUBLE:
+      case TypeCode::DATE_TIME:
+      case TypeCode::TIMESTAMP:
+      case TypeCode::INT_64: valueSize = 8; break;
+
+      case TypeCode::OBJECT_ID: valueSize = 12; break;
+      case TypeCode::DECIMAL_128: valueSize = 16; break;
+
+      case TypeCode::STRING:
+      case TypeCode::JAVASCRIPT_CODE:
+      case TypeCode::SYMBOL:
+        if(!readString(data, pos, end, options.checkUtf8)) {
+          return error("[oatpp::mongo::bson::Validator::validate()]: Error. Invalid string.", pos);
+        }
+        break;
+
+      case TypeCode::BD_POINTER:
+        if(!readString(data, pos, end, options.checkUtf8)) {
+          return error("[oatpp::mongo::bson::Validator::validate()]: Error. Invalid string.", pos);
+        }
+        valueSize = 12;
+        break;
+
+      case TypeCode::BINARY: {
+        if(end - pos < 5) {
+          return error("[oatpp::mongo::bson::Validator::validate()]: Error. Invalid binary size.", pos);
+        }
+        v_int32 binarySize = Utils::loadLE<v_int32>(&data[pos]);
+        if(binarySize < 0 || binarySize > end - pos - 5) {
+          return error("[oatpp::mongo::bson::Validator::validate()]: Error. Invalid binary size.", pos);
+        }
+        pos += 5 + binarySize;
+        break;
+      }
+
+      case TypeCode::REGEXP: {
+        for(v_int32 i = 0; i < 2; i ++) {
+          const v_char8* str = &data[pos];
+          const v_char8* strEnd = (const v_char8*) std::memchr(str, 0, end - pos);
+          if(strEnd == nullptr) {
+            return error("[oatpp::mongo::bson::Validator::validate()]: Error. Unterminated regexp.", pos);
+          }
+          if(options.checkUtf8 && !checkUtf8(str, strEnd - str)) {
+            return error("[oatpp::mongo::bson::Validator::validate()]: Error. Regexp is not valid UTF-8.", pos);
+          }
+          pos += strEnd - str + 1;
+        }
+        break;
+      }
+
+      case TypeCode::DOCUMENT_EMBEDDED:
+      case TypeCode::DOCUMENT_ARRAY:
+      case TypeCode::JAVASCRIPT_CODE_WS: {
+
+        if(depth >= maxDepth) {
+          return error("[oatpp::mongo::bson::Validator::validate()]: Error. Max nesting depth exceeded.", pos);
+        }
+
+        if(end - pos < 5) {
+          return error("[oatpp::mongo::bson::Validator::validate()]: Error. Invalid document size.", pos);
+        }
+
+        v_int32 docSize = Utils::loadLE<v_int32>(&data[pos]);
+        if(docSize < 5 || docSize > end - pos) {
+          return error("[oatpp::mongo::bson::Validator::validate()]: Error. Invalid document size.", pos);
+        }
+        v_buff_size docEnd = pos + docSize - 1;
+
+        if(typeCode == TypeCode::JAVASCRIPT_CODE_WS) {
+          /* int32 total size, code string, scope document - scope must end exactly where the element ends */
+          pos += 4;
+          if(!readString(data, pos, docEnd, options.checkUtf8)) {
+            return error("[oatpp::mongo::bson::Validator::validate()]: Error. Invalid code string.", pos);
+          }
+          if(docEnd + 1 - pos < 5 || Utils::loadLE<v_int32>(&data[pos]) != docEnd + 1 - pos) {
+            return error("[oatpp::mongo::bson::Validator::validate()]: Error. Invalid scope document size.", pos);
+          }
+        }
+
+        Frame& child = stack[depth ++];
+        child.end = docEnd;
+        child.nextIndex = 0;
+        child.isArray = (typeCode == TypeCode::DOCUMENT_ARRAY);
+
+        pos += 4;
+        break;
+
+      }
+
+      default:
+        return error("[oatpp::mongo::bson::Validator::validate()]: Error. Unknown element type-code.", pos);
+
+    }
+
+    if(valueSize > 0) {
+      if(end - pos < valueSize) {
+        return error("[oatpp::mongo::bson::Validator::validate()]: Error. Element exceeds document bounds.", pos);
+      }
+      pos += valueSize;
+    }
+
+  }
+
+  Result result;
+  result.valid = true;
+  result.errorMessage = nullptr;
+  result.errorPosition = 0;
+  return result;
+
+}
+
+Validator::Result Validator::validate(const oatpp::String& document, const Options& options) {
+  if(!document) {
+    return error("[oatpp::mongo::bson::Validator::validate()]: Error. Document is null.", 0);
+  }
+  return validate(document->data(), document->size(), options);
+}
+
+}}}
@@ -0,0 +1,135 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_mongo_bson_Validator_hpp
+#define oatpp_mongo_bson_Validator_hpp
+
+#include "./Types.hpp"
+
+namespace oatpp { namespace mongo { namespace bson {
+
+/**
+ * Validation-only BSON scanner. <br>
+ * Checks the structure of the BSON document - size prefixes, terminating `\0`, array indexes ordering,
+ * known type-codes, and optionally UTF-8 of strings and keys. <br>
+ * Doesn't allocate memory and doesn't build any objects.
+ */
+class Validator {
+public:
+
+  /**
+   * Hard limit for nesting of documents.
+   */
+  static constexpr v_int32 MAX_DEPTH = 128;
+
+public:
+
+  /**
+   * Validation options.
+   */
+  struct Options {
+
+    Options()
+      : checkArrayIndexes(true)
+      , checkUtf8(false)
+      , maxDepth(100)
+    {}
+
+    /**
+     * Check that array keys are "0", "1", "2" ... in order.
+     */
+    bool checkArrayIndexes;
+
+    /**
+     * Check that strings and keys are valid UTF-8.
+     */
+    bool checkUtf8;
+
+    /**
+     * Max nesting depth of documents. Capped by &l:Validator::MAX_DEPTH;.
+     */
+    v_int32 maxDepth;
+
+  };
+
+  /**
+   * Validation result.
+   */
+  struct Result {
+
+    /**
+     * `true` if document is valid.
+     */
+    bool valid;
+
+    /**
+     * Error message. `nullptr` if document is valid.
+     */
+    const char* errorMessage;
+
+    /**
+     * Position in the buffer where error was detected.
+     */
+    v_buff_size errorPosition;
+
+  };
+
+private:
+
+  struct Frame {
+    v_buff_size end;
+    v_int32 nextIndex;
+    bool isArray;
+  };
+
+private:
+  static Result error(const char* message, v_buff_size position);
+  static bool checkUtf8(const v_char8* data, v_buff_size size);
+  static bool checkArrayIndex(const v_char8* key, v_buff_size size, v_int32 expectedIndex);
+  static bool readString(const v_char8* data, v_buff_size& pos, v_buff_size end, bool utf8);
+public:
+
+  /**
+   * Validate BSON document.
+   * @param buffer - pointer to the document.
+   * @param size - size of the buffer. Document must occupy the whole buffer.
+   * @param options - &l:Validator::Options;.
+   * @return - &l:Validator::Result;.
+   */
+  static Result validate(const void* buffer, v_buff_size size, const Options& options = Options());
+
+  /**
+   * Validate BSON document.
+   * @param document - document.
+   * @param options - &l:Validator::Options;.
+   * @return - &l:Validator::Result;.
+   */
+  static Result validate(const oatpp::String& document, const Options& options = Options());
+
+};
+
+}}}
+
+#endif // oatpp_mongo_bson_Validator_hpp
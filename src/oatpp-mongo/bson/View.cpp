@@ -0,0 +1,403 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "View.hpp"
+#include "Utils.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace mongo { namespace bson {
+
+namespace {
+
+  v_int32 readInt32(const v_char8* data) {
+    return Utils::loadLE<v_int32>(data);
+  }
+
+  v_int64 readInt64(const v_char8* data) {
+    return Utils::loadLE<v_int64>(data);
+  }
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// StringView
+
+bool StringView::equals(const char* str, v_buff_size strSize) const {
+  return size == strSize && (size == 0 || std::memcmp(data, str, size) == 0);
+}
+
+bool StringView::operator==(const char* str) const {
+  if(str == nullptr) {
+    return data == nullptr;
+  }
+  return data != nullptr && equals(str, std::strlen(str));
+}
+
+bool StringView::operator!=(const char* str) const {
+  return !operator==(str);
+}
+
+std::string StringView::std_str() const {
+  if(data == nullptr) {
+    return std::string();
+  }
+  return std::string(data, size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Element
+
+Element::Element()
+  : m_typeCode(0)
+  , m_key(nullptr)
+  , m_keySize(0)
+  , m_value(nullptr)
+  , m_valueSize(0)
+{}
+
+v_char8 Element::getTypeCode() const {
+  return m_typeCode;
+}
+
+StringView Element::getKey() const {
+  StringView result;
+  result.data = m_key;
+  result.size = m_keySize;
+  return result;
+}
+
+const void* Element::getValueData() const {
+  return m_value;
+}
+
+v_buff_size Element::getValueSize() const {
+  return m_valueSize;
+}
+
+bool Element::isNull() const {
+  return m_typeCode == TypeCode::NULL_VALUE || m_typeCode == TypeCode::UNDEFINED;
+}
+
+v_int32 Element::asInt32(v_int32 defaultValue) const {
+  if(m_typeCode == TypeCode::INT_32) {
+    return readInt32(m_value);
+  }
+  return defaultValue;
+}
+
+v_int64 Element::asInt64(v_int64 defaultValue) const {
+  switch(m_typeCode) {
+    case TypeCode::INT_64:
+    case TypeCode::DATE_TIME:
+      return readInt64(m_value);
+    case TypeCode::INT_32:
+      return readInt32(m_value);
+    default:
+      return defaultValue;
+  }
+}
+
+v_float64 Element::asFloat64(v_float64 defaultValue) const {
+  if(m_typeCode == TypeCode::DOUBLE) {
+    return Utils::loadLE<v_float64>(m_value);
+  }
+  return defaultValue;
+}
+
+bool Element::asBoolean(bool defaultValue) const {
+  if(m_typeCode == TypeCode::BOOLEAN) {
+    return m_value[0] != 0;
+  }
+  return defaultValue;
+}
+
+StringView Element::asStringView() const {
+  StringView result;
+  switch(m_typeCode) {
+    case TypeCode::STRING:
+    case TypeCode::JAVASCRIPT_CODE:
+    case TypeCode::SYMBOL:
+      result.data = (const char*) &m_value[4];
+      result.size = m_valueSize - 5;
+      break;
+    default:
+      result.data = nullptr;
+      result.size = 0;
+  }
+  return result;
+}
+
+View Element::asDocumentView() const {
+  if(m_typeCode == TypeCode::DOCUMENT_EMBEDDED || m_typeCode == TypeCode::DOCUMENT_ARRAY) {
+    return View(m_value, m_valueSize);
+  }
+  return View();
+}
+
+Element::operator bool() const {
+  return m_typeCode != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ElementIterator
+
+ElementIterator::ElementIterator()
+  : m_data(nullptr)
+  , m_position(0)
+  , m_end(0)
+  , m_errorMessage(nullptr)
+{}
+
+ElementIterator::ElementIterator(const v_char8* data, v_buff_size position, v_buff_size end)
+  : m_data(data)
+  , m_position(position)
+  , m_end(end)
+  , m_errorMessage(nullptr)
+{
+  parseElement();
+}
+
+ElementIterator::ElementIterator(const v_char8* data, v_buff_size end, const char* errorMessage)
+  : m_data(data)
+  , m_position(end)
+  , m_end(end)
+  , m_errorMessage(errorMessage)
+{}
+
+void ElementIterator::setError(const char* message) {
+  m_errorMessage = message;
+  m_position = m_end;
+  m_element = Element();
+}
+
+void ElementIterator::parseElement() {
+
+  if(m_position >= m_end) {
+    m_element = Element();
+    return;
+  }
+
+  const v_char8 typeCode = m_data[m_position];
+
+  const v_char8* keyBegin = &m_data[m_position + 1];
+  const v_char8* keyEnd = (const v_char8*) std::memchr(keyBegin, 0, m_end - m_position - 1);
+  if(keyEnd == nullptr) {
+    setError("[oatpp::mongo::bson::ElementIterator::parseElement()]: Error. Key is not terminated.");
+    return;
+  }
+
+  const v_buff_size valuePos = (keyEnd - m_data) + 1;
+  const v_buff_size available = m_end - valuePos;
+  v_buff_size valueSize;
+
+  switch(typeCode) {
+
+    case TypeCode::UNDEFINED:
+    case TypeCode::NULL_VALUE:
+    case TypeCode::MIN_KEY:
+    case TypeCode::MAX_KEY:
+      valueSize = 0;
+      break;
+
+    case TypeCode::BOOLEAN: valueSize = 1; break;
+    case TypeCode::INT_32: valueSize = 4; break;
+
+    case TypeCode::DOUBLE:
+    case TypeCode::DATE_TIME:
+    case TypeCode::TIMESTAMP:
+    case TypeCode::INT_64: valueSize = 8; break;
+
+    case TypeCode::OBJECT_ID: valueSize = 12; break;
+    case TypeCode::DECIMAL_128: valueSize = 16; break;
+
+    case TypeCode::STRING:
+    case TypeCode::JAVASCRIPT_CODE:
+    case TypeCode::SYMBOL:
+    case TypeCode::BD_POINTER: {
+      if(available < 4) {
+        setError("[oatpp::mongo::bson::ElementIterator::parseElement()]: Error. Invalid string size.");
+        return;
+      }
+      v_int32 size = readInt32(&m_data[valuePos]);
+      if(size < 1 || size > available - 4 || m_data[valuePos + 4 + size - 1] != 0) {
+        setError("[oatpp::mongo::bson::ElementIterator::parseElement()]: Error. Invalid string size.");
+        return;
+      }
+      valueSize = 4 + (v_buff_size) size + (typeCode == TypeCode::BD_POINTER ? 12 : 0);
+      break;
+    }
+
+    case TypeCode::BINARY: {
+      if(available < 5) {
+        setError("[oatpp::mongo::bson::ElementIterator::parseElement()]: Error. Invalid binary size.");
+        return;
+      }
+      v_int32 size = readInt32(&m_data[valuePos]);
+      if(size < 0) {
+        setError("[oatpp::mongo::bson::ElementIterator::parseElement()]: Error. Invalid binary size.");
+        return;
+      }
+      valueSize = 5 + (v_buff_size) size;
+      break;
+    }
+
+    case TypeCode::DOCUMENT_EMBEDDED:
+    case TypeCode::DOCUMENT_ARRAY:
+    case TypeCode::JAVASCRIPT_CODE_WS: {
+      if(available < 5) {
+        setError("[oatpp::mongo::bson::ElementIterator::parseElement()]: Error. Invalid document size.");
+        return;
+      }
+      v_int32 size = readInt32(&m_data[valuePos]);
+      if(size < 5 || size > available || m_data[valuePos + size - 1] != 0) {
+        setError("[oatpp::mongo::bson::ElementIterator::parseElement()]: Error. Invalid document size.");
+        return;
+      }
+      valueSize = size;
+      break;
+    }
+
+    case TypeCode::REGEXP: {
+      const v_char8* pattern = (const v_char8*) std::memchr(&m_data[valuePos], 0, available);
+      const v_char8* options = pattern == nullptr ? nullptr :
+                               (const v_char8*) std::memchr(pattern + 1, 0, &m_data[m_end] - pattern - 1);
+      if(options == nullptr) {
+        setError("[oatpp::mongo::bson::ElementIterator::parseElement()]: Error. Regexp is not terminated.");
+        return;
+      }
+      valueSize = options + 1 - &m_data[valuePos];
+      break;
+    }
+
+    default:
+      setError("[oatpp::mongo::bson::ElementIterator::parseElement()]: Error. Unknown element type-code.");
+      return;
+
+  }
+
+  if(valueSize > available) {
+    setError("[oatpp::mongo::bson::ElementIterator::parseElement()]: Error. Element exceeds document bounds.");
+    return;
+  }
+
+  m_element.m_typeCode = typeCode;
+  m_element.m_key = (const char*) keyBegin;
+  m_element.m_keySize = keyEnd - keyBegin;
+  m_element.m_value = &m_data[valuePos];
+  m_element.m_valueSize = valueSize;
+
+}
+
+const Element& ElementIterator::operator*() const {
+  return m_element;
+}
+
+const Element* ElementIterator::operator->() const {
+  return &m_element;
+}
+
+ElementIterator& ElementIterator::operator++() {
+  if(m_position < m_end) {
+    m_position = (m_element.m_value - m_data) + m_element.m_valueSize;
+    parseElement();
+  }
+  return *this;
+}
+
+bool ElementIterator::operator==(const ElementIterator& other) const {
+  return m_position == other.m_position && m_data == other.m_data;
+}
+
+bool ElementIterator::operator!=(const ElementIterator& other) const {
+  return !operator==(other);
+}
+
+bool ElementIterator::hasError() const {
+  return m_errorMessage != nullptr;
+}
+
+const char* ElementIterator::getErrorMessage() const {
+  return m_errorMessage;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// View
+
+View::View()
+  : m_data(nullptr)
+  , m_size(0)
+{}
+
+View::View(const void* data, v_buff_size size)
+  : m_data((const v_char8*) data)
+  , m_size(size)
+{}
+
+View::View(const oatpp::String& document)
+  : m_data(document ? (const v_char8*) document->data() : nullptr)
+  , m_size(document ? (v_buff_size) document->size() : 0)
+{}
+
+bool View::isValid() const {
+  return m_data != nullptr && m_size >= 5 && readInt32(m_data) == m_size && m_data[m_size - 1] == 0;
+}
+
+const void* View::getData() const {
+  return m_data;
+}
+
+v_buff_size View::getSize() const {
+  return m_size;
+}
+
+ElementIterator View::begin() const {
+  if(m_data == nullptr) {
+    return ElementIterator();
+  }
+  if(!isValid()) {
+    return ElementIterator(m_data, m_size > 0 ? m_size - 1 : 0, "[oatpp::mongo::bson::View::begin()]: Error. Invalid document header.");
+  }
+  return ElementIterator(m_data, 4, m_size - 1);
+}
+
+ElementIterator View::end() const {
+  if(m_data == nullptr) {
+    return ElementIterator();
+  }
+  return ElementIterator(m_data, m_size > 0 ? m_size - 1 : 0, nullptr);
+}
+
+Element View::find(const char* key) const {
+  const v_buff_size keySize = std::strlen(key);
+  for(ElementIterator it = begin(); it != end(); ++it) {
+    if(it->getKey().equals(key, keySize)) {
+      return *it;
+    }
+  }
+  return Element();
+}
+
+}}}
@@ -0,0 +1,307 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_mongo_bson_View_hpp
+#define oatpp_mongo_bson_View_hpp
+
+#include "./Types.hpp"
+
+namespace oatpp { namespace mongo { namespace bson {
+
+class View;
+
+/**
+ * Non-owning reference to a sequence of chars inside a BSON buffer.
+ */
+struct StringView {
+
+  /**
+   * Pointer to the first char. `nullptr` for an empty view.
+   */
+  const char* data;
+
+  /**
+   * Number of chars. Terminating `\0` is not included.
+   */
+  v_buff_size size;
+
+  /**
+   * Compare with a sequence of chars.
+   * @param str - chars to compare with.
+   * @param strSize - number of chars.
+   * @return - `true` if equal.
+   */
+  bool equals(const char* str, v_buff_size strSize) const;
+
+  /**
+   * Compare with a C-string.
+   * @param str - C-string.
+   * @return - `true` if equal.
+   */
+  bool operator==(const char* str) const;
+
+  /**
+   * Compare with a C-string.
+   * @param str - C-string.
+   * @return - `true` if not equal.
+   */
+  bool operator!=(const char* str) const;
+
+  /**
+   * Copy chars to `std::string`. Allocates.
+   * @return - `std::string`.
+   */
+  std::string std_str() const;
+
+};
+
+/**
+ * One element of the BSON document - type-code, key, and value. <br>
+ * Points into the buffer of the &l:View;, doesn't copy anything.
+ */
+class Element {
+  friend class ElementIterator;
+private:
+  v_char8 m_typeCode;
+  const char* m_key;
+  v_buff_size m_keySize;
+  const v_char8* m_value;
+  v_buff_size m_valueSize;
+public:
+
+  /**
+   * Constructor. Creates an empty element.
+   */
+  Element();
+
+  /**
+   * Get element type-code. &id:oatpp::mongo::bson::TypeCode;.
+   * @return - type-code. `0` for an empty element.
+   */
+  v_char8 getTypeCode() const;
+
+  /**
+   * Get element key.
+   * @return - &l:StringView;.
+   */
+  StringView getKey() const;
+
+  /**
+   * Pointer to the raw value bytes.
+   * @return
+   */
+  const void* getValueData() const;
+
+  /**
+   * Size of the raw value.
+   * @return
+   */
+  v_buff_size getValueSize() const;
+
+  /**
+   * Check if element is `null` or `undefined`.
+   * @return
+   */
+  bool isNull() const;
+
+  /**
+   * Get value of `INT_32` element.
+   * @param defaultValue - returned if element is of a different type.
+   * @return
+   */
+  v_int32 asInt32(v_int32 defaultValue = 0) const;
+
+  /**
+   * Get value of `INT_64`, `DATE_TIME`, or `INT_32` element.
+   * @param defaultValue - returned if element is of a different type.
+   * @return
+   */
+  v_int64 asInt64(v_int64 defaultValue = 0) const;
+
+  /**
+   * Get value of `DOUBLE` element.
+   * @param defaultValue - returned if element is of a different type.
+   * @return
+   */
+  v_float64 asFloat64(v_float64 defaultValue = 0) const;
+
+  /**
+   * Get value of `BOOLEAN` element.
+   * @param defaultValue - returned if element is of a different type.
+   * @return
+   */
+  bool asBoolean(bool defaultValue = false) const;
+
+  /**
+   * Get value of `STRING`, `JAVASCRIPT_CODE`, or `SYMBOL` element.
+   * @return - &l:StringView;. Empty view with `data == nullptr` if element is of a different type.
+   */
+  StringView asStringView() const;
+
+  /**
+   * Get value of `DOCUMENT_EMBEDDED` or `DOCUMENT_ARRAY` element.
+   * @return - &l:View;. Empty view if element is of a different type.
+   */
+  View asDocumentView() const;
+
+  /**
+   * Check if element is not empty.
+   * @return
+   */
+  explicit operator bool() const;
+
+};
+
+/**
+ * Forward iterator over elements of the BSON document. <br>
+ * Each element is bounds-checked against the document once, when iterator steps onto it.
+ * On malformed input iterator stops (becomes equal to the end iterator) and reports error.
+ */
+class ElementIterator {
+private:
+  const v_char8* m_data;
+  v_buff_size m_position;
+  v_buff_size m_end;
+  Element m_element;
+  const char* m_errorMessage;
+private:
+  void setError(const char* message);
+  void parseElement();
+public:
+
+  /**
+   * Constructor. Creates end iterator.
+   */
+  ElementIterator();
+
+  /**
+   * Constructor.
+   * @param data - pointer to the document.
+   * @param position - position of the first element.
+   * @param end - position of the terminating `\0` of the document.
+   */
+  ElementIterator(const v_char8* data, v_buff_size position, v_buff_size end);
+
+  /**
+   * Constructor. Creates end iterator with error.
+   * @param data - pointer to the document.
+   * @param end - position of the terminating `\0` of the document.
+   * @param errorMessage - error message.
+   */
+  ElementIterator(const v_char8* data, v_buff_size end, const char* errorMessage);
+
+  const Element& operator*() const;
+  const Element* operator->() const;
+
+  ElementIterator& operator++();
+
+  bool operator==(const ElementIterator& other) const;
+  bool operator!=(const ElementIterator& other) const;
+
+  /**
+   * Check if iterator stopped because of malformed document.
+   * @return
+   */
+  bool hasError() const;
+
+  /**
+   * Get error message.
+   * @return - error message. `nullptr` if no error.
+   */
+  const char* getErrorMessage() const;
+
+};
+
+/**
+ * Non-owning, non-allocating view over the BSON document. <br>
+ * Buffer must outlive the view and all elements obtained from it.
+ */
+class View {
+private:
+  const v_char8* m_data;
+  v_buff_size m_size;
+public:
+
+  /**
+   * Constructor. Creates an empty view.
+   */
+  View();
+
+  /**
+   * Constructor.
+   * @param data - pointer to the document.
+   * @param size - size of the buffer.
+   */
+  View(const void* data, v_buff_size size);
+
+  /**
+   * Constructor. Doesn't hold the string - document must outlive the view.
+   * @param document - document.
+   */
+  explicit View(const oatpp::String& document);
+
+  /**
+   * Check document header - size prefix matches the buffer size and document is terminated by `\0`.
+   * Elements are checked while iterating.
+   * @return
+   */
+  bool isValid() const;
+
+  /**
+   * Pointer to the document.
+   * @return
+   */
+  const void* getData() const;
+
+  /**
+   * Size of the document.
+   * @return
+   */
+  v_buff_size getSize() const;
+
+  /**
+   * Iterator to the first element.
+   * @return - &l:ElementIterator;.
+   */
+  ElementIterator begin() const;
+
+  /**
+   * End iterator.
+   * @return - &l:ElementIterator;.
+   */
+  ElementIterator end() const;
+
+  /**
+   * Find first element by key. Linear scan.
+   * @param key - key.
+   * @return - &l:Element;. Empty element if key not found or document is malformed.
+   */
+  Element find(const char* key) const;
+
+};
+
+}}}
+
+#endif // oatpp_mongo_bson_View_hpp
@@ -0,0 +1,670 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "BsonToJson.hpp"
+
+#include "oatpp-mongo/bson/Utils.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace oatpp { namespace mongo { namespace bson { namespace json {
+
+namespace {
+
+  const v_uint64 ONES = 0x0101010101010101ULL;
+  const v_uint64 HIGHS = 0x8080808080808080ULL;
+
+  /* non-zero if any of 8 bytes is < 0x20, '"' or '\' */
+  inline v_uint64 findEscapes(const char* data) {
+    v_uint64 word;
+    std::memcpy(&word, data, 8);
+    v_uint64 quote = word ^ (ONES * '"');
+    v_uint64 slash = word ^ (ONES * '\\');
+    v_uint64 control = (word - ONES * 0x20) & ~word & HIGHS;
+    v_uint64 quotes = (quote - ONES) & ~quote & HIGHS;
+    v_uint64 slashes = (slash - ONES) & ~slash & HIGHS;
+    return control | quotes | slashes;
+  }
+
+  inline bool needsEscape(v_char8 c) {
+    return c < 0x20 || c == '"' || c == '\\';
+  }
+
+  /* date written as ISO-8601 string in relaxed format: 1970-01-01 <= date < 10000-01-01 */
+  const v_int64 MAX_ISO_DATE = 253402300800000LL;
+
+}
+
+constexpr v_int32 BsonToJson::MAX_DEPTH;
+constexpr v_buff_size BsonToJson::BUFFER_SIZE;
+
+void BsonToJson::writeString(data::stream::ConsistentOutputStream* stream, const char* data, v_buff_size size) {
+
+  static const char* hex = "0123456789abcdef";
+
+  stream->writeCharSimple('"');
+
+  v_buff_size runStart = 0;
+  v_buff_size i = 0;
+
+  while(i < size) {
+
+    while(i + 8 <= size && findEscapes(&data[i]) == 0) {
+      i += 8;
+    }
+
+    v_buff_size stop = i + 8 < size ? i + 8 : size;
+
+    for(; i < stop; i ++) {
+
+      v_char8 c = (v_char8) data[i];
+      if(!needsEscape(c)) {
+        continue;
+      }
+
+      if(i > runStart) {
+        stream->writeSimple(&data[runStart], i - runStart);
+      }
+      runStart = i + 1;
+
+      switch(c) {
+        case '"': stream->writeSimple("\\\"", 2); break;
+        case '\\': stream->writeSimple("\\\\", 2); break;
+        case '\b': stream->writeSimple("\\b", 2); break;
+        case '\f': stream->writeSimple("\\f", 2); break;
+        case '\n': stream->writeSimple("\\n", 2); break;
+        case '\r': stream->writeSimple("\\r", 2); break;
+        case '\t': stream->writeSimple("\\t", 2); break;
+        default: {
+          char escaped[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0x0F]};
+          stream->writeSimple(escaped, 6);
+        }
+      }
+
+    }
+
+  }
+
+  if(size > runStart) {
+    stream->writeSimple(&data[runStart], size - runStart);
+  }
+
+  stream->writeCharSimple('"');
+
+}
+
+void BsonToJson::writeInt64(data::stream::ConsistentOutputStream* stream, v_int64 value) {
+  char buffer[24];
+  char* end = buffer + sizeof(buffer);
+  char* p = end;
+  v_uint64 u = value < 0 ? 0 - (v_uint64) value : (v_uint64) value;
+  do {
+    *--p = (char) ('0' + u % 10);
+    u /= 10;
+  } while(u > 0);
+  if(value < 0) {
+    *--p = '-';
+  }
+  stream->writeSimple(p, end - p);
+}
+
+void BsonToJson::writeQuotedInt64(data::stream::ConsistentOutputStream* stream, v_int64 value) {
+  stream->writeCharSimple('"');
+  writeInt64(stream, value);
+  stream->writeCharSimple('"');
+}
+
+void BsonToJson::writeDouble(data::stream::ConsistentOutputStream* stream, v_float64 value, bool canonical) {
+
+  if(std::isnan(value) || std::isinf(value)) {
+    stream->writeSimple("{\"$numberDouble\":\"");
+    if(std::isnan(value)) {
+      stream->writeSimple("NaN");
+    } else if(value < 0) {
+      stream->writeSimple("-Infinity");
+    } else {
+      stream->writeSimple("Infinity");
+    }
+    stream->writeSimple("\"}");
+    return;
+  }
+
+  /* shortest representation that reads back to the same value */
+  char buffer[40];
+  v_int32 size = 0;
+  for(v_int32 precision = 15; precision <= 17; precision ++) {
+    size = std::snprintf(buffer, 32, "%.*g", precision, value);
+    if(std::strtod(buffer, nullptr) == value) {
+      break;
+    }
+  }
+
+  /* decimal point is locale-specific (and may be multibyte) - same as in Decimal128::fromDouble() */
+  v_int32 normalized = 0;
+  for(v_int32 i = 0; i < size; i ++) {
+    char c = buffer[i];
+    if((c >= '0' && c <= '9') || c == '-' || c == '+' || c == 'e') {
+      buffer[normalized ++] = c;
+    } else if(normalized == 0 || buffer[normalized - 1] != '.') {
+      buffer[normalized ++] = '.';
+    }
+  }
+  size = normalized;
+  buffer[size] = 0;
+
+  /* keep the value a float when read back */
+  if(std::strpbrk(buffer, ".eE") == nullptr) {
+    buffer[size ++] = '.';
+    buffer[size ++] = '0';
+  }
+
+  if(canonical) {
+    stream->writeSimple("{\"$numberDouble\":\"");
+    stream->writeSimple(buffer, size);
+    stream->writeSimple("\"}");
+  } else {
+    stream->writeSimple(buffer, size);
+  }
+
+}
+
+void BsonToJson::writeDate(data::stream::ConsistentOutputStream* stream, v_int64 millis, bool canonical) {
+
+  if(canonical || millis < 0 || millis >= MAX_ISO_DATE) {
+    stream->writeSimple("{\"$date\":{\"$numberLong\":");
+    writeQuotedInt64(stream, millis);
+    stream->writeSimple("}}");
+    return;
+  }
+
+  v_int64 days = millis / 86400000;
+  v_int64 msOfDay = millis % 86400000;
+
+  /* civil date from days since epoch */
+  v_int64 z = days + 719468;
+  v_int64 era = z / 146097;
+  v_int64 doe = z - era * 146097;
+  v_int64 yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  v_int64 doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  v_int64 mp = (5 * doy + 2) / 153;
+  v_int32 day = (v_int32) (doy - (153 * mp + 2) / 5 + 1);
+  v_int32 month = (v_int32) (mp < 10 ? mp + 3 : mp - 9);
+  v_int32 year = (v_int32) (yoe + era * 400 + (month <= 2 ? 1 : 0));
+
+  v_int32 ms = (v_int32) (msOfDay % 1000);
+  v_int32 seconds = (v_int32) (msOfDay / 1000);
+
+  char buffer[48];
+  v_int32 size = std::snprintf(buffer, 40, "{\"$date\":\"%04d-%02d-%02dT%02d:%02d:%02d",
+                               year, month, day, seconds / 3600, (seconds / 60) % 60, seconds % 60);
+  if(ms > 0) {
+    size += std::snprintf(buffer + size, 8, ".%03d", ms);
+  }
+  buffer[size ++] = 'Z';
+  buffer[size ++] = '"';
+  buffer[size ++] = '}';
+
+  stream->writeSimple(buffer, size);
+
+}
+
+void BsonToJson::writeBase64(data::stream::ConsistentOutputStream* stream, const v_char8* data, v_buff_size size) {
+
+  static const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  char buffer[BUFFER_SIZE];
+  v_buff_size bufferSize = 0;
+
+  v_buff_size i = 0;
+  for(; i + 3 <= size; i += 3) {
+    v_uint32 triple = ((v_uint32) data[i] << 16) | ((v_uint32) data[i + 1] << 8) | data[i + 2];
+    buffer[bufferSize ++] = alphabet[(triple >> 18) & 0x3F];
+    buffer[bufferSize ++] = alphabet[(triple >> 12) & 0x3F];
+    buffer[bufferSize ++] = alphabet[(triple >> 6) & 0x3F];
+    buffer[bufferSize ++] = alphabet[triple & 0x3F];
+    if(bufferSize + 4 > BUFFER_SIZE) {
+      stream->writeSimple(buffer, bufferSize);
+      bufferSize = 0;
+    }
+  }
+
+  if(i < size) {
+    v_uint32 triple = (v_uint32) data[i] << 16;
+    if(i + 1 < size) {
+      triple |= (v_uint32) data[i + 1] << 8;
+    }
+    buffer[bufferSize ++] = alphabet[(triple >> 18) & 0x3F];
+    buffer[bufferSize ++] = alphabet[(triple >> 12) & 0x3F];
+    buffer[bufferSize ++] = i + 1 < size ? alphabet[(triple >> 6) & 0x3F] : '=';
+    buffer[bufferSize ++] = '=';
+  }
+
+  if(bufferSize > 0) {
+    stream->writeSimple(buffer, bufferSize);
+  }
+
+}
+
+void BsonToJson::writeObjectId(data::stream::ConsistentOutputStream* stream, const v_char8* data) {
+  char buffer[type::ObjectId::STRING_SIZE + 12] = "{\"$oid\":\"";
+  type::ObjectId(data).toString(&buffer[9]);
+  buffer[9 + type::ObjectId::STRING_SIZE] = '"';
+  buffer[10 + type::ObjectId::STRING_SIZE] = '}';
+  stream->writeSimple(buffer, 11 + type::ObjectId::STRING_SIZE);
+}
+
+void BsonToJson::transcode(utils::parser::Caret& caret, data::stream::ConsistentOutputStream* stream, const Options& options) {
+
+  const v_char8* data = (const v_char8*) caret.getCurrData();
+  const v_buff_size start = caret.getPosition();
+  const v_buff_size available = caret.getDataSize() - start;
+
+  if(available < 5) {
+    caret.setError("[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Document is too small.");
+    return;
+  }
+
+  const v_int32 size = Utils::loadLE<v_int32>(data);
+  if(size < 5 || size > available || data[size - 1] != 0) {
+    caret.setError("[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Invalid document size.");
+    return;
+  }
+
+  v_int32 maxDepth = options.maxDepth;
+  if(maxDepth > MAX_DEPTH || maxDepth < 1) {
+    maxDepth = MAX_DEPTH;
+  }
+
+  const bool canonical = options.format == Format::CANONICAL;
+  const char* errorMessage = nullptr;
+
+  Frame stack[MAX_DEPTH];
+  v_int32 depth = 1;
+  stack[0].end = size - 1;
+  stack[0].isArray = false;
+  stack[0].isFirst = true;
+  stack[0].isCodeScope = false;
+
+  stream->writeCharSimple('{');
+
+  v_buff_size pos = 4;
+
+  while(depth > 0) {
+
+    Frame& frame = stack[depth - 1];
+    const v_buff_size end = frame.end;
+
+    v_char8 typeCode = data[pos];
+
+    if(typeCode == 0) {
+      if(pos != end) {
+        errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Unexpected document terminator.";
+        break;
+      }
+      pos ++;
+      if(frame.isArray) {
+        stream->writeCharSimple(']');
+      } else if(frame.isCodeScope) {
+        stream->writeSimple("}}", 2);
+      } else {
+        stream->writeCharSimple('}');
+      }
+      depth --;
+      continue;
+    }
+
+    if(pos == end) {
+      errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Document is not terminated.";
+      break;
+    }
+
+    pos ++;
+
+    const char* key = (const char*) &data[pos];
+    const char* keyEnd = (const char*) std::memchr(key, 0, end - pos);
+    if(keyEnd == nullptr) {
+      errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Unterminated key.";
+      break;
+    }
+
+    if(frame.isFirst) {
+      frame.isFirst = false;
+    } else {
+      stream->writeCharSimple(',');
+    }
+
+    if(!frame.isArray) {
+      writeString(stream, key, keyEnd - key);
+      stream->writeCharSimple(':');
+    }
+
+    pos += keyEnd - key + 1;
+
+    /* bytes available for the value */
+    const v_buff_size left = end - pos;
+
+    switch(typeCode) {
+
+      case TypeCode::NULL_VALUE:
+        stream->writeSimple("null", 4);
+        break;
+
+      case TypeCode::UNDEFINED:
+        stream->writeSimple("{\"$undefined\":true}");
+        break;
+
+      case TypeCode::MIN_KEY:
+        stream->writeSimple("{\"$minKey\":1}");
+        break;
+
+      case TypeCode::MAX_KEY:
+        stream->writeSimple("{\"$maxKey\":1}");
+        break;
+
+      case TypeCode::BOOLEAN:
+        if(left < 1 || data[pos] > 1) {
+          errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Invalid boolean value.";
+          break;
+        }
+        if(data[pos]) {
+          stream->writeSimple("true", 4);
+        } else {
+          stream->writeSimple("false", 5);
+        }
+        pos ++;
+        break;
+
+      case TypeCode::INT_32:
+        if(left < 4) {
+          errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Element exceeds document bounds.";
+          break;
+        }
+        if(canonical) {
+          stream->writeSimple("{\"$numberInt\":");
+          writeQuotedInt64(stream, Utils::loadLE<v_int32>(&data[pos]));
+          stream->writeCharSimple('}');
+        } else {
+          writeInt64(stream, Utils::loadLE<v_int32>(&data[pos]));
+        }
+        pos += 4;
+        break;
+
+      case TypeCode::INT_64:
+        if(left < 8) {
+          errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Element exceeds document bounds.";
+          break;
+        }
+        if(canonical) {
+          stream->writeSimple("{\"$numberLong\":");
+          writeQuotedInt64(stream, Utils::loadLE<v_int64>(&data[pos]));
+          stream->writeCharSimple('}');
+        } else {
+          writeInt64(stream, Utils::loadLE<v_int64>(&data[pos]));
+        }
+        pos += 8;
+        break;
+
+      case TypeCode::DOUBLE:
+        if(left < 8) {
+          errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Element exceeds document bounds.";
+          break;
+        }
+        writeDouble(stream, Utils::loadLE<v_float64>(&data[pos]), canonical);
+        pos += 8;
+        break;
+
+      case TypeCode::DATE_TIME:
+        if(left < 8) {
+          errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Element exceeds document bounds.";
+          break;
+        }
+        writeDate(stream, Utils::loadLE<v_int64>(&data[pos]), canonical);
+        pos += 8;
+        break;
+
+      case TypeCode::TIMESTAMP: {
+        if(left < 8) {
+          errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Element exceeds document bounds.";
+          break;
+        }
+        stream->writeSimple("{\"$timestamp\":{\"t\":");
+        writeInt64(stream, Utils::loadLE<v_uint32>(&data[pos + 4]));
+        stream->writeSimple(",\"i\":");
+        writeInt64(stream, Utils::loadLE<v_uint32>(&data[pos]));
+        stream->writeSimple("}}", 2);
+        pos += 8;
+        break;
+      }
+
+      case TypeCode::OBJECT_ID:
+        if(left < 12) {
+          errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Element exceeds document bounds.";
+          break;
+        }
+        writeObjectId(stream, &data[pos]);
+        pos += 12;
+        break;
+
+      case TypeCode::DECIMAL_128:
+        if(left < 16) {
+          errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Element exceeds document bounds.";
+          break;
+        }
+        stream->writeSimple("{\"$numberDecimal\":\"");
+        {
+          auto decimal = type::Decimal128::fromBytes(&data[pos]).toString();
+          stream->writeSimple(decimal->data(), decimal->size());
+        }
+        stream->writeSimple("\"}", 2);
+        pos += 16;
+        break;
+
+      case TypeCode::STRING:
+      case TypeCode::JAVASCRIPT_CODE:
+      case TypeCode::SYMBOL:
+      case TypeCode::BD_POINTER: {
+
+        v_int32 stringSize = left < 4 ? 0 : Utils::loadLE<v_int32>(&data[pos]);
+        if(stringSize < 1 || stringSize > left - 4 || data[pos + 4 + stringSize - 1] != 0) {
+          errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Invalid string.";
+          break;
+        }
+
+        const char* string = (const char*) &data[pos + 4];
+        pos += 4 + stringSize;
+
+        if(typeCode == TypeCode::STRING) {
+          writeString(stream, string, stringSize - 1);
+        } else if(typeCode == TypeCode::JAVASCRIPT_CODE) {
+          stream->writeSimple("{\"$code\":");
+          writeString(stream, string, stringSize - 1);
+          stream->writeCharSimple('}');
+        } else if(typeCode == TypeCode::SYMBOL) {
+          stream->writeSimple("{\"$symbol\":");
+          writeString(stream, string, stringSize - 1);
+          stream->writeCharSimple('}');
+        } else {
+          if(end - pos < 12) {
+            errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Element exceeds document bounds.";
+            break;
+          }
+          stream->writeSimple("{\"$dbPointer\":{\"$ref\":");
+          writeString(stream, string, stringSize - 1);
+          stream->writeSimple(",\"$id\":");
+          writeObjectId(stream, &data[pos]);
+          stream->writeSimple("}}", 2);
+          pos += 12;
+        }
+
+        break;
+
+      }
+
+      case TypeCode::BINARY: {
+
+        v_int32 binarySize = left < 5 ? -1 : Utils::loadLE<v_int32>(&data[pos]);
+        if(binarySize < 0 || binarySize > left - 5) {
+          errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Invalid binary size.";
+          break;
+        }
+
+        static const char* hex = "0123456789abcdef";
+        v_char8 subtype = data[pos + 4];
+
+        stream->writeSimple("{\"$binary\":{\"base64\":\"");
+        writeBase64(stream, &data[pos + 5], binarySize);
+        char tail[] = {'"', ',', '"', 's', 'u', 'b', 'T', 'y', 'p', 'e', '"', ':', '"', hex[subtype >> 4], hex[subtype & 0x0F], '"', '}', '}'};
+        stream->writeSimple(tail, sizeof(tail));
+
+        pos += 5 + binarySize;
+        break;
+
+      }
+
+      case TypeCode::REGEXP: {
+
+        const char* pattern = (const char*) &data[pos];
+        const char* patternEnd = (const char*) std::memchr(pattern, 0, left);
+        if(patternEnd == nullptr) {
+          errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Unterminated regexp.";
+          break;
+        }
+        pos += patternEnd - pattern + 1;
+
+        const char* flags = (const char*) &data[pos];
+        const char* flagsEnd = (const char*) std::memchr(flags, 0, end - pos);
+        if(flagsEnd == nullptr) {
+          errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Unterminated regexp.";
+          break;
+        }
+        pos += flagsEnd - flags + 1;
+
+        stream->writeSimple("{\"$regularExpression\":{\"pattern\":");
+        writeString(stream, pattern, patternEnd - pattern);
+        stream->writeSimple(",\"options\":");
+        writeString(stream, flags, flagsEnd - flags);
+        stream->writeSimple("}}", 2);
+        break;
+
+      }
+
+      case TypeCode::DOCUMENT_EMBEDDED:
+      case TypeCode::DOCUMENT_ARRAY:
+      case TypeCode::JAVASCRIPT_CODE_WS: {
+
+        if(depth >= maxDepth) {
+          errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Max nesting depth exceeded.";
+          break;
+        }
+
+        v_int32 docSize = left < 5 ? 0 : Utils::loadLE<v_int32>(&data[pos]);
+        if(docSize < 5 || docSize > left) {
+          errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Invalid document size.";
+          break;
+        }
+        v_buff_size docEnd = pos + docSize - 1;
+
+        if(typeCode == TypeCode::JAVASCRIPT_CODE_WS) {
+
+          /* int32 total size, code string, scope document - scope must end exactly where the element ends */
+          pos += 4;
+          v_int32 codeSize = docEnd - pos < 4 ? 0 : Utils::loadLE<v_int32>(&data[pos]);
+          if(codeSize < 1 || codeSize > docEnd - pos - 4 || data[pos + 4 + codeSize - 1] != 0) {
+            errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Invalid code string.";
+            break;
+          }
+
+          stream->writeSimple("{\"$code\":");
+          writeString(stream, (const char*) &data[pos + 4], codeSize - 1);
+          stream->writeSimple(",\"$scope\":{");
+          pos += 4 + codeSize;
+
+          if(docEnd + 1 - pos < 5 || Utils::loadLE<v_int32>(&data[pos]) != docEnd + 1 - pos) {
+            errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Invalid scope document size.";
+            break;
+          }
+
+        } else if(typeCode == TypeCode::DOCUMENT_ARRAY) {
+          stream->writeCharSimple('[');
+        } else {
+          stream->writeCharSimple('{');
+        }
+
+        Frame& child = stack[depth ++];
+        child.end = docEnd;
+        child.isArray = (typeCode == TypeCode::DOCUMENT_ARRAY);
+        child.isFirst = true;
+        child.isCodeScope = (typeCode == TypeCode::JAVASCRIPT_CODE_WS);
+
+        pos += 4;
+        break;
+
+      }
+
+      default:
+        errorMessage = "[oatpp::mongo::bson::json::BsonToJson::transcode()]: Error. Unknown element type-code.";
+
+    }
+
+    if(errorMessage != nullptr) {
+      break;
+    }
+
+  }
+
+  if(errorMessage != nullptr) {
+    caret.setPosition(start + pos);
+    caret.setError(errorMessage);
+    return;
+  }
+
+  caret.setPosition(start + size);
+
+}
+
+oatpp::String BsonToJson::transcodeToString(const oatpp::String& document, const Options& options) {
+
+  if(!document) {
+    throw std::runtime_error("[oatpp::mongo::bson::json::BsonToJson::transcodeToString()]: Error. Document is null.");
+  }
+
+  utils::parser::Caret caret(document);
+  data::stream::BufferOutputStream stream(document->size() * 2);
+  transcode(caret, &stream, options);
+
+  if(caret.hasError()) {
+    throw std::runtime_error(caret.getErrorMessage());
+  }
+
+  return stream.toString();
+
+}
+
+}}}}
@@ -0,0 +1,144 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_mongo_bson_json_BsonToJson_hpp
+#define oatpp_mongo_bson_json_BsonToJson_hpp
+
+#include "oatpp-mongo/bson/Types.hpp"
+
+#include "oatpp/data/stream/Stream.hpp"
+#include "oatpp/utils/parser/Caret.hpp"
+
+namespace oatpp { namespace mongo { namespace bson { namespace json {
+
+/**
+ * Streaming BSON to [Extended JSON v2](https://github.com/mongodb/specifications/blob/master/source/extended-json.md) transcoder. <br>
+ * Walks the BSON bytes and writes JSON straight to the output stream - no DTOs and no intermediate strings are created.
+ * The input is bounds-checked while transcoding, on error the output is left incomplete.
+ */
+class BsonToJson {
+public:
+
+  /**
+   * Hard limit for nesting of documents.
+   */
+  static constexpr v_int32 MAX_DEPTH = 128;
+
+  /**
+   * Buffer size for staging of escaped strings and base64 data.
+   */
+  static constexpr v_buff_size BUFFER_SIZE = 1024;
+
+public:
+
+  /**
+   * Extended JSON output format.
+   */
+  enum class Format : v_int32 {
+
+    /**
+     * Relaxed format - numbers and dates are written as native JSON values where it's lossless.
+     */
+    RELAXED = 0,
+
+    /**
+     * Canonical format - type of every value is preserved.
+     */
+    CANONICAL = 1
+
+  };
+
+  /**
+   * Transcoder options.
+   */
+  struct Options {
+
+    Options()
+      : format(Format::RELAXED)
+      , maxDepth(100)
+    {}
+
+    /**
+     * Output format. &l:BsonToJson::Format;.
+     */
+    Format format;
+
+    /**
+     * Max nesting depth of documents. Capped by &l:BsonToJson::MAX_DEPTH;.
+     */
+    v_int32 maxDepth;
+
+  };
+
+private:
+
+  struct Frame {
+    v_buff_size end;
+    bool isArray;
+    bool isFirst;
+    bool isCodeScope;
+  };
+
+private:
+  static void writeInt64(data::stream::ConsistentOutputStream* stream, v_int64 value);
+  static void writeQuotedInt64(data::stream::ConsistentOutputStream* stream, v_int64 value);
+  static void writeDouble(data::stream::ConsistentOutputStream* stream, v_float64 value, bool canonical);
+  static void writeDate(data::stream::ConsistentOutputStream* stream, v_int64 millis, bool canonical);
+  static void writeBase64(data::stream::ConsistentOutputStream* stream, const v_char8* data, v_buff_size size);
+  static void writeObjectId(data::stream::ConsistentOutputStream* stream, const v_char8* data);
+public:
+
+  /**
+   * Write JSON string literal. Escapes `"`, `\` and control characters, other bytes are copied as-is. <br>
+   * The input is scanned 8 bytes at a time, so runs of plain text are copied with one write.
+   * @param stream - &id:oatpp::data::stream::ConsistentOutputStream;.
+   * @param data - string data.
+   * @param size - string size.
+   */
+  static void writeString(data::stream::ConsistentOutputStream* stream, const char* data, v_buff_size size);
+
+  /**
+   * Transcode BSON document at the caret position to Extended JSON. <br>
+   * On success the caret is moved past the document. On error the caret error is set.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   * @param stream - &id:oatpp::data::stream::ConsistentOutputStream;.
+   * @param options - &l:BsonToJson::Options;.
+   */
+  static void transcode(utils::parser::Caret& caret, data::stream::ConsistentOutputStream* stream, const Options& options = Options());
+
+  /**
+   * Transcode BSON document to Extended JSON.
+   * @param document - BSON document.
+   * @param options - &l:BsonToJson::Options;.
+   * @return - JSON string.
+   * @throws - `std::runtime_error` if the document is malformed.
+   */
+  static oatpp::String transcodeToString(const oatpp::String& document, const Options& options = Options());
+
+};
+
+}}}}
+
+#endif // oatpp_mongo_bson_json_BsonToJson_hpp
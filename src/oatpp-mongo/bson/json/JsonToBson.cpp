@@ -0,0 +1,808 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "JsonToBson.hpp"
+
+#include "oatpp-mongo/bson/Utils.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace oatpp { namespace mongo { namespace bson { namespace json {
+
+namespace {
+
+  template<typename T>
+  void appendLE(std::string& out, T value) {
+    char buffer[sizeof(T)];
+    Utils::storeLE<T>(buffer, value);
+    out.append(buffer, sizeof(T));
+  }
+
+  void appendUtf8(std::string& out, v_uint32 code) {
+    if(code < 0x80) {
+      out.push_back((char) code);
+    } else if(code < 0x800) {
+      out.push_back((char) (0xC0 | (code >> 6)));
+      out.push_back((char) (0x80 | (code & 0x3F)));
+    } else if(code < 0x10000) {
+      out.push_back((char) (0xE0 | (code >> 12)));
+      out.push_back((char) (0x80 | ((code >> 6) & 0x3F)));
+      out.push_back((char) (0x80 | (code & 0x3F)));
+    } else {
+      out.push_back((char) (0xF0 | (code >> 18)));
+      out.push_back((char) (0x80 | ((code >> 12) & 0x3F)));
+      out.push_back((char) (0x80 | ((code >> 6) & 0x3F)));
+      out.push_back((char) (0x80 | (code & 0x3F)));
+    }
+  }
+
+  bool readHex4(const char* data, v_buff_size size, v_buff_size pos, v_uint32& result) {
+    if(size - pos < 4) {
+      return false;
+    }
+    result = 0;
+    for(v_int32 i = 0; i < 4; i ++) {
+      char c = data[pos + i];
+      v_uint32 nibble;
+      if(c >= '0' && c <= '9') {
+        nibble = c - '0';
+      } else if(c >= 'a' && c <= 'f') {
+        nibble = c - 'a' + 10;
+      } else if(c >= 'A' && c <= 'F') {
+        nibble = c - 'A' + 10;
+      } else {
+        return false;
+      }
+      result = (result << 4) | nibble;
+    }
+    return true;
+  }
+
+  bool readDigits(const char* data, v_buff_size size, v_buff_size& pos, v_int32 count, v_int32& result) {
+    if(size - pos < count) {
+      return false;
+    }
+    result = 0;
+    for(v_int32 i = 0; i < count; i ++) {
+      char c = data[pos + i];
+      if(c < '0' || c > '9') {
+        return false;
+      }
+      result = result * 10 + (c - '0');
+    }
+    pos += count;
+    return true;
+  }
+
+  bool readChar(const char* data, v_buff_size size, v_buff_size& pos, char expected) {
+    if(pos < size && data[pos] == expected) {
+      pos ++;
+      return true;
+    }
+    return false;
+  }
+
+  bool readLiteral(const char* data, v_buff_size size, v_buff_size& pos, const char* literal, v_buff_size literalSize) {
+    if(size - pos >= literalSize && std::memcmp(&data[pos], literal, literalSize) == 0) {
+      pos += literalSize;
+      return true;
+    }
+    return false;
+  }
+
+  v_int32 daysInMonth(v_int32 year, v_int32 month) {
+    static const v_int32 days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if(month == 2 && year % 4 == 0 && (year % 100 != 0 || year % 400 == 0)) {
+      return 29;
+    }
+    return days[month - 1];
+  }
+
+  /* days since epoch of the civil date */
+  v_int64 daysFromCivil(v_int64 year, v_int32 month, v_int32 day) {
+    year -= month <= 2 ? 1 : 0;
+    v_int64 era = (year >= 0 ? year : year - 399) / 400;
+    v_int64 yoe = year - era * 400;
+    v_int64 doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    v_int64 doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+  }
+
+}
+
+constexpr v_int32 JsonToBson::MAX_DEPTH;
+constexpr v_buff_size JsonToBson::MAX_RESERVE_SIZE;
+
+void JsonToBson::skipWhitespace(const char* data, v_buff_size size, v_buff_size& pos) {
+  while(pos < size) {
+    char c = data[pos];
+    if(c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+      return;
+    }
+    pos ++;
+  }
+}
+
+const char* JsonToBson::readString(const char* data, v_buff_size size, v_buff_size& pos, std::string& result) {
+
+  if(pos >= size || data[pos] != '"') {
+    return "[oatpp::mongo::bson::json::JsonToBson::readString()]: Error. Expected '\"'.";
+  }
+
+  pos ++;
+  v_buff_size runStart = pos;
+
+  while(pos < size) {
+
+    v_char8 c = (v_char8) data[pos];
+
+    if(c != '"' && c != '\\' && c >= 0x20) {
+      pos ++;
+      continue;
+    }
+
+    result.append(&data[runStart], pos - runStart);
+
+    if(c == '"') {
+      pos ++;
+      return nullptr;
+    }
+
+    if(c < 0x20) {
+      return "[oatpp::mongo::bson::json::JsonToBson::readString()]: Error. Unescaped control character.";
+    }
+
+    if(size - pos < 2) {
+      break;
+    }
+
+    char escaped = data[pos + 1];
+    pos += 2;
+
+    switch(escaped) {
+      case '"': result.push_back('"'); break;
+      case '\\': result.push_back('\\'); break;
+      case '/': result.push_back('/'); break;
+      case 'b': result.push_back('\b'); break;
+      case 'f': result.push_back('\f'); break;
+      case 'n': result.push_back('\n'); break;
+      case 'r': result.push_back('\r'); break;
+      case 't': result.push_back('\t'); break;
+      case 'u': {
+        v_uint32 code;
+        if(!readHex4(data, size, pos, code)) {
+          return "[oatpp::mongo::bson::json::JsonToBson::readString()]: Error. Invalid unicode escape.";
+        }
+        pos += 4;
+        if(code >= 0xD800 && code <= 0xDBFF) {
+          v_uint32 low;
+          if(size - pos < 6 || data[pos] != '\\' || data[pos + 1] != 'u' ||
+             !readHex4(data, size, pos + 2, low) || low < 0xDC00 || low > 0xDFFF)
+          {
+            return "[oatpp::mongo::bson::json::JsonToBson::readString()]: Error. Invalid surrogate pair.";
+          }
+          pos += 6;
+          code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+        } else if(code >= 0xDC00 && code <= 0xDFFF) {
+          return "[oatpp::mongo::bson::json::JsonToBson::readString()]: Error. Invalid surrogate pair.";
+        }
+        appendUtf8(result, code);
+        break;
+      }
+      default:
+        return "[oatpp::mongo::bson::json::JsonToBson::readString()]: Error. Invalid escape sequence.";
+    }
+
+    runStart = pos;
+
+  }
+
+  return "[oatpp::mongo::bson::json::JsonToBson::readString()]: Error. Unterminated string.";
+
+}
+
+const char* JsonToBson::writeString(const char* data, v_buff_size size, v_buff_size& pos, std::string& out, v_buff_size typePosition) {
+  out[typePosition] = TypeCode::STRING;
+  v_buff_size sizePosition = out.size();
+  out.append(4, 0);
+  const char* error = readString(data, size, pos, out);
+  if(error != nullptr) {
+    return error;
+  }
+  out.push_back(0);
+  Utils::storeLE<v_int32>(&out[sizePosition], (v_int32) (out.size() - sizePosition - 4));
+  return nullptr;
+}
+
+const char* JsonToBson::writeNumber(const char* data, v_buff_size size, v_buff_size& pos, std::string& out, v_buff_size typePosition) {
+
+  v_buff_size start = pos;
+  bool isInteger = true;
+
+  readChar(data, size, pos, '-');
+
+  if(readChar(data, size, pos, '0')) {
+    // no leading zeros
+  } else if(pos < size && data[pos] >= '1' && data[pos] <= '9') {
+    while(pos < size && data[pos] >= '0' && data[pos] <= '9') pos ++;
+  } else {
+    return "[oatpp::mongo::bson::json::JsonToBson::writeNumber()]: Error. Invalid value.";
+  }
+
+  if(readChar(data, size, pos, '.')) {
+    isInteger = false;
+    v_buff_size digitsStart = pos;
+    while(pos < size && data[pos] >= '0' && data[pos] <= '9') pos ++;
+    if(pos == digitsStart) {
+      return "[oatpp::mongo::bson::json::JsonToBson::writeNumber()]: Error. Invalid number.";
+    }
+  }
+
+  if(readChar(data, size, pos, 'e') || readChar(data, size, pos, 'E')) {
+    isInteger = false;
+    if(!readChar(data, size, pos, '+')) {
+      readChar(data, size, pos, '-');
+    }
+    v_buff_size digitsStart = pos;
+    while(pos < size && data[pos] >= '0' && data[pos] <= '9') pos ++;
+    if(pos == digitsStart) {
+      return "[oatpp::mongo::bson::json::JsonToBson::writeNumber()]: Error. Invalid number.";
+    }
+  }
+
+  v_int64 integer;
+  if(isInteger && parseInt64(&data[start], pos - start, integer)) {
+    if(integer >= std::numeric_limits<v_int32>::min() && integer <= std::numeric_limits<v_int32>::max()) {
+      out[typePosition] = TypeCode::INT_32;
+      appendLE<v_int32>(out, (v_int32) integer);
+    } else {
+      out[typePosition] = TypeCode::INT_64;
+      appendLE<v_int64>(out, integer);
+    }
+    return nullptr;
+  }
+
+  v_float64 value;
+  if(!parseDouble(&data[start], pos - start, value)) {
+    return "[oatpp::mongo::bson::json::JsonToBson::writeNumber()]: Error. Invalid number.";
+  }
+  out[typePosition] = TypeCode::DOUBLE;
+  appendLE<v_float64>(out, value);
+  return nullptr;
+
+}
+
+bool JsonToBson::parseInt64(const char* data, v_buff_size size, v_int64& result) {
+
+  bool negative = size > 0 && data[0] == '-';
+  v_buff_size i = negative ? 1 : 0;
+  if(i == size || size - i > 19) {
+    return false;
+  }
+
+  v_uint64 value = 0;
+  for(; i < size; i ++) {
+    char c = data[i];
+    if(c < '0' || c > '9') {
+      return false;
+    }
+    value = value * 10 + (c - '0');
+  }
+
+  v_uint64 limit = negative ? (v_uint64) std::numeric_limits<v_int64>::max() + 1 : (v_uint64) std::numeric_limits<v_int64>::max();
+  if(value > limit) {
+    return false;
+  }
+
+  result = negative ? (v_int64) (0 - value) : (v_int64) value;
+  return true;
+
+}
+
+bool JsonToBson::parseDouble(const char* data, v_buff_size size, v_float64& result) {
+
+  /*
+   * [-]digits[.digits][(e|E)[+|-]digits]
+   * Decimal point is locale-specific - so the fraction is moved to the exponent
+   * and strtod() gets the digits without the point. Same as in Decimal128::toDouble().
+   */
+
+  std::string buffer;
+  buffer.reserve(size + 24);
+
+  v_buff_size pos = 0;
+  if(readChar(data, size, pos, '-')) {
+    buffer.push_back('-');
+  }
+
+  v_int64 exponent = 0;
+  bool hasDigits = false;
+
+  while(pos < size && data[pos] >= '0' && data[pos] <= '9') {
+    buffer.push_back(data[pos ++]);
+    hasDigits = true;
+  }
+
+  if(readChar(data, size, pos, '.')) {
+    while(pos < size && data[pos] >= '0' && data[pos] <= '9') {
+      buffer.push_back(data[pos ++]);
+      exponent --;
+      hasDigits = true;
+    }
+  }
+
+  if(!hasDigits) {
+    return false;
+  }
+
+  if(readChar(data, size, pos, 'e') || readChar(data, size, pos, 'E')) {
+    bool negative = readChar(data, size, pos, '-');
+    if(!negative) {
+      readChar(data, size, pos, '+');
+    }
+    v_buff_size digitsStart = pos;
+    v_int64 value = 0;
+    while(pos < size && data[pos] >= '0' && data[pos] <= '9') {
+      /* far beyond the range of double - keep it from overflowing */
+      if(value < 100000000) {
+        value = value * 10 + (data[pos] - '0');
+      }
+      pos ++;
+    }
+    if(pos == digitsStart) {
+      return false;
+    }
+    exponent += negative ? -value : value;
+  }
+
+  if(pos != size) {
+    return false;
+  }
+
+  buffer.push_back('e');
+  buffer.append(std::to_string(exponent));
+  result = std::strtod(buffer.c_str(), nullptr);
+  return true;
+
+}
+
+bool JsonToBson::parseDate(const char* data, v_buff_size size, v_int64& result) {
+
+  /* YYYY-MM-DDTHH:MM:SS[.fff][Z|+HH:MM|+HHMM] */
+
+  v_buff_size pos = 0;
+  v_int32 year, month, day, hours, minutes, seconds;
+
+  if(!readDigits(data, size, pos, 4, year) || !readChar(data, size, pos, '-') ||
+     !readDigits(data, size, pos, 2, month) || !readChar(data, size, pos, '-') ||
+     !readDigits(data, size, pos, 2, day) || !readChar(data, size, pos, 'T') ||
+     !readDigits(data, size, pos, 2, hours) || !readChar(data, size, pos, ':') ||
+     !readDigits(data, size, pos, 2, minutes) || !readChar(data, size, pos, ':') ||
+     !readDigits(data, size, pos, 2, seconds))
+  {
+    return false;
+  }
+
+  if(month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) || hours > 23 || minutes > 59 || seconds > 60) {
+    return false;
+  }
+
+  v_int64 millis = 0;
+  if(readChar(data, size, pos, '.')) {
+    v_int32 digits = 0;
+    while(pos < size && data[pos] >= '0' && data[pos] <= '9') {
+      if(digits < 3) {
+        millis = millis * 10 + (data[pos] - '0');
+      }
+      digits ++;
+      pos ++;
+    }
+    if(digits == 0) {
+      return false;
+    }
+    for(; digits < 3; digits ++) {
+      millis *= 10;
+    }
+  }
+
+  v_int64 offsetMinutes = 0;
+  if(!readChar(data, size, pos, 'Z')) {
+    bool negative = false;
+    if(readChar(data, size, pos, '-')) {
+      negative = true;
+    } else if(!readChar(data, size, pos, '+')) {
+      return false;
+    }
+    v_int32 offsetHours, offsetMins;
+    if(!readDigits(data, size, pos, 2, offsetHours)) {
+      return false;
+    }
+    readChar(data, size, pos, ':');
+    if(!readDigits(data, size, pos, 2, offsetMins)) {
+      return false;
+    }
+    offsetMinutes = offsetHours * 60 + offsetMins;
+    if(negative) {
+      offsetMinutes = -offsetMinutes;
+    }
+  }
+
+  if(pos != size) {
+    return false;
+  }
+
+  v_int64 days = daysFromCivil(year, month, day);
+  result = ((days * 24 + hours) * 60 + minutes - offsetMinutes) * 60000 + seconds * 1000 + millis;
+  return true;
+
+}
+
+JsonToBson::Wrapper JsonToBson::getWrapper(const std::string& key) {
+  if(key == "$oid") return OID;
+  if(key == "$date") return DATE;
+  if(key == "$numberDecimal") return NUMBER_DECIMAL;
+  if(key == "$numberLong") return NUMBER_LONG;
+  if(key == "$numberInt") return NUMBER_INT;
+  if(key == "$numberDouble") return NUMBER_DOUBLE;
+  return NONE;
+}
+
+const char* JsonToBson::writeWrapper(Wrapper wrapper, const char* data, v_buff_size size, v_buff_size& pos,
+                                     std::string& scratch, std::string& out, v_buff_size typePosition)
+{
+
+  /* {"$date": <millis>} */
+  if(wrapper == DATE && pos < size && data[pos] != '"' && data[pos] != '{') {
+    v_buff_size start = pos;
+    readChar(data, size, pos, '-');
+    while(pos < size && data[pos] >= '0' && data[pos] <= '9') pos ++;
+    v_int64 millis;
+    if(!parseInt64(&data[start], pos - start, millis)) {
+      return "[oatpp::mongo::bson::json::JsonToBson::writeWrapper()]: Error. Invalid $date.";
+    }
+    out[typePosition] = TypeCode::DATE_TIME;
+    appendLE<v_int64>(out, millis);
+    return nullptr;
+  }
+
+  /* {"$date": {"$numberLong": "<millis>"}} */
+  bool isCanonicalDate = false;
+  if(wrapper == DATE && pos < size && data[pos] == '{') {
+    pos ++;
+    skipWhitespace(data, size, pos);
+    scratch.clear();
+    if(readString(data, size, pos, scratch) != nullptr || scratch != "$numberLong") {
+      return "[oatpp::mongo::bson::json::JsonToBson::writeWrapper()]: Error. Invalid $date.";
+    }
+    skipWhitespace(data, size, pos);
+    if(!readChar(data, size, pos, ':')) {
+      return "[oatpp::mongo::bson::json::JsonToBson::writeWrapper()]: Error. Invalid $date.";
+    }
+    skipWhitespace(data, size, pos);
+    isCanonicalDate = true;
+  }
+
+  scratch.clear();
+  const char* error = readString(data, size, pos, scratch);
+  if(error != nullptr) {
+    return error;
+  }
+
+  switch(wrapper) {
+
+    case OID: {
+      v_char8 bytes[type::ObjectId::DATA_SIZE] = {0};
+      type::ObjectId id(bytes);
+      if(!type::ObjectId::tryParse(scratch.data(), scratch.size(), id)) {
+        return "[oatpp::mongo::bson::json::JsonToBson::writeWrapper()]: Error. Invalid $oid.";
+      }
+      out[typePosition] = TypeCode::OBJECT_ID;
+      out.append((const char*) id.getData(), type::ObjectId::DATA_SIZE);
+      return nullptr;
+    }
+
+    case DATE: {
+      v_int64 millis;
+      if(isCanonicalDate) {
+        skipWhitespace(data, size, pos);
+        if(!readChar(data, size, pos, '}') || !parseInt64(scratch.data(), scratch.size(), millis)) {
+          return "[oatpp::mongo::bson::json::JsonToBson::writeWrapper()]: Error. Invalid $date.";
+        }
+      } else if(!parseDate(scratch.data(), scratch.size(), millis)) {
+        return "[oatpp::mongo::bson::json::JsonToBson::writeWrapper()]: Error. Invalid $date.";
+      }
+      out[typePosition] = TypeCode::DATE_TIME;
+      appendLE<v_int64>(out, millis);
+      return nullptr;
+    }
+
+    case NUMBER_DECIMAL: {
+      type::Decimal128 decimal;
+      if(!type::Decimal128::tryParse(scratch.data(), scratch.size(), decimal)) {
+        return "[oatpp::mongo::bson::json::JsonToBson::writeWrapper()]: Error. Invalid $numberDecimal.";
+      }
+      char bytes[type::Decimal128::DATA_SIZE];
+      decimal.toBytes(bytes);
+      out[typePosition] = TypeCode::DECIMAL_128;
+      out.append(bytes, type::Decimal128::DATA_SIZE);
+      return nullptr;
+    }
+
+    case NUMBER_LONG: {
+      v_int64 value;
+      if(!parseInt64(scratch.data(), scratch.size(), value)) {
+        return "[oatpp::mongo::bson::json::JsonToBson::writeWrapper()]: Error. Invalid $numberLong.";
+      }
+      out[typePosition] = TypeCode::INT_64;
+      appendLE<v_int64>(out, value);
+      return nullptr;
+    }
+
+    case NUMBER_INT: {
+      v_int64 value;
+      if(!parseInt64(scratch.data(), scratch.size(), value) ||
+         value < std::numeric_limits<v_int32>::min() || value > std::numeric_limits<v_int32>::max())
+      {
+        return "[oatpp::mongo::bson::json::JsonToBson::writeWrapper()]: Error. Invalid $numberInt.";
+      }
+      out[typePosition] = TypeCode::INT_32;
+      appendLE<v_int32>(out, (v_int32) value);
+      return nullptr;
+    }
+
+    case NUMBER_DOUBLE: {
+      v_float64 value;
+      if(scratch == "Infinity") {
+        value = std::numeric_limits<v_float64>::infinity();
+      } else if(scratch == "-Infinity") {
+        value = -std::numeric_limits<v_float64>::infinity();
+      } else if(scratch == "NaN") {
+        value = std::numeric_limits<v_float64>::quiet_NaN();
+      } else if(!parseDouble(scratch.data(), scratch.size(), value)) {
+        return "[oatpp::mongo::bson::json::JsonToBson::writeWrapper()]: Error. Invalid $numberDouble.";
+      }
+      out[typePosition] = TypeCode::DOUBLE;
+      appendLE<v_float64>(out, value);
+      return nullptr;
+    }
+
+    default:
+      return "[oatpp::mongo::bson::json::JsonToBson::writeWrapper()]: Error. Unknown wrapper.";
+
+  }
+
+}
+
+void JsonToBson::transcode(utils::parser::Caret& caret, data::stream::ConsistentOutputStream* stream, const Options& options) {
+
+  const char* data = caret.getData();
+  const v_buff_size size = caret.getDataSize();
+  v_buff_size pos = caret.getPosition();
+
+  v_int32 maxDepth = options.maxDepth;
+  if(maxDepth > MAX_DEPTH || maxDepth < 1) {
+    maxDepth = MAX_DEPTH;
+  }
+
+  skipWhitespace(data, size, pos);
+  if(!readChar(data, size, pos, '{')) {
+    caret.setPosition(pos);
+    caret.setError("[oatpp::mongo::bson::json::JsonToBson::transcode()]: Error. Expected '{'.");
+    return;
+  }
+
+  /*
+   * BSON is almost always smaller than its JSON. The caret may span many documents,
+   * so the reserve is capped - bigger documents grow the buffer as usual.
+   */
+  std::string out;
+  v_buff_size reserve = size - pos + 5;
+  out.reserve(reserve < MAX_RESERVE_SIZE ? reserve : MAX_RESERVE_SIZE);
+  out.append(4, 0);
+
+  std::string scratch;
+  const char* error = nullptr;
+
+  Frame stack[MAX_DEPTH];
+  v_int32 depth = 1;
+  stack[0].start = 0;
+  stack[0].typePosition = -1;
+  stack[0].count = 0;
+  stack[0].isArray = false;
+
+  while(depth > 0) {
+
+    Frame& frame = stack[depth - 1];
+
+    skipWhitespace(data, size, pos);
+
+    if(readChar(data, size, pos, frame.isArray ? ']' : '}')) {
+      out.push_back(0);
+      Utils::storeLE<v_int32>(&out[frame.start], (v_int32) (out.size() - frame.start));
+      depth --;
+      continue;
+    }
+
+    if(frame.count > 0) {
+      if(!readChar(data, size, pos, ',')) {
+        error = "[oatpp::mongo::bson::json::JsonToBson::transcode()]: Error. Expected ',' or end of the container.";
+        break;
+      }
+      skipWhitespace(data, size, pos);
+    }
+
+    v_buff_size typePosition = out.size();
+
+    if(frame.isArray) {
+
+      out.push_back(0);
+      char index[16];
+      char* indexEnd = index + sizeof(index);
+      char* p = indexEnd;
+      v_int32 value = frame.count;
+      do {
+        *--p = (char) ('0' + value % 10);
+        value /= 10;
+      } while(value > 0);
+      out.append(p, indexEnd - p);
+      out.push_back(0);
+
+    } else {
+
+      scratch.clear();
+      error = readString(data, size, pos, scratch);
+      if(error != nullptr) {
+        break;
+      }
+      if(scratch.find('\0') != std::string::npos) {
+        error = "[oatpp::mongo::bson::json::JsonToBson::transcode()]: Error. Key contains '\\0'.";
+        break;
+      }
+
+      skipWhitespace(data, size, pos);
+      if(!readChar(data, size, pos, ':')) {
+        error = "[oatpp::mongo::bson::json::JsonToBson::transcode()]: Error. Expected ':'.";
+        break;
+      }
+      skipWhitespace(data, size, pos);
+
+      if(options.extendedJson && frame.count == 0 && frame.typePosition >= 0 && scratch[0] == '$') {
+        Wrapper wrapper = getWrapper(scratch);
+        if(wrapper != NONE) {
+          /* the object is a value wrapper - drop the document header and write the value in its place */
+          v_buff_size parentTypePosition = frame.typePosition;
+          out.resize(frame.start);
+          depth --;
+          error = writeWrapper(wrapper, data, size, pos, scratch, out, parentTypePosition);
+          if(error != nullptr) {
+            break;
+          }
+          skipWhitespace(data, size, pos);
+          if(!readChar(data, size, pos, '}')) {
+            error = "[oatpp::mongo::bson::json::JsonToBson::transcode()]: Error. Unexpected field in Extended JSON value.";
+            break;
+          }
+          continue;
+        }
+      }
+
+      out.push_back(0);
+      out.append(scratch);
+      out.push_back(0);
+
+    }
+
+    frame.count ++;
+
+    if(pos >= size) {
+      error = "[oatpp::mongo::bson::json::JsonToBson::transcode()]: Error. Unexpected end of input.";
+      break;
+    }
+
+    switch(data[pos]) {
+
+      case '{':
+      case '[': {
+        if(depth >= maxDepth) {
+          error = "[oatpp::mongo::bson::json::JsonToBson::transcode()]: Error. Max nesting depth exceeded.";
+          break;
+        }
+        bool isArray = data[pos] == '[';
+        pos ++;
+        out[typePosition] = isArray ? TypeCode::DOCUMENT_ARRAY : TypeCode::DOCUMENT_EMBEDDED;
+        Frame& child = stack[depth ++];
+        child.start = out.size();
+        child.typePosition = typePosition;
+        child.count = 0;
+        child.isArray = isArray;
+        out.append(4, 0);
+        break;
+      }
+
+      case '"':
+        error = writeString(data, size, pos, out, typePosition);
+        break;
+
+      case 't':
+      case 'f':
+      case 'n':
+        if(readLiteral(data, size, pos, "true", 4)) {
+          out[typePosition] = TypeCode::BOOLEAN;
+          out.push_back(1);
+        } else if(readLiteral(data, size, pos, "false", 5)) {
+          out[typePosition] = TypeCode::BOOLEAN;
+          out.push_back(0);
+        } else if(readLiteral(data, size, pos, "null", 4)) {
+          out[typePosition] = TypeCode::NULL_VALUE;
+        } else {
+          error = "[oatpp::mongo::bson::json::JsonToBson::transcode()]: Error. Invalid value.";
+        }
+        break;
+
+      default:
+        error = writeNumber(data, size, pos, out, typePosition);
+
+    }
+
+    if(error != nullptr) {
+      break;
+    }
+
+  }
+
+  if(error != nullptr) {
+    caret.setPosition(pos);
+    caret.setError(error);
+    return;
+  }
+
+  caret.setPosition(pos);
+  stream->writeSimple(out.data(), out.size());
+
+}
+
+oatpp::String JsonToBson::transcodeToString(const oatpp::String& json, const Options& options) {
+
+  if(!json) {
+    throw std::runtime_error("[oatpp::mongo::bson::json::JsonToBson::transcodeToString()]: Error. JSON is null.");
+  }
+
+  utils::parser::Caret caret(json);
+  data::stream::BufferOutputStream stream(json->size());
+  transcode(caret, &stream, options);
+
+  if(caret.hasError()) {
+    throw std::runtime_error(caret.getErrorMessage());
+  }
+
+  return stream.toString();
+
+}
+
+}}}}
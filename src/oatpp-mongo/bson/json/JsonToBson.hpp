@@ -0,0 +1,136 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_mongo_bson_json_JsonToBson_hpp
+#define oatpp_mongo_bson_json_JsonToBson_hpp
+
+#include "oatpp-mongo/bson/Types.hpp"
+
+#include "oatpp/data/stream/Stream.hpp"
+#include "oatpp/utils/parser/Caret.hpp"
+
+namespace oatpp { namespace mongo { namespace bson { namespace json {
+
+/**
+ * Single-pass JSON to BSON transcoder. <br>
+ * Encodes BSON while tokenizing JSON - element type-codes and document sizes are written as placeholders
+ * and patched when the value/document is complete. No DTOs are created. <br>
+ * Supported Extended JSON wrappers: `$oid`, `$date`, `$numberDecimal`, `$numberLong`, `$numberInt`, `$numberDouble`.
+ * Objects with other `$`-keys are encoded as regular documents. <br>
+ * JSON numbers are encoded as Int32 or Int64 if they are integers that fit, otherwise as Double.
+ */
+class JsonToBson {
+public:
+
+  /**
+   * Hard limit for nesting of documents.
+   */
+  static constexpr v_int32 MAX_DEPTH = 128;
+
+  /**
+   * Max size reserved for the output document upfront.
+   */
+  static constexpr v_buff_size MAX_RESERVE_SIZE = 64 * 1024;
+
+public:
+
+  /**
+   * Transcoder options.
+   */
+  struct Options {
+
+    Options()
+      : extendedJson(true)
+      , maxDepth(100)
+    {}
+
+    /**
+     * Decode Extended JSON wrappers. If `false` wrappers are encoded as regular documents.
+     */
+    bool extendedJson;
+
+    /**
+     * Max nesting depth of documents. Capped by &l:JsonToBson::MAX_DEPTH;.
+     */
+    v_int32 maxDepth;
+
+  };
+
+private:
+
+  enum Wrapper : v_int32 {
+    NONE = 0,
+    OID = 1,
+    DATE = 2,
+    NUMBER_DECIMAL = 3,
+    NUMBER_LONG = 4,
+    NUMBER_INT = 5,
+    NUMBER_DOUBLE = 6
+  };
+
+  struct Frame {
+    v_buff_size start;
+    v_buff_size typePosition;
+    v_int32 count;
+    bool isArray;
+  };
+
+private:
+  static void skipWhitespace(const char* data, v_buff_size size, v_buff_size& pos);
+  static const char* readString(const char* data, v_buff_size size, v_buff_size& pos, std::string& result);
+  static const char* writeString(const char* data, v_buff_size size, v_buff_size& pos, std::string& out, v_buff_size typePosition);
+  static const char* writeNumber(const char* data, v_buff_size size, v_buff_size& pos, std::string& out, v_buff_size typePosition);
+  static const char* writeWrapper(Wrapper wrapper, const char* data, v_buff_size size, v_buff_size& pos,
+                                  std::string& scratch, std::string& out, v_buff_size typePosition);
+  static bool parseInt64(const char* data, v_buff_size size, v_int64& result);
+  static bool parseDouble(const char* data, v_buff_size size, v_float64& result);
+  static bool parseDate(const char* data, v_buff_size size, v_int64& result);
+  static Wrapper getWrapper(const std::string& key);
+public:
+
+  /**
+   * Transcode JSON object at the caret position to BSON document. <br>
+   * The document is written to the stream only if the whole JSON object is transcoded successfully.
+   * On success the caret is moved past the JSON object. On error the caret error is set.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   * @param stream - &id:oatpp::data::stream::ConsistentOutputStream;.
+   * @param options - &l:JsonToBson::Options;.
+   */
+  static void transcode(utils::parser::Caret& caret, data::stream::ConsistentOutputStream* stream, const Options& options = Options());
+
+  /**
+   * Transcode JSON object to BSON document.
+   * @param json - JSON object.
+   * @param options - &l:JsonToBson::Options;.
+   * @return - BSON document.
+   * @throws - `std::runtime_error` if JSON is malformed.
+   */
+  static oatpp::String transcodeToString(const oatpp::String& json, const Options& options = Options());
+
+};
+
+}}}}
+
+#endif // oatpp_mongo_bson_json_JsonToBson_hpp
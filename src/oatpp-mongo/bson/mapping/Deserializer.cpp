@@ -25,10 +25,22 @@
 
 #include "Deserializer.hpp"
 
+#include "oatpp/data/stream/BufferStream.hpp"
+
+#include <cstring>
+
 namespace oatpp { namespace mongo { namespace bson { namespace mapping {
 
+Deserializer::Scratch::Scratch()
+  : version(0)
+  , stacks(&Deserializer::clearStack)
+  , keysGeneration(0)
+{}
+
 Deserializer::Deserializer(const std::shared_ptr<Config>& config)
   : m_config(config)
+  , m_frozen(false)
+  , m_version(0)
 {
 
   m_methods.resize(data::type::ClassId::getClassCount(), nullptr);
@@ -73,66 +85,128 @@ Deserializer::Deserializer(const std::shared_ptr<Config>& config)
   setDeserializerMethod(oatpp::mongo::bson::__class::InlineArray::CLASS_ID, &Deserializer::deserializeInlineDocs);
 
   setDeserializerMethod(oatpp::mongo::bson::__class::ObjectId::CLASS_ID, &Deserializer::deserializeObjectId);
+  setDeserializerMethod(oatpp::mongo::bson::__class::Binary::CLASS_ID, &Deserializer::deserializeBinary);
+  setDeserializerMethod(oatpp::mongo::bson::__class::Decimal128::CLASS_ID, &Deserializer::deserializeDecimal128);
+  setDeserializerMethod(oatpp::mongo::bson::__class::RawValue::CLASS_ID, &Deserializer::deserializeRawValue);
+  setDeserializerMethod(oatpp::mongo::bson::__class::Document::CLASS_ID, &Deserializer::deserializeDocument);
+  setDeserializerMethod(oatpp::mongo::bson::__class::JsonDocument::CLASS_ID, &Deserializer::deserializeJsonDocument);
 
   setDeserializerMethod(oatpp::mongo::bson::__class::DateTime::CLASS_ID, &Deserializer::deserializeDateTime);
 
+  //----------------
+  // Deserialize into existing objects
+
+  m_intoMethods.resize(data::type::ClassId::getClassCount(), nullptr);
+
+  setDeserializerIntoMethod(data::type::__class::String::CLASS_ID, &Deserializer::deserializeStringInto);
+
+  setDeserializerIntoMethod(data::type::__class::Int8::CLASS_ID, &Deserializer::deserializePrimitiveInto<oatpp::Int8>);
+  setDeserializerIntoMethod(data::type::__class::UInt8::CLASS_ID, &Deserializer::deserializePrimitiveInto<oatpp::UInt8>);
+
+  setDeserializerIntoMethod(data::type::__class::Int16::CLASS_ID, &Deserializer::deserializePrimitiveInto<oatpp::Int16>);
+  setDeserializerIntoMethod(data::type::__class::UInt16::CLASS_ID, &Deserializer::deserializePrimitiveInto<oatpp::UInt16>);
+
+  setDeserializerIntoMethod(data::type::__class::Int32::CLASS_ID, &Deserializer::deserializePrimitiveInto<oatpp::Int32>);
+  setDeserializerIntoMethod(data::type::__class::UInt32::CLASS_ID, &Deserializer::deserializePrimitiveInto<oatpp::UInt32>);
+
+  setDeserializerIntoMethod(data::type::__class::Int64::CLASS_ID, &Deserializer::deserializePrimitiveInto<oatpp::Int64>);
+  setDeserializerIntoMethod(data::type::__class::UInt64::CLASS_ID, &Deserializer::deserializePrimitiveInto<oatpp::UInt64>);
+
+  setDeserializerIntoMethod(data::type::__class::Float32::CLASS_ID, &Deserializer::deserializePrimitiveInto<Float32>);
+  setDeserializerIntoMethod(data::type::__class::Float64::CLASS_ID, &Deserializer::deserializePrimitiveInto<Float64>);
+  setDeserializerIntoMethod(data::type::__class::Boolean::CLASS_ID, &Deserializer::deserializeBooleanInto);
+
+  setDeserializerIntoMethod(data::type::__class::AbstractObject::CLASS_ID, &Deserializer::deserializeObjectInto);
+
+  setDeserializerIntoMethod(data::type::__class::AbstractVector::CLASS_ID, &Deserializer::deserializeCollectionInto);
+  setDeserializerIntoMethod(data::type::__class::AbstractList::CLASS_ID, &Deserializer::deserializeCollectionInto);
+  setDeserializerIntoMethod(data::type::__class::AbstractUnorderedSet::CLASS_ID, &Deserializer::deserializeCollectionInto);
+
+  setDeserializerIntoMethod(oatpp::mongo::bson::__class::DateTime::CLASS_ID, &Deserializer::deserializeDateTimeInto);
+
+  //----------------
+  // Capacity pre-sizing
+
+  enableReserve<oatpp::Vector<oatpp::String>>();
+  enableReserve<oatpp::Vector<oatpp::Int8>>();
+  enableReserve<oatpp::Vector<oatpp::UInt8>>();
+  enableReserve<oatpp::Vector<oatpp::Int16>>();
+  enableReserve<oatpp::Vector<oatpp::UInt16>>();
+  enableReserve<oatpp::Vector<oatpp::Int32>>();
+  enableReserve<oatpp::Vector<oatpp::UInt32>>();
+  enableReserve<oatpp::Vector<oatpp::Int64>>();
+  enableReserve<oatpp::Vector<oatpp::UInt64>>();
+  enableReserve<oatpp::Vector<oatpp::Float32>>();
+  enableReserve<oatpp::Vector<oatpp::Float64>>();
+  enableReserve<oatpp::Vector<oatpp::Boolean>>();
+  enableReserve<oatpp::Vector<oatpp::Any>>();
+
+  enableReserve<oatpp::UnorderedSet<oatpp::String>>();
+  enableReserve<oatpp::UnorderedFields<oatpp::String>>();
+  enableReserve<oatpp::UnorderedFields<oatpp::Any>>();
+
+  //----------------
+  // Packed collections of numeric primitives
+
+  enablePacked<oatpp::Vector<oatpp::Int32>>();
+  enablePacked<oatpp::Vector<oatpp::Int64>>();
+  enablePacked<oatpp::Vector<oatpp::Float32>>();
+  enablePacked<oatpp::Vector<oatpp::Float64>>();
+
+  enablePacked<oatpp::List<oatpp::Int32>>();
+  enablePacked<oatpp::List<oatpp::Int64>>();
+  enablePacked<oatpp::List<oatpp::Float32>>();
+  enablePacked<oatpp::List<oatpp::Float64>>();
+
 }
 
-void Deserializer::setDeserializerMethod(const data::type::ClassId& classId, DeserializerMethod method) {
-  const v_uint32 id = classId.id;
-  if(id >= m_methods.size()) {
-    m_methods.resize(id + 1, nullptr);
-  }
-  m_methods[id] = method;
+void Deserializer::clearStack(std::vector<Frame>& stack) {
+  stack.clear();
 }
 
-void Deserializer::skipCString(utils::parser::Caret& caret) {
-  caret.findChar(0);
-  if(!caret.canContinueAtChar(0, 1)) {
-    caret.setError("[oatpp::mongo::bson::mapping::Deserializer::skipCString()]: Error. Unterminated CString.");
+void Deserializer::checkNotFrozen(const char* methodName) {
+  if(m_frozen) {
+    throw std::runtime_error(std::string("[oatpp::mongo::bson::mapping::Deserializer::") + methodName + "()]: Error. Deserializer is frozen.");
   }
 }
 
-void Deserializer::skipSizedElement(utils::parser::Caret& caret, v_int32 additionalBytes) {
-  v_int32 size = Utils::readInt32(caret);
-  if (size + caret.getPosition() + additionalBytes > caret.getDataSize() || size + additionalBytes < 0) {
-    caret.setError("[oatpp::mongo::bson::mapping::Deserializer::skipSizedElement()]: Error. Invalid element size.");
+Deserializer::Scratch& Deserializer::getScratch() {
+  Scratch& scratch = m_scratch.get();
+  const v_uint64 version = m_version.load(std::memory_order_acquire);
+  if(scratch.version != version) {
+    scratch.plans.clear(); // methods were changed
+    scratch.version = version;
   }
-  caret.inc(size + additionalBytes);
+  return scratch;
 }
 
-void Deserializer::skipElement(utils::parser::Caret& caret, v_char8 bsonTypeCode) {
-
-  switch(bsonTypeCode) {
+void Deserializer::freeze() {
+  m_frozen = true;
+}
 
-    case TypeCode::DOUBLE: caret.inc(8);                            break;
-    case TypeCode::STRING: skipSizedElement(caret);                 break;
-    case TypeCode::DOCUMENT_EMBEDDED: skipSizedElement(caret, -4);  break;
-    case TypeCode::DOCUMENT_ARRAY: skipSizedElement(caret, -4);     break;
-    case TypeCode::BINARY: skipSizedElement(caret, 1);              break;
-    case TypeCode::UNDEFINED:                                       break;
-    case TypeCode::OBJECT_ID: caret.inc(12);                        break;
-    case TypeCode::BOOLEAN: caret.inc();                            break;
-    case TypeCode::DATE_TIME: caret.inc(8);                         break;
-    case TypeCode::NULL_VALUE:                                      break;
-    case TypeCode::REGEXP: skipCString(caret); skipCString(caret);  break;
-    case TypeCode::BD_POINTER: skipSizedElement(caret, 12);         break;
-    case TypeCode::JAVASCRIPT_CODE: skipSizedElement(caret);        break;
-    case TypeCode::SYMBOL: skipSizedElement(caret);                 break;
-    case TypeCode::JAVASCRIPT_CODE_WS: skipSizedElement(caret, -4); break;
-    case TypeCode::INT_32: caret.inc(4);                            break;
-    case TypeCode::TIMESTAMP: caret.inc(8);                         break;
-    case TypeCode::INT_64: caret.inc(8);                            break;
-    case TypeCode::DECIMAL_128: caret.inc(16);                      break;
-
-    case TypeCode::MIN_KEY:                                         break;
-    case TypeCode::MAX_KEY:                                         break;
+bool Deserializer::isFrozen() const {
+  return m_frozen;
+}
 
-    default:
-      caret.setError("[oatpp::mongo::bson::mapping::Deserializer::skipElement()]: Error. Unknown element type-code.");
-      return;
+void Deserializer::setDeserializerMethod(const data::type::ClassId& classId, DeserializerMethod method) {
+  checkNotFrozen("setDeserializerMethod");
+  const v_uint32 id = classId.id;
+  if(id >= m_methods.size()) {
+    m_methods.resize(id + 1, nullptr);
   }
+  m_methods[id] = method;
+  std::lock_guard<std::mutex> lock(m_plansMutex);
+  m_plans.clear(); // plans refer to methods
+  m_version ++;
+}
 
+void Deserializer::setDeserializerIntoMethod(const data::type::ClassId& classId, DeserializerIntoMethod method) {
+  checkNotFrozen("setDeserializerIntoMethod");
+  const v_uint32 id = classId.id;
+  if(id >= m_intoMethods.size()) {
+    m_intoMethods.resize(id + 1, nullptr);
+  }
+  m_intoMethods[id] = method;
 }
 
 const Type* Deserializer::guessType(v_char8 bsonTypeCode) {
@@ -144,24 +218,24 @@ const Type* Deserializer::guessType(v_char8 bsonTypeCode) {
     case TypeCode::STRING:              return String::Class::getType();
     case TypeCode::DOCUMENT_EMBEDDED:   return Fields<Any>::Class::getType();
     case TypeCode::DOCUMENT_ARRAY:      return List<Any>::Class::getType();
-    case TypeCode::BINARY:              return nullptr;
-    case TypeCode::UNDEFINED:           return nullptr;
+    case TypeCode::BINARY:              return Binary::Class::getType();
+    case TypeCode::UNDEFINED:           return RawValue::Class::getType();
     case TypeCode::OBJECT_ID:           return ObjectId::Class::getType();
     case TypeCode::BOOLEAN:             return Boolean::Class::getType();
-    case TypeCode::DATE_TIME:           return nullptr;
+    case TypeCode::DATE_TIME:           return DateTime::Class::getType();
     case TypeCode::NULL_VALUE:          return nullptr;
-    case TypeCode::REGEXP:              return nullptr;
-    case TypeCode::BD_POINTER:          return nullptr;
-    case TypeCode::JAVASCRIPT_CODE:     return nullptr;
-    case TypeCode::SYMBOL:              return nullptr;
-    case TypeCode::JAVASCRIPT_CODE_WS:  return nullptr;
+    case TypeCode::REGEXP:              return RawValue::Class::getType();
+    case TypeCode::BD_POINTER:          return RawValue::Class::getType();
+    case TypeCode::JAVASCRIPT_CODE:     return RawValue::Class::getType();
+    case TypeCode::SYMBOL:              return RawValue::Class::getType();
+    case TypeCode::JAVASCRIPT_CODE_WS:  return RawValue::Class::getType();
     case TypeCode::INT_32:              return Int32::Class::getType();
     case TypeCode::TIMESTAMP:           return UInt64::Class::getType();
     case TypeCode::INT_64:              return Int64::Class::getType();
-    case TypeCode::DECIMAL_128:         return nullptr;
+    case TypeCode::DECIMAL_128:         return Decimal128::Class::getType();
 
-    case TypeCode::MIN_KEY:             return nullptr;
-    case TypeCode::MAX_KEY:             return nullptr;
+    case TypeCode::MIN_KEY:             return RawValue::Class::getType();
+    case TypeCode::MAX_KEY:             return RawValue::Class::getType();
 
     default:
       return nullptr;
@@ -169,6 +243,40 @@ const Type* Deserializer::guessType(v_char8 bsonTypeCode) {
 
 }
 
+v_char8 Deserializer::getExpectedTypeCode(const Type* const type) {
+
+  /* type-codes written by Serializer */
+
+  const v_uint32 id = type->classId.id;
+
+  if(id == data::type::__class::String::CLASS_ID.id) return TypeCode::STRING;
+
+  if(id == data::type::__class::Int8::CLASS_ID.id) return TypeCode::INT_32;
+  if(id == data::type::__class::UInt8::CLASS_ID.id) return TypeCode::INT_32;
+  if(id == data::type::__class::Int16::CLASS_ID.id) return TypeCode::INT_32;
+  if(id == data::type::__class::UInt16::CLASS_ID.id) return TypeCode::INT_32;
+  if(id == data::type::__class::Int32::CLASS_ID.id) return TypeCode::INT_32;
+  if(id == data::type::__class::UInt32::CLASS_ID.id) return TypeCode::INT_64;
+  if(id == data::type::__class::Int64::CLASS_ID.id) return TypeCode::INT_64;
+  if(id == data::type::__class::UInt64::CLASS_ID.id) return TypeCode::TIMESTAMP;
+
+  if(id == data::type::__class::Float32::CLASS_ID.id) return TypeCode::DOUBLE;
+  if(id == data::type::__class::Float64::CLASS_ID.id) return TypeCode::DOUBLE;
+  if(id == data::type::__class::Boolean::CLASS_ID.id) return TypeCode::BOOLEAN;
+
+  if(id == oatpp::mongo::bson::__class::ObjectId::CLASS_ID.id) return TypeCode::OBJECT_ID;
+  if(id == oatpp::mongo::bson::__class::Binary::CLASS_ID.id) return TypeCode::BINARY;
+  if(id == oatpp::mongo::bson::__class::Decimal128::CLASS_ID.id) return TypeCode::DECIMAL_128;
+  if(id == oatpp::mongo::bson::__class::DateTime::CLASS_ID.id) return TypeCode::DATE_TIME;
+  if(id == oatpp::mongo::bson::__class::InlineDocument::CLASS_ID.id) return TypeCode::DOCUMENT_EMBEDDED;
+  if(id == oatpp::mongo::bson::__class::InlineArray::CLASS_ID.id) return TypeCode::DOCUMENT_ARRAY;
+  if(id == oatpp::mongo::bson::__class::Document::CLASS_ID.id) return TypeCode::DOCUMENT_EMBEDDED;
+  if(id == oatpp::mongo::bson::__class::JsonDocument::CLASS_ID.id) return TypeCode::DOCUMENT_EMBEDDED;
+
+  return 0;
+
+}
+
 oatpp::Void Deserializer::deserializeBoolean(Deserializer* deserializer,
                                              utils::parser::Caret& caret,
                                              const Type* const type,
@@ -200,6 +308,30 @@ oatpp::Void Deserializer::deserializeBoolean(Deserializer* deserializer,
 
 }
 
+oatpp::Void Deserializer::deserializeBooleanInto(Deserializer* deserializer,
+                                                 utils::parser::Caret& caret,
+                                                 const Type* const type,
+                                                 const oatpp::Void& target,
+                                                 v_char8 bsonTypeCode)
+{
+
+  if(bsonTypeCode != TypeCode::BOOLEAN) {
+    return deserializeBoolean(deserializer, caret, type, bsonTypeCode);
+  }
+
+  if(caret.canContinueAtChar(0, 1)) {
+    *static_cast<bool*>(target.get()) = false;
+    return target;
+  } else if(caret.canContinueAtChar(1, 1)) {
+    *static_cast<bool*>(target.get()) = true;
+    return target;
+  }
+
+  caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeBooleanInto()]: Error. Invalid boolean value.");
+  return oatpp::Void(Boolean::Class::getType());
+
+}
+
 oatpp::Void Deserializer::deserializeDateTime(Deserializer* deserializer,
                                               utils::parser::Caret& caret,
                                               const Type* const type,
@@ -223,6 +355,22 @@ oatpp::Void Deserializer::deserializeDateTime(Deserializer* deserializer,
   }
 }
 
+oatpp::Void Deserializer::deserializeDateTimeInto(Deserializer* deserializer,
+                                                  utils::parser::Caret& caret,
+                                                  const Type* const type,
+                                                  const oatpp::Void& target,
+                                                  v_char8 bsonTypeCode)
+{
+
+  if(bsonTypeCode != TypeCode::DATE_TIME) {
+    return deserializeDateTime(deserializer, caret, type, bsonTypeCode);
+  }
+
+  *static_cast<v_int64*>(target.get()) = Utils::readInt64(caret);
+  return target;
+
+}
+
 oatpp::Void Deserializer::deserializeString(Deserializer* deserializer,
                                             utils::parser::Caret& caret,
                                             const Type* const type,
@@ -257,6 +405,29 @@ oatpp::Void Deserializer::deserializeString(Deserializer* deserializer,
 
 }
 
+oatpp::Void Deserializer::deserializeStringInto(Deserializer* deserializer,
+                                                utils::parser::Caret& caret,
+                                                const Type* const type,
+                                                const oatpp::Void& target,
+                                                v_char8 bsonTypeCode)
+{
+
+  if(bsonTypeCode != TypeCode::STRING) {
+    return deserializeString(deserializer, caret, type, bsonTypeCode);
+  }
+
+  v_int32 size = Utils::readInt32(caret);
+  if (size + caret.getPosition() > caret.getDataSize() || size < 1) {
+    caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeStringInto()]: Error. Invalid string size.");
+    return nullptr;
+  }
+  auto label = caret.putLabel();
+  caret.inc(size);
+  static_cast<std::string*>(target.get())->assign(label.getData(), label.getSize() - 1);
+  return target;
+
+}
+
 oatpp::Void Deserializer::deserializeInlineDocs(Deserializer* deserializer,
                                                 utils::parser::Caret& caret,
                                                 const Type* const type,
@@ -283,11 +454,20 @@ oatpp::Void Deserializer::deserializeInlineDocs(Deserializer* deserializer,
       caret.inc(docSize - 4);
       label.end();
 
+      /* slice the source buffer if it's ref-counted, copy otherwise */
+      std::shared_ptr<std::string> memoryHandle = caret.getDataMemoryHandle();
+      std::shared_ptr<data::share::MemoryLabel> slice;
+      if(memoryHandle) {
+        slice = std::make_shared<data::share::MemoryLabel>(memoryHandle, label.getData(), label.getSize());
+      } else {
+        slice = std::make_shared<data::share::MemoryLabel>(std::make_shared<std::string>(label.getData(), label.getSize()));
+      }
+
       if(bsonTypeCode == DOCUMENT_ARRAY) {
-        return oatpp::Void(std::make_shared<std::string>(label.getData(), label.getSize()), InlineArray::Class::getType());
+        return oatpp::Void(slice, InlineArray::Class::getType());
       }
 
-      return oatpp::Void(std::make_shared<std::string>(label.getData(), label.getSize()), InlineDocument::Class::getType());
+      return oatpp::Void(slice, InlineDocument::Class::getType());
 
     }
 
@@ -331,6 +511,191 @@ oatpp::Void Deserializer::deserializeObjectId(Deserializer* deserializer,
 
 }
 
+oatpp::Void Deserializer::deserializeBinary(Deserializer* deserializer,
+                                            utils::parser::Caret& caret,
+                                            const Type* const type,
+                                            v_char8 bsonTypeCode)
+{
+
+  switch(bsonTypeCode) {
+
+    case TypeCode::NULL_VALUE:
+      return oatpp::Void(type);
+
+    case TypeCode::BINARY:
+    {
+
+      v_int32 size = Utils::readInt32(caret);
+      if (size < 0 || caret.getPosition() + 1 + size > caret.getDataSize()) {
+        caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeBinary()]: Error. Invalid binary size.");
+        return nullptr;
+      }
+
+      v_char8 subtype = *caret.getCurrData();
+      caret.inc();
+
+      auto label = caret.putLabel();
+      caret.inc(size);
+      label.end();
+
+      /* slice the source buffer if it's ref-counted, copy otherwise */
+      std::shared_ptr<std::string> memoryHandle = caret.getDataMemoryHandle();
+      std::shared_ptr<type::Binary> binary;
+      if(memoryHandle) {
+        binary = std::make_shared<type::Binary>(subtype, memoryHandle, label.getData(), label.getSize());
+      } else {
+        binary = std::make_shared<type::Binary>(subtype, data::share::MemoryLabel(std::make_shared<std::string>(label.getData(), label.getSize())));
+      }
+
+      return oatpp::Void(binary, Binary::Class::getType());
+
+    }
+
+    default:
+      caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeBinary()]: Error. Invalid type code.");
+      return nullptr;
+  }
+
+}
+
+oatpp::Void Deserializer::deserializeDecimal128(Deserializer* deserializer,
+                                                utils::parser::Caret& caret,
+                                                const Type* const type,
+                                                v_char8 bsonTypeCode)
+{
+
+  switch(bsonTypeCode) {
+
+    case TypeCode::NULL_VALUE:
+      return oatpp::Void(type);
+
+    case TypeCode::DECIMAL_128:
+    {
+
+      if(caret.getPosition() + type::Decimal128::DATA_SIZE > caret.getDataSize()) {
+        caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeDecimal128()]: Error. Invalid parsing state.");
+        return nullptr;
+      }
+
+      auto value = std::make_shared<type::Decimal128>(type::Decimal128::fromBytes(caret.getCurrData()));
+      caret.inc(type::Decimal128::DATA_SIZE);
+
+      return oatpp::Void(value, Decimal128::Class::getType());
+
+    }
+
+    default:
+      caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeDecimal128()]: Error. Invalid type code.");
+      return nullptr;
+  }
+
+}
+
+oatpp::Void Deserializer::deserializeRawValue(Deserializer* deserializer,
+                                              utils::parser::Caret& caret,
+                                              const Type* const type,
+                                              v_char8 bsonTypeCode)
+{
+
+  if(bsonTypeCode == TypeCode::NULL_VALUE) {
+    return oatpp::Void(type);
+  }
+
+  auto label = caret.putLabel();
+  Utils::skipElement(caret, bsonTypeCode);
+  if(caret.hasError()) {
+    return nullptr;
+  }
+  label.end();
+
+  /* slice the source buffer if it's ref-counted, copy otherwise */
+  std::shared_ptr<std::string> memoryHandle = caret.getDataMemoryHandle();
+  std::shared_ptr<type::RawValue> value;
+  if(memoryHandle) {
+    value = std::make_shared<type::RawValue>(bsonTypeCode, data::share::MemoryLabel(memoryHandle, label.getData(), label.getSize()));
+  } else {
+    value = std::make_shared<type::RawValue>(bsonTypeCode, data::share::MemoryLabel(std::make_shared<std::string>(label.getData(), label.getSize())));
+  }
+
+  return oatpp::Void(value, RawValue::Class::getType());
+
+}
+
+oatpp::Void Deserializer::deserializeDocument(Deserializer* deserializer,
+                                              utils::parser::Caret& caret,
+                                              const Type* const type,
+                                              v_char8 bsonTypeCode)
+{
+
+  switch(bsonTypeCode) {
+
+    case TypeCode::NULL_VALUE:
+      return oatpp::Void(type);
+
+    case TypeCode::DOCUMENT_ROOT:
+    case TypeCode::DOCUMENT_EMBEDDED:
+    {
+
+      auto label = caret.putLabel();
+
+      v_int32 docSize = Utils::readInt32(caret);
+      if (docSize - 4 + caret.getPosition() > caret.getDataSize() || docSize < 5) {
+        caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeDocument()]: Error. Invalid document size.");
+        return nullptr;
+      }
+
+      caret.inc(docSize - 4);
+      label.end();
+
+      /* slice the source buffer if it's ref-counted, copy otherwise */
+      std::shared_ptr<std::string> memoryHandle = caret.getDataMemoryHandle();
+      std::shared_ptr<type::Document> document;
+      if(memoryHandle) {
+        document = std::make_shared<type::Document>(data::share::MemoryLabel(memoryHandle, label.getData(), label.getSize()));
+      } else {
+        document = std::make_shared<type::Document>(std::make_shared<std::string>(label.getData(), label.getSize()));
+      }
+
+      return oatpp::Void(document, Document::Class::getType());
+
+    }
+
+    default:
+      caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeDocument()]: Error. Invalid type code.");
+      return nullptr;
+  }
+
+}
+
+oatpp::Void Deserializer::deserializeJsonDocument(Deserializer* deserializer,
+                                                  utils::parser::Caret& caret,
+                                                  const Type* const type,
+                                                  v_char8 bsonTypeCode)
+{
+
+  switch(bsonTypeCode) {
+
+    case TypeCode::NULL_VALUE:
+      return oatpp::Void(type);
+
+    case TypeCode::DOCUMENT_ROOT:
+    case TypeCode::DOCUMENT_EMBEDDED:
+    {
+      data::stream::BufferOutputStream stream;
+      json::BsonToJson::transcode(caret, &stream, deserializer->m_config->jsonOptions);
+      if(caret.hasError()) {
+        return nullptr;
+      }
+      return oatpp::Void(stream.toString().getPtr(), JsonDocument::Class::getType());
+    }
+
+    default:
+      caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeJsonDocument()]: Error. Invalid type code.");
+      return nullptr;
+  }
+
+}
+
 oatpp::Void Deserializer::deserializeAny(Deserializer* deserializer,
                                          utils::parser::Caret& caret,
                                          const Type* const type,
@@ -346,6 +711,9 @@ oatpp::Void Deserializer::deserializeAny(Deserializer* deserializer,
       return oatpp::Void(anyHandle, Any::Class::getType());
     }
 
+    caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeAny()]: Error. Unknown element type-code.");
+    return nullptr;
+
   }
 
   return oatpp::Void(Any::Class::getType());
@@ -390,269 +758,556 @@ oatpp::Void Deserializer::deserializeCollection(Deserializer* deserializer,
                                                 const Type* const type,
                                                 v_char8 bsonTypeCode)
 {
+  auto packedMethod = deserializer->getPackedMethod(type);
+  if(packedMethod) {
+    return packedMethod(deserializer, caret, type, bsonTypeCode);
+  }
+  return deserializer->readDocument(caret, FRAME_COLLECTION, type, nullptr, bsonTypeCode);
+}
 
-  switch(bsonTypeCode) {
+oatpp::Void Deserializer::deserializeCollectionInto(Deserializer* deserializer,
+                                                    utils::parser::Caret& caret,
+                                                    const Type* const type,
+                                                    const oatpp::Void& target,
+                                                    v_char8 bsonTypeCode)
+{
+  return deserializer->readDocument(caret, FRAME_COLLECTION, type, target, bsonTypeCode);
+}
 
-    case TypeCode::NULL_VALUE:
-      return oatpp::Void(type);
+oatpp::Void Deserializer::deserializeMap(Deserializer* deserializer,
+                                         utils::parser::Caret& caret,
+                                         const Type* const type,
+                                         v_char8 bsonTypeCode)
+{
+  return deserializer->readDocument(caret, FRAME_MAP, type, nullptr, bsonTypeCode);
+}
 
-    case TypeCode::DOCUMENT_ROOT:
-    case TypeCode::DOCUMENT_EMBEDDED:
-    case TypeCode::DOCUMENT_ARRAY:
-    {
+oatpp::Void Deserializer::deserializeObject(Deserializer* deserializer,
+                                            utils::parser::Caret& caret,
+                                            const Type* const type,
+                                            v_char8 bsonTypeCode)
+{
+  return deserializer->readDocument(caret, FRAME_OBJECT, type, nullptr, bsonTypeCode);
+}
 
-      v_int32 docSize = Utils::readInt32(caret);
-      if (docSize - 4 + caret.getPosition() > caret.getDataSize() || docSize < 4) {
-        caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeCollection()]: Error. Invalid document size.");
-        return nullptr;
-      }
+oatpp::Void Deserializer::deserializeObjectInto(Deserializer* deserializer,
+                                                utils::parser::Caret& caret,
+                                                const Type* const type,
+                                                const oatpp::Void& target,
+                                                v_char8 bsonTypeCode)
+{
+  return deserializer->readDocument(caret, FRAME_OBJECT, type, target, bsonTypeCode);
+}
 
-      utils::parser::Caret innerCaret(caret.getCurrData(), docSize - 4);
+oatpp::String Deserializer::internKey(KeyInternTable* table, const data::share::StringKeyLabel& key) {
 
-      auto dispatcher = static_cast<const data::type::__class::Collection::PolymorphicDispatcher*>(type->polymorphicDispatcher);
-      auto collection = dispatcher->createObject();
+  /*
+   * keys already interned by the shared table are served from the thread cache - the table is touched on a miss only.
+   * Generation is unique per table and per clear(), so the cache never serves keys of another table or of a cleared one.
+   */
 
-      const Type* itemType = dispatcher->getItemType();
-      v_int32 expectedIndex = 0;
-      while(innerCaret.canContinue() && innerCaret.getPosition() < innerCaret.getDataSize() - 1) {
+  Scratch& scratch = getScratch();
+  const v_uint64 generation = table->getGeneration();
+  if(scratch.keysGeneration != generation) {
+    scratch.keys.clear();
+    scratch.keysGeneration = generation;
+  }
 
-        v_char8 valueTypeCode;
-        auto key = Utils::readKey(innerCaret, valueTypeCode);
-        if(innerCaret.hasError()){
-          caret.inc(innerCaret.getPosition());
-          caret.setError(innerCaret.getErrorMessage(), innerCaret.getErrorCode());
-          return nullptr;
-        }
+  auto it = scratch.keys.find(key);
+  if(it != scratch.keys.end()) {
+    return it->second;
+  }
 
-        bool success;
-        v_int32 keyIntValue = utils::Conversion::strToInt32(key, success);
-        if(!success || keyIntValue != expectedIndex) {
-          caret.inc(innerCaret.getPosition());
-          caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeCollection()]: Error. Array invalid index value. Looks like it's not an array.");
-          return nullptr;
-        }
+  bool interned;
+  oatpp::String result = table->intern(key, interned);
+  if(interned && (v_int32) scratch.keys.size() < table->getMaxKeys()) {
+    scratch.keys.insert({data::share::StringKeyLabel(result.getPtr(), result->data(), result->size()), result});
+  }
 
-        auto item = deserializer->deserialize(innerCaret, itemType, valueTypeCode);
-        if(innerCaret.hasError()){
-          caret.inc(innerCaret.getPosition());
-          caret.setError(innerCaret.getErrorMessage(), innerCaret.getErrorCode());
-          return nullptr;
-        }
+  return result;
 
-        dispatcher->addItem(collection, item);
-        ++ expectedIndex;
+}
 
-      }
+bool Deserializer::isSoleOwner(const oatpp::Void& value) {
+  /* one reference is held by the parent container and one by the `value` copy */
+  return value && value.getPtr().use_count() <= 2;
+}
 
-      if(!innerCaret.canContinueAtChar(0, 1)){
-        caret.inc(innerCaret.getPosition());
-        if(innerCaret.hasError()) {
-          caret.setError(innerCaret.getErrorMessage(), innerCaret.getErrorCode());
-        } else {
-          caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeCollection()]: Error. '\\0' - expected");
-        }
-        return nullptr;
-      }
+bool Deserializer::getFrameType(const Type* const type, const oatpp::Void& target, v_char8 bsonTypeCode, Frame& frame) {
 
-      if(innerCaret.getPosition() != innerCaret.getDataSize()) {
-        caret.inc(innerCaret.getPosition());
-        caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeCollection()]: Error. Document parsing failed.");
-      }
+  if(bsonTypeCode != TypeCode::DOCUMENT_ROOT &&
+     bsonTypeCode != TypeCode::DOCUMENT_EMBEDDED &&
+     bsonTypeCode != TypeCode::DOCUMENT_ARRAY)
+  {
+    return false;
+  }
+
+  /* only built-in handlers are replaced by frames - custom methods are called as they are */
 
-      caret.inc(innerCaret.getPosition());
-      return collection;
+  const v_uint32 id = type->classId.id;
 
+  if(target && target.getValueType() == type && id < m_intoMethods.size() && m_intoMethods[id] != nullptr) {
+    auto intoMethod = m_intoMethods[id];
+    if(intoMethod == &Deserializer::deserializeObjectInto) {
+      frame.kind = FRAME_OBJECT;
+    } else if(intoMethod == &Deserializer::deserializeCollectionInto) {
+      frame.kind = FRAME_COLLECTION;
+    } else {
+      return false;
     }
+    frame.type = type;
+    frame.container = target;
+    frame.reused = true;
+    frame.wrapAny = false;
+    return true;
+  }
 
-    default:
-      caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeCollection()]: Error. Invalid type code.");
-      return nullptr;
+  auto method = id < m_methods.size() ? m_methods[id] : nullptr;
 
+  if(method == &Deserializer::deserializeObject) {
+    frame.kind = FRAME_OBJECT;
+  } else if(method == &Deserializer::deserializeCollection) {
+    if(getPackedMethod(type)) {
+      return false; // packed collection is read as a single value
+    }
+    frame.kind = FRAME_COLLECTION;
+  } else if(method == &Deserializer::deserializeMap) {
+    frame.kind = FRAME_MAP;
+  } else if(method == &Deserializer::deserializeAny) {
+    const Type* guessedType = guessType(bsonTypeCode);
+    if(guessedType != nullptr && getFrameType(guessedType, nullptr, bsonTypeCode, frame)) {
+      frame.wrapAny = true;
+      return true;
+    }
+    return false;
+  } else {
+    return false;
   }
 
+  frame.type = type;
+  frame.container = nullptr;
+  frame.reused = false;
+  frame.wrapAny = false;
+  return true;
+
 }
 
-oatpp::Void Deserializer::deserializeMap(Deserializer* deserializer,
-                                         utils::parser::Caret& caret,
-                                         const Type* const type,
-                                         v_char8 bsonTypeCode)
-{
+bool Deserializer::pushFrame(std::vector<Frame>& stack, utils::parser::Caret& caret, Frame& frame, v_int32 depth) {
 
-  switch(bsonTypeCode) {
+  if(depth + (v_int32) stack.size() >= m_config->maxDepth) {
+    caret.setError("[oatpp::mongo::bson::mapping::Deserializer::readDocument()]: Error. Max nesting depth exceeded.");
+    return false;
+  }
 
-    case TypeCode::NULL_VALUE:
-      return oatpp::Void(type);
+  v_int32 docSize = Utils::readInt32(caret);
+  if (docSize - 4 + caret.getPosition() > caret.getDataSize() || docSize < 5) {
+    caret.setError("[oatpp::mongo::bson::mapping::Deserializer::readDocument()]: Error. Invalid document size.");
+    return false;
+  }
 
-    case TypeCode::DOCUMENT_ROOT:
-    case TypeCode::DOCUMENT_EMBEDDED:
-    case TypeCode::DOCUMENT_ARRAY:
-    {
+  frame.docEnd = caret.getPosition() + docSize - 4;
+  frame.index = 0;
+  frame.itemType = nullptr;
+  frame.field = nullptr;
+  frame.step = nullptr;
 
-      v_int32 docSize = Utils::readInt32(caret);
-      if (docSize - 4 + caret.getPosition() > caret.getDataSize() || docSize < 4) {
-        caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeMap()]: Error. Invalid document size.");
-        return nullptr;
+  switch(frame.kind) {
+
+    case FRAME_OBJECT: {
+      if(!frame.reused) {
+        auto dispatcher = static_cast<const oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher*>(frame.type->polymorphicDispatcher);
+        frame.container = dispatcher->createObject();
+      }
+      if(m_config->useDecodePlans) {
+        frame.plan = getDecodePlan(frame.type);
+      }
+      break;
+    }
+
+    case FRAME_COLLECTION: {
+
+      auto dispatcher = static_cast<const data::type::__class::Collection::PolymorphicDispatcher*>(frame.type->polymorphicDispatcher);
+
+      /*
+       * collection dispatcher can't clear the container - so it is recreated, but its items are reused.
+       * Items of unordered sets are not reused - they may be modified while still hashed in the old set.
+       */
+      if(frame.reused && frame.type->classId.id != data::type::__class::AbstractUnorderedSet::CLASS_ID.id) {
+        frame.reusableItems.reserve(dispatcher->getCollectionSize(frame.container));
+        auto iterator = dispatcher->beginIteration(frame.container);
+        while (!iterator->finished()) {
+          auto item = iterator->get();
+          frame.reusableItems.push_back(isSoleOwner(item) ? item : nullptr);
+          iterator->next();
+        }
       }
 
-      utils::parser::Caret innerCaret(caret.getCurrData(), docSize - 4);
+      frame.container = dispatcher->createObject();
+      reserve(frame.type, frame.container, caret.getCurrData(), docSize - 4);
+      frame.itemType = dispatcher->getItemType();
+      break;
+
+    }
+
+    case FRAME_MAP: {
 
-      auto dispatcher = static_cast<const data::type::__class::Map::PolymorphicDispatcher*>(type->polymorphicDispatcher);
-      auto map = dispatcher->createObject();
+      auto dispatcher = static_cast<const data::type::__class::Map::PolymorphicDispatcher*>(frame.type->polymorphicDispatcher);
 
       const Type* keyType = dispatcher->getKeyType();
       if(keyType->classId.id != oatpp::data::type::__class::String::CLASS_ID.id){
         throw std::runtime_error("[oatpp::mongo::bson::mapping::Deserializer::deserializeMap()]: Invalid bson map key. Key should be String");
       }
 
-      const Type* valueType = dispatcher->getValueType();
-      while(innerCaret.canContinue() && innerCaret.getPosition() < innerCaret.getDataSize() - 1) {
+      frame.container = dispatcher->createObject();
+      reserve(frame.type, frame.container, caret.getCurrData(), docSize - 4);
+      frame.itemType = dispatcher->getValueType();
+      break;
 
-        v_char8 valueTypeCode;
-        auto key = Utils::readKey(innerCaret, valueTypeCode);
-        if(innerCaret.hasError()){
-          caret.inc(innerCaret.getPosition());
-          caret.setError(innerCaret.getErrorMessage(), innerCaret.getErrorCode());
-          return nullptr;
+    }
+
+  }
+
+  stack.push_back(std::move(frame));
+  return true;
+
+}
+
+bool Deserializer::readElement(utils::parser::Caret& caret,
+                               Frame& frame,
+                               v_char8& valueTypeCode,
+                               const Type*& valueType,
+                               oatpp::Void& valueTarget)
+{
+
+  valueType = nullptr;
+
+  switch(frame.kind) {
+
+    case FRAME_OBJECT: {
+
+      Property* field = nullptr;
+      bool polymorph = false;
+
+      if(frame.plan) {
+
+        auto key = Utils::readKeyLabel(caret, valueTypeCode);
+        if(caret.hasError()){
+          return false;
+        }
+
+        frame.step = findStep(frame, key);
+        if(frame.step) {
+          field = frame.step->field;
+          polymorph = frame.step->polymorph;
+        }
+
+      } else {
+
+        auto key = Utils::readKey(caret, valueTypeCode);
+        if(caret.hasError()){
+          return false;
         }
 
-        dispatcher->addItem(map, key, deserializer->deserialize(innerCaret, valueType, valueTypeCode));
+        auto dispatcher = static_cast<const oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher*>(frame.type->polymorphicDispatcher);
+        const auto& fieldsMap = dispatcher->getProperties()->getMap();
+
+        auto fieldIterator = fieldsMap.find(*key);
+        if(fieldIterator != fieldsMap.end()) {
+          field = fieldIterator->second;
+          polymorph = field->info.typeSelector && field->type == oatpp::Any::Class::getType();
+        }
 
       }
 
-      if(!innerCaret.canContinueAtChar(0, 1)){
-        caret.inc(innerCaret.getPosition());
-        if(innerCaret.hasError()) {
-          caret.setError(innerCaret.getErrorMessage(), innerCaret.getErrorCode());
-        } else {
-          caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeMap()]: Error. '\\0' - expected");
+      if(field != nullptr){
+
+        if(polymorph) {
+          auto position = caret.getPosition();
+          Utils::skipElement(caret, valueTypeCode);
+          PolymorphData polymorphData;
+          polymorphData.field = field;
+          polymorphData.position = position;
+          polymorphData.valueType = valueTypeCode;
+          frame.polymorphs.push_back(polymorphData); // store polymorphs for later processing.
+          return !caret.hasError();
         }
-        return nullptr;
+
+        frame.field = field;
+        valueType = field->type;
+        if(frame.reused) {
+          auto value = field->get(static_cast<oatpp::BaseObject*>(frame.container.get()));
+          if(isSoleOwner(value)) {
+            valueTarget = value;
+          }
+        }
+        return true;
+
       }
 
-      if(innerCaret.getPosition() != innerCaret.getDataSize()) {
-        caret.inc(innerCaret.getPosition());
-        caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeMap()]: Error. Document parsing failed.");
+      if (m_config->allowUnknownFields) {
+        Utils::skipElement(caret, valueTypeCode);
+        return !caret.hasError();
       }
 
-      caret.inc(innerCaret.getPosition());
-      return oatpp::Void(map.getPtr(), map.getValueType());
+      caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeObject()]: Error. Unknown field");
+      return false;
+
+    }
+
+    case FRAME_COLLECTION: {
+
+      bool keyMatch = true;
+      if(m_config->trustArrayKeys) {
+        Utils::skipKey(caret, valueTypeCode);
+      } else {
+        keyMatch = Utils::readArrayKey(caret, valueTypeCode, frame.index);
+      }
+
+      if(caret.hasError()){
+        return false;
+      }
+
+      if(!keyMatch) {
+        caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeCollection()]: Error. Array invalid index value. Looks like it's not an array.");
+        return false;
+      }
+
+      valueType = frame.itemType;
+      if(frame.index < (v_int32) frame.reusableItems.size()) {
+        valueTarget = frame.reusableItems[frame.index];
+      }
+      return true;
+
+    }
+
+    case FRAME_MAP: {
+
+      if(m_config->keyInternTable) {
+        auto key = Utils::readKeyLabel(caret, valueTypeCode);
+        if(caret.hasError()){
+          return false;
+        }
+        frame.key = internKey(m_config->keyInternTable.get(), key);
+      } else {
+        frame.key = Utils::readKey(caret, valueTypeCode);
+        if(caret.hasError()){
+          return false;
+        }
+      }
+
+      valueType = frame.itemType;
+      return true;
 
     }
 
-    default:
-      caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeMap()]: Error. Invalid type code.");
-      return nullptr;
   }
 
+  return false;
+
 }
 
-oatpp::Void Deserializer::deserializeObject(Deserializer* deserializer,
-                                            utils::parser::Caret& caret,
-                                            const Type* const type,
-                                            v_char8 bsonTypeCode)
-{
+void Deserializer::addValue(Frame& frame, const oatpp::Void& value) {
 
-  switch(bsonTypeCode) {
+  switch(frame.kind) {
 
-    case TypeCode::NULL_VALUE:
-      return oatpp::Void(type);
+    case FRAME_OBJECT:
+      frame.field->set(static_cast<oatpp::BaseObject*>(frame.container.get()), value);
+      break;
 
-    case TypeCode::DOCUMENT_ROOT:
-    case TypeCode::DOCUMENT_EMBEDDED:
-    case TypeCode::DOCUMENT_ARRAY:
-    {
+    case FRAME_COLLECTION: {
+      auto dispatcher = static_cast<const data::type::__class::Collection::PolymorphicDispatcher*>(frame.type->polymorphicDispatcher);
+      dispatcher->addItem(frame.container, value);
+      ++ frame.index;
+      break;
+    }
 
-      v_int32 docSize = Utils::readInt32(caret);
-      if (docSize - 4 + caret.getPosition() > caret.getDataSize() || docSize < 4) {
-        caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeObject()]: Error. Invalid document size.");
+    case FRAME_MAP: {
+      auto dispatcher = static_cast<const data::type::__class::Map::PolymorphicDispatcher*>(frame.type->polymorphicDispatcher);
+      dispatcher->addItem(frame.container, frame.key, value);
+      break;
+    }
+
+  }
+
+}
+
+oatpp::Void Deserializer::popValue(utils::parser::Caret& caret, Frame& frame, v_int32 depth) {
+
+  if(caret.getPosition() != frame.docEnd - 1) {
+    caret.setError("[oatpp::mongo::bson::mapping::Deserializer::readDocument()]: Error. Document parsing failed.");
+    return nullptr;
+  }
+
+  if(!caret.canContinueAtChar(0, 1)){
+    caret.setError("[oatpp::mongo::bson::mapping::Deserializer::readDocument()]: Error. '\\0' - expected");
+    return nullptr;
+  }
+
+  if(!frame.polymorphs.empty()) {
+
+    const v_buff_size objectEnd = caret.getPosition();
+    auto object = static_cast<oatpp::BaseObject*>(frame.container.get());
+
+    for(auto& p : frame.polymorphs) {
+      caret.setPosition(p.position);
+      auto selectedType = p.field->info.typeSelector->selectType(object);
+      auto value = readValue(caret, selectedType, nullptr, p.valueType, depth);
+      if(caret.hasError()) {
         return nullptr;
       }
+      oatpp::Any any(value);
+      p.field->set(object, oatpp::Void(any.getPtr(), p.field->type));
+    }
 
-      utils::parser::Caret innerCaret(caret.getCurrData(), docSize - 4);
+    caret.setPosition(objectEnd);
 
-      auto dispatcher = static_cast<const oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
-      auto object = dispatcher->createObject();
-      const auto& fieldsMap = dispatcher->getProperties()->getMap();
+  }
 
-      std::vector<PolymorphData> polymorphs;
-      while(innerCaret.canContinue() && innerCaret.getPosition() < innerCaret.getDataSize() - 1) {
+  if(frame.wrapAny) {
+    auto anyHandle = std::make_shared<data::type::AnyHandle>(frame.container.getPtr(), frame.container.getValueType());
+    return oatpp::Void(anyHandle, Any::Class::getType());
+  }
 
-        v_char8 valueType;
-        auto key = Utils::readKey(innerCaret, valueType);
-        if(innerCaret.hasError()){
-          caret.inc(innerCaret.getPosition());
-          caret.setError(innerCaret.getErrorMessage(), innerCaret.getErrorCode());
-          return nullptr;
-        }
+  return frame.container;
 
-        auto fieldIterator = fieldsMap.find(*key);
-        if(fieldIterator != fieldsMap.end()){
-
-          auto field = fieldIterator->second;
-          if(field->info.typeSelector && field->type == oatpp::Any::Class::getType()) {
-            auto label = innerCaret.putLabel();
-            skipElement(innerCaret, valueType);
-            if(innerCaret.hasError()){
-              caret.inc(innerCaret.getPosition());
-              caret.setError(innerCaret.getErrorMessage(), innerCaret.getErrorCode());
-              return nullptr;
-            }
-            PolymorphData polymorphData;
-            polymorphData.field = field;
-            polymorphData.unparsedData = label.toString();
-            polymorphData.valueType = valueType;
-            polymorphs.push_back(polymorphData); // store polymorphs for later processing.
-          } else {
-            field->set(static_cast<oatpp::BaseObject *>(object.get()),deserializer->deserialize(innerCaret, field->type, valueType));
-          }
+}
+
+oatpp::Void Deserializer::readValue(utils::parser::Caret& caret,
+                                    const Type* const type,
+                                    const oatpp::Void& target,
+                                    v_char8 bsonTypeCode,
+                                    v_int32 depth)
+{
+  Frame frame;
+  if(getFrameType(type, target, bsonTypeCode, frame)) {
+    return readDocument(caret, frame, depth);
+  }
+  if(target) {
+    return deserializeInto(caret, type, target, bsonTypeCode);
+  }
+  return deserialize(caret, type, bsonTypeCode);
+}
+
+oatpp::Void Deserializer::readDocument(utils::parser::Caret& caret, Frame& root, v_int32 depth) {
+
+  /* nested documents are read on the explicit stack - one frame per document, no recursion */
+
+  ScratchStack<std::vector<Frame>>::Guard stackGuard(getScratch().stacks);
+  std::vector<Frame>& stack = *stackGuard;
+  stack.reserve(16);
+
+  if(!pushFrame(stack, caret, root, depth)) {
+    return nullptr;
+  }
+
+  while(true) {
+
+    Frame& frame = stack.back();
+
+    if(caret.canContinue() && caret.getPosition() < frame.docEnd - 1) {
+
+      v_char8 valueTypeCode;
+      const Type* valueType;
+      oatpp::Void valueTarget;
+
+      if(!readElement(caret, frame, valueTypeCode, valueType, valueTarget)) {
+        return nullptr;
+      }
+
+      if(valueType == nullptr) {
+        continue; // element skipped
+      }
 
-        } else if (deserializer->getConfig()->allowUnknownFields) {
-          skipElement(innerCaret, valueType);
-          if(innerCaret.hasError()){
-            caret.inc(innerCaret.getPosition());
-            caret.setError(innerCaret.getErrorMessage(), innerCaret.getErrorCode());
+      oatpp::Void value;
+      Frame child;
+
+      const DecodeStep* step = frame.kind == FRAME_OBJECT ? frame.step : nullptr;
+      if(step != nullptr && step->typeCode == valueTypeCode && !valueTarget) {
+
+        /* decode plan - value of the expected type */
+
+        if(step->method != nullptr) {
+          value = step->method(this, caret, valueType, valueTypeCode);
+        } else {
+          child.kind = step->frameKind;
+          child.type = valueType;
+          child.reused = false;
+          child.wrapAny = false;
+          if(!pushFrame(stack, caret, child, depth)) {
             return nullptr;
           }
-        } else {
-          caret.inc(innerCaret.getPosition());
-          caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeObject()]: Error. Unknown field");
-          return nullptr;
+          continue;
         }
 
+      } else if(getFrameType(valueType, valueTarget, valueTypeCode, child)) {
+        if(!pushFrame(stack, caret, child, depth)) {
+          return nullptr;
+        }
+        continue;
+      } else if(valueTarget) {
+        value = deserializeInto(caret, valueType, valueTarget, valueTypeCode);
+      } else {
+        value = deserialize(caret, valueType, valueTypeCode);
       }
 
-      if(!innerCaret.canContinueAtChar(0, 1)){
-        caret.inc(innerCaret.getPosition());
-        if(innerCaret.hasError()) {
-          caret.setError(innerCaret.getErrorMessage(), innerCaret.getErrorCode());
-        } else {
-          caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeObject()]: Error. '\\0' - expected");
-        }
+      if(caret.hasError()) {
         return nullptr;
       }
 
-      if(innerCaret.getPosition() != innerCaret.getDataSize()) {
-        caret.inc(innerCaret.getPosition());
-        caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeObject()]: Error. Document parsing failed.");
-      }
+      addValue(frame, value);
+      continue;
 
-      caret.inc(innerCaret.getPosition());
+    }
 
-      for(auto& p : polymorphs) {
-        utils::parser::Caret polyCaret(p.unparsedData);
-        auto selectedType = p.field->info.typeSelector->selectType(static_cast<oatpp::BaseObject *>(object.get()));
-        auto value = deserializer->deserialize(polyCaret, selectedType, p.valueType);
-        oatpp::Any any(value);
-        p.field->set(static_cast<oatpp::BaseObject *>(object.get()), oatpp::Void(any.getPtr(), p.field->type));
-      }
+    if(caret.hasError()) {
+      return nullptr;
+    }
 
-      return object;
+    oatpp::Void value = popValue(caret, frame, depth + (v_int32) stack.size());
+    if(caret.hasError()) {
+      return nullptr;
+    }
 
+    stack.pop_back();
+    if(stack.empty()) {
+      return value;
+    }
+
+    addValue(stack.back(), value);
+
+  }
+
+}
+
+oatpp::Void Deserializer::readDocument(utils::parser::Caret& caret,
+                                       FrameKind kind,
+                                       const Type* const type,
+                                       const oatpp::Void& target,
+                                       v_char8 bsonTypeCode)
+{
+
+  switch(bsonTypeCode) {
+
+    case TypeCode::NULL_VALUE:
+      return oatpp::Void(type);
+
+    case TypeCode::DOCUMENT_ROOT:
+    case TypeCode::DOCUMENT_EMBEDDED:
+    case TypeCode::DOCUMENT_ARRAY:
+    {
+      Frame frame;
+      frame.kind = kind;
+      frame.type = type;
+      frame.container = target;
+      frame.reused = (bool) target;
+      frame.wrapAny = false;
+      return readDocument(caret, frame, 0);
     }
 
     default:
-      caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializeObject()]: Error. Invalid type code.");
+      caret.setError("[oatpp::mongo::bson::mapping::Deserializer::readDocument()]: Error. Invalid type code.");
       return nullptr;
+
   }
 
 }
@@ -675,6 +1330,151 @@ oatpp::Void Deserializer::deserialize(utils::parser::Caret& caret, const Type* c
   }
 }
 
+oatpp::Void Deserializer::deserializeInto(utils::parser::Caret& caret,
+                                          const Type* const type,
+                                          const oatpp::Void& target,
+                                          v_char8 bsonTypeCode)
+{
+
+  if(!target || bsonTypeCode == TypeCode::NULL_VALUE || target.getValueType() != type) {
+    return deserialize(caret, type, bsonTypeCode);
+  }
+
+  auto id = type->classId.id;
+  if(id < m_intoMethods.size()) {
+    auto& method = m_intoMethods[id];
+    if(method) {
+      return (*method)(this, caret, type, target, bsonTypeCode);
+    }
+  }
+
+  return deserialize(caret, type, bsonTypeCode);
+
+}
+
+std::shared_ptr<const Deserializer::DecodePlan> Deserializer::getDecodePlan(const Type* const type) {
+
+  /* plans are compiled once per deserializer and then looked up in the thread cache without locking */
+
+  Scratch& scratch = getScratch();
+
+  auto it = scratch.plans.find(type);
+  if(it != scratch.plans.end()) {
+    return it->second;
+  }
+
+  auto plan = getSharedDecodePlan(type);
+  scratch.plans[type] = plan;
+  return plan;
+
+}
+
+std::shared_ptr<const Deserializer::DecodePlan> Deserializer::getSharedDecodePlan(const Type* const type) {
+
+  std::lock_guard<std::mutex> lock(m_plansMutex);
+
+  auto it = m_plans.find(type);
+  if(it != m_plans.end()) {
+    return it->second;
+  }
+
+  auto plan = std::make_shared<DecodePlan>();
+
+  auto dispatcher = static_cast<const oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  const auto& properties = dispatcher->getProperties()->getList();
+
+  plan->steps.reserve(properties.size());
+
+  for(auto* property : properties) {
+
+    DecodeStep step;
+    step.key = property->name.data();
+    step.keySize = (v_buff_size) property->name.size();
+    step.field = property;
+    step.typeCode = 0;
+    step.method = nullptr;
+    step.frameKind = FRAME_OBJECT;
+    step.polymorph = property->info.typeSelector && property->type == oatpp::Any::Class::getType();
+
+    Frame frame;
+    if(getFrameType(property->type, nullptr, TypeCode::DOCUMENT_EMBEDDED, frame) && !frame.wrapAny) {
+      step.frameKind = frame.kind;
+      step.typeCode = (frame.kind == FRAME_COLLECTION) ? TypeCode::DOCUMENT_ARRAY : TypeCode::DOCUMENT_EMBEDDED;
+    } else {
+      const v_uint32 id = property->type->classId.id;
+      step.method = id < m_methods.size() ? m_methods[id] : nullptr;
+      if(step.method == &Deserializer::deserializeCollection && getPackedMethod(property->type)) {
+        step.method = getPackedMethod(property->type);
+        step.typeCode = TypeCode::DOCUMENT_ARRAY;
+      } else if(step.method != nullptr) {
+        step.typeCode = getExpectedTypeCode(property->type);
+      }
+    }
+
+    plan->indexes[data::share::StringKeyLabel(nullptr, step.key, step.keySize)] = (v_int32) plan->steps.size();
+    plan->steps.push_back(step);
+
+  }
+
+  m_plans[type] = plan;
+  return plan;
+
+}
+
+const Deserializer::DecodeStep* Deserializer::findStep(Frame& frame, const data::share::StringKeyLabel& key) {
+
+  const auto& steps = frame.plan->steps;
+
+  /* fields are expected in the order of declaration */
+  if(frame.index < (v_int32) steps.size()) {
+    const DecodeStep& step = steps[frame.index];
+    if(step.keySize == key.getSize() && std::memcmp(step.key, key.getData(), step.keySize) == 0) {
+      frame.index ++;
+      return &step;
+    }
+  }
+
+  auto it = frame.plan->indexes.find(key);
+  if(it != frame.plan->indexes.end()) {
+    frame.index = it->second + 1;
+    return &steps[it->second];
+  }
+
+  return nullptr;
+
+}
+
+void Deserializer::setReserveMethod(const Type* type, ReserveMethod method) {
+  checkNotFrozen("setReserveMethod");
+  m_reserveMethods[type] = method;
+}
+
+void Deserializer::setPackedMethod(const Type* type, DeserializerMethod method) {
+  checkNotFrozen("setPackedMethod");
+  m_packedMethods[type] = method;
+  std::lock_guard<std::mutex> lock(m_plansMutex);
+  m_plans.clear(); // plans refer to methods
+  m_version ++;
+}
+
+Deserializer::DeserializerMethod Deserializer::getPackedMethod(const Type* const type) {
+  auto it = m_packedMethods.find(type);
+  if(it != m_packedMethods.end()) {
+    return it->second;
+  }
+  return nullptr;
+}
+
+void Deserializer::reserve(const Type* type, const oatpp::Void& container, const char* data, v_buff_size size) {
+  auto it = m_reserveMethods.find(type);
+  if(it != m_reserveMethods.end() && it->second) {
+    v_int32 count = Utils::countElements(data, size);
+    if(count > 0) {
+      it->second(container, count);
+    }
+  }
+}
+
 const std::shared_ptr<Deserializer::Config>& Deserializer::getConfig() {
   return m_config;
 }
@@ -26,12 +26,20 @@
 #ifndef oatpp_mongo_bson_mapping_Deserializer_hpp
 #define oatpp_mongo_bson_mapping_Deserializer_hpp
 
+#include "./KeyInternTable.hpp"
+#include "./ThreadScratch.hpp"
+
+#include "oatpp-mongo/bson/json/BsonToJson.hpp"
 #include "oatpp-mongo/bson/Utils.hpp"
 
 #include "oatpp/utils/parser/Caret.hpp"
 #include "oatpp/utils/Conversion.hpp"
 #include "oatpp/Types.hpp"
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
 namespace oatpp { namespace mongo { namespace bson { namespace mapping {
 
 /**
@@ -75,23 +83,124 @@ public:
      */
     std::vector<std::string> enableInterpretations = {};
 
+    /**
+     * Do not check keys of array elements - just skip them. <br>
+     * Speeds up decoding of large arrays, but the order of array indexes is not validated.
+     * Enable only for trusted data.
+     */
+    bool trustArrayKeys = false;
+
+    /**
+     * Max nesting depth of documents. Deeper documents fail with error. <br>
+     * Nested documents are read on an explicit stack, so the limit doesn't depend on the thread stack size.
+     */
+    v_int32 maxDepth = 128;
+
+    /**
+     * Intern keys of maps (`Fields<Any>` of schemaless documents, etc.) - repeated keys share one string. <br>
+     * `nullptr` - interning is disabled. Interned keys are shared, don't modify them in place.
+     * See &id:oatpp::mongo::bson::mapping::KeyInternTable;.
+     */
+    std::shared_ptr<KeyInternTable> keyInternTable;
+
+    /**
+     * Decode DTO objects by per-class decode plans. <br>
+     * Plan is compiled on first use of the DTO class and cached by deserializer.
+     * Fields are matched in the order of declaration without allocating keys,
+     * and values of expected type-codes go directly to their deserializer methods.
+     * Unexpected keys and type-codes fall back to the generic path.
+     */
+    bool useDecodePlans = true;
+
+    /**
+     * Options of the BSON to JSON transcoder used for &id:oatpp::mongo::bson::JsonDocument; values.
+     */
+    json::BsonToJson::Options jsonOptions;
+
   };
 
 public:
   typedef oatpp::Void (*DeserializerMethod)(Deserializer*, utils::parser::Caret&, const Type* const, v_char8 bsonTypeCode);
+  typedef oatpp::Void (*DeserializerIntoMethod)(Deserializer*, utils::parser::Caret&, const Type* const, const oatpp::Void& target, v_char8 bsonTypeCode);
+  typedef void (*ReserveMethod)(const oatpp::Void& container, v_int32 size);
 private:
   struct PolymorphData {
     oatpp::BaseObject::Property* field;
-    oatpp::String unparsedData;
+    v_buff_size position;
     v_char8 valueType;
   };
 private:
-  static void skipCString(utils::parser::Caret& caret);
-  static void skipSizedElement(utils::parser::Caret& caret, v_int32 additionalBytes = 0);
-  static void skipElement(utils::parser::Caret& caret, v_char8 bsonTypeCode);
+
+  enum FrameKind : v_int32 {
+    FRAME_OBJECT,
+    FRAME_COLLECTION,
+    FRAME_MAP
+  };
+
+  /*
+   * Decode step of one DTO field.
+   */
+  struct DecodeStep {
+    const char* key;
+    v_buff_size keySize;
+    Property* field;
+    v_char8 typeCode;          // expected type-code. 0 - always use generic path.
+    DeserializerMethod method; // method for the leaf value. nullptr - value is read as a frame.
+    FrameKind frameKind;
+    bool polymorph;
+  };
+
+  /*
+   * Decode plan of the DTO class - steps in the order of fields declaration.
+   */
+  struct DecodePlan {
+    std::vector<DecodeStep> steps;
+    std::unordered_map<data::share::StringKeyLabel, v_int32> indexes; // labels point to names of the fields
+  };
+
+  /*
+   * One level of the document being read.
+   */
+  struct Frame {
+    FrameKind kind;
+    const Type* type;
+    oatpp::Void container;
+    bool reused;
+    bool wrapAny;
+    v_buff_size docEnd;
+    v_int32 index;
+    const Type* itemType;
+    std::vector<oatpp::Void> reusableItems;
+    std::vector<PolymorphData> polymorphs;
+    Property* field;
+    oatpp::String key;
+    std::shared_ptr<const DecodePlan> plan;
+    const DecodeStep* step;
+  };
+
+  /*
+   * Per-thread state of the deserializer - cache of decode plans, reusable frame stacks,
+   * and front cache of keys interned by `Config::keyInternTable`.
+   */
+  struct Scratch {
+    Scratch();
+    v_uint64 version;
+    std::unordered_map<const Type*, std::shared_ptr<const DecodePlan>> plans;
+    ScratchStack<std::vector<Frame>> stacks;
+    v_uint64 keysGeneration;
+    std::unordered_map<data::share::StringKeyLabel, oatpp::String> keys;
+  };
+
+private:
   static const Type* guessType(v_char8 bsonTypeCode);
+  static v_char8 getExpectedTypeCode(const Type* const type);
 private:
 
+  template<class Container>
+  static void reserveContainer(const oatpp::Void& container, v_int32 size) {
+    static_cast<typename Container::ObjectType*>(container.get())->reserve(size);
+  }
+
   template<class T>
   static oatpp::Void deserializePrimitive(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode){
 
@@ -108,6 +217,93 @@ private:
 
   }
 
+  template<class T>
+  static oatpp::Void deserializePrimitiveInto(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, const oatpp::Void& target, v_char8 bsonTypeCode){
+
+    (void) deserializer;
+    (void) type;
+
+    Utils::readPrimitive(caret, * static_cast<typename T::ObjectType*>(target.get()), bsonTypeCode);
+    return target;
+
+  }
+
+  template<class Collection>
+  static oatpp::Void deserializePacked(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode){
+
+    typedef typename Collection::ObjectType::value_type Item;
+    typedef typename Item::ObjectType Value;
+
+    switch(bsonTypeCode) {
+      case TypeCode::NULL_VALUE:
+        return oatpp::Void(type);
+      case TypeCode::DOCUMENT_ROOT:
+      case TypeCode::DOCUMENT_EMBEDDED:
+      case TypeCode::DOCUMENT_ARRAY:
+        break;
+      default:
+        caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializePacked()]: Error. Invalid type code.");
+        return nullptr;
+    }
+
+    v_int32 docSize = Utils::readInt32(caret);
+    if (docSize - 4 + caret.getPosition() > caret.getDataSize() || docSize < 5) {
+      caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializePacked()]: Error. Invalid document size.");
+      return nullptr;
+    }
+
+    const v_buff_size docEnd = caret.getPosition() + docSize - 4;
+    const bool trustArrayKeys = deserializer->m_config->trustArrayKeys;
+
+    auto collection = Collection::createShared();
+    deserializer->reserve(type, collection, caret.getCurrData(), docSize - 4);
+    auto& items = * collection;
+
+    /* items are read in a single loop - no per-item dispatch and no intermediate oatpp::Void */
+
+    v_int32 index = 0;
+    while(caret.canContinue() && caret.getPosition() < docEnd - 1) {
+
+      v_char8 itemTypeCode;
+      if(trustArrayKeys) {
+        Utils::skipKey(caret, itemTypeCode);
+      } else if(!Utils::readArrayKey(caret, itemTypeCode, index) && !caret.hasError()) {
+        caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializePacked()]: Error. Array invalid index value. Looks like it's not an array.");
+      }
+
+      if(caret.hasError()) {
+        return nullptr;
+      }
+
+      if(itemTypeCode == TypeCode::NULL_VALUE) {
+        items.push_back(nullptr);
+      } else {
+        Value value;
+        Utils::readPrimitive(caret, value, itemTypeCode);
+        if(caret.hasError()) {
+          return nullptr;
+        }
+        items.push_back(Item(value));
+      }
+
+      index ++;
+
+    }
+
+    if(caret.getPosition() != docEnd - 1) {
+      caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializePacked()]: Error. Document parsing failed.");
+      return nullptr;
+    }
+
+    if(!caret.canContinueAtChar(0, 1)){
+      caret.setError("[oatpp::mongo::bson::mapping::Deserializer::deserializePacked()]: Error. '\\0' - expected");
+      return nullptr;
+    }
+
+    return collection;
+
+  }
+
   static oatpp::Void deserializeBoolean(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode);
   static oatpp::Void deserializeDateTime(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode);
   static oatpp::Void deserializeString(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode);
@@ -115,6 +311,11 @@ private:
   static oatpp::Void deserializeInlineDocs(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode);
 
   static oatpp::Void deserializeObjectId(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode);
+  static oatpp::Void deserializeBinary(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode);
+  static oatpp::Void deserializeDecimal128(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode);
+  static oatpp::Void deserializeRawValue(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode);
+  static oatpp::Void deserializeDocument(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode);
+  static oatpp::Void deserializeJsonDocument(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode);
 
   static oatpp::Void deserializeAny(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode);
   static oatpp::Void deserializeEnum(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode);
@@ -123,9 +324,44 @@ private:
   static oatpp::Void deserializeMap(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode);
   static oatpp::Void deserializeObject(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode);
 
+  static oatpp::Void deserializeBooleanInto(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, const oatpp::Void& target, v_char8 bsonTypeCode);
+  static oatpp::Void deserializeDateTimeInto(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, const oatpp::Void& target, v_char8 bsonTypeCode);
+  static oatpp::Void deserializeStringInto(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, const oatpp::Void& target, v_char8 bsonTypeCode);
+
+  static oatpp::Void deserializeCollectionInto(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, const oatpp::Void& target, v_char8 bsonTypeCode);
+  static oatpp::Void deserializeObjectInto(Deserializer* deserializer, utils::parser::Caret& caret, const Type* const type, const oatpp::Void& target, v_char8 bsonTypeCode);
+
+
 private:
   std::shared_ptr<Config> m_config;
   std::vector<DeserializerMethod> m_methods;
+  std::vector<DeserializerIntoMethod> m_intoMethods;
+  std::unordered_map<const Type*, ReserveMethod> m_reserveMethods;
+  std::unordered_map<const Type*, DeserializerMethod> m_packedMethods;
+  std::mutex m_plansMutex;
+  std::unordered_map<const Type*, std::shared_ptr<const DecodePlan>> m_plans;
+  std::atomic<bool> m_frozen;
+  std::atomic<v_uint64> m_version;
+  ThreadScratch<Scratch> m_scratch;
+private:
+  static void clearStack(std::vector<Frame>& stack);
+  static bool isSoleOwner(const oatpp::Void& value);
+  oatpp::String internKey(KeyInternTable* table, const data::share::StringKeyLabel& key);
+  void checkNotFrozen(const char* methodName);
+  Scratch& getScratch();
+  void reserve(const Type* type, const oatpp::Void& container, const char* data, v_buff_size size);
+  DeserializerMethod getPackedMethod(const Type* const type);
+  std::shared_ptr<const DecodePlan> getDecodePlan(const Type* const type);
+  std::shared_ptr<const DecodePlan> getSharedDecodePlan(const Type* const type);
+  const DecodeStep* findStep(Frame& frame, const data::share::StringKeyLabel& key);
+  bool getFrameType(const Type* const type, const oatpp::Void& target, v_char8 bsonTypeCode, Frame& frame);
+  bool pushFrame(std::vector<Frame>& stack, utils::parser::Caret& caret, Frame& frame, v_int32 depth);
+  bool readElement(utils::parser::Caret& caret, Frame& frame, v_char8& valueTypeCode, const Type*& valueType, oatpp::Void& valueTarget);
+  void addValue(Frame& frame, const oatpp::Void& value);
+  oatpp::Void popValue(utils::parser::Caret& caret, Frame& frame, v_int32 depth);
+  oatpp::Void readValue(utils::parser::Caret& caret, const Type* const type, const oatpp::Void& target, v_char8 bsonTypeCode, v_int32 depth);
+  oatpp::Void readDocument(utils::parser::Caret& caret, Frame& root, v_int32 depth);
+  oatpp::Void readDocument(utils::parser::Caret& caret, FrameKind kind, const Type* const type, const oatpp::Void& target, v_char8 bsonTypeCode);
 public:
 
   /**
@@ -134,13 +370,74 @@ public:
    */
   Deserializer(const std::shared_ptr<Config>& config = std::make_shared<Config>());
 
+  /**
+   * Freeze configuration of the deserializer. <br>
+   * After this call methods can't be changed - setters throw, and the deserializer can be used by many threads at once.
+   * Method tables are read without locks, decode plans and frame stacks are cached per thread.
+   */
+  void freeze();
+
+  /**
+   * Check if configuration is frozen. See &l:Deserializer::freeze ();.
+   * @return
+   */
+  bool isFrozen() const;
+
   /**
    * Set deserializer method for type.
    * @param classId - &id:oatpp::data::type::ClassId;.
    * @param method - `typedef oatpp::Void (*DeserializerMethod)(Deserializer*, utils::parser::Caret&, const Type* const)`.
+   * @throws - `std::runtime_error` if deserializer is frozen.
    */
   void setDeserializerMethod(const data::type::ClassId& classId, DeserializerMethod method);
 
+  /**
+   * Set method to deserialize type into an existing object.
+   * @param classId - &id:oatpp::data::type::ClassId;.
+   * @param method - `typedef oatpp::Void (*DeserializerIntoMethod)(Deserializer*, utils::parser::Caret&, const Type* const, const oatpp::Void& target, v_char8 bsonTypeCode)`.
+   * @throws - `std::runtime_error` if deserializer is frozen.
+   */
+  void setDeserializerIntoMethod(const data::type::ClassId& classId, DeserializerIntoMethod method);
+
+  /**
+   * Set method to reserve capacity of the container before it's filled. <br>
+   * When set, the number of elements is counted with a quick key-skipping pass before deserializing the items.
+   * @param type - concrete container type. Ex.: `oatpp::Vector<oatpp::Int32>::Class::getType()`.
+   * @param method - `typedef void (*ReserveMethod)(const oatpp::Void& container, v_int32 size)`.
+   * @throws - `std::runtime_error` if deserializer is frozen.
+   */
+  void setReserveMethod(const Type* type, ReserveMethod method);
+
+  /**
+   * Enable capacity pre-sizing for the container type. <br>
+   * `Container::ObjectType` must have the `reserve()` method - ex.: `oatpp::Vector<T>`, `oatpp::UnorderedSet<T>`, `oatpp::UnorderedFields<T>`.
+   * @tparam Container - container type.
+   */
+  template<class Container>
+  void enableReserve() {
+    setReserveMethod(Container::Class::getType(), &Deserializer::reserveContainer<Container>);
+  }
+
+  /**
+   * Set method to deserialize the concrete collection type in one pass. <br>
+   * Takes precedence over the collection method set for the class id. Set `nullptr` to disable. <br>
+   * Not used when deserializing into an existing collection.
+   * @param type - concrete collection type. Ex.: `oatpp::Vector<oatpp::Int32>::Class::getType()`.
+   * @param method - `typedef oatpp::Void (*DeserializerMethod)(Deserializer*, utils::parser::Caret&, const Type* const, v_char8 bsonTypeCode)`.
+   * @throws - `std::runtime_error` if deserializer is frozen.
+   */
+  void setPackedMethod(const Type* type, DeserializerMethod method);
+
+  /**
+   * Enable packed deserialization for the collection of numeric primitives. <br>
+   * Items are read in a single loop - without per-item dispatch and boxing to `oatpp::Void`.
+   * @tparam Collection - collection type. Ex.: `oatpp::Vector<oatpp::Float32>`, `oatpp::List<oatpp::Int64>`.
+   */
+  template<class Collection>
+  void enablePacked() {
+    setPackedMethod(Collection::Class::getType(), &Deserializer::deserializePacked<Collection>);
+  }
+
   /**
    * Deserialize text.
    * @param caret - &id:oatpp::utils::parser::Caret;.
@@ -149,6 +446,21 @@ public:
    */
   oatpp::Void deserialize(utils::parser::Caret& caret, const Type* const type, v_char8 bsonTypeCode);
 
+  /**
+   * Deserialize into an existing object. <br>
+   * Values of the `target` are overwritten in place where possible: fields of DTOs, strings, primitives,
+   * and items of collections. Fields which are not present in bson keep their current values. <br>
+   * Nested value is reused only if its parent (DTO field or collection) is its only owner.
+   * Values shared with other objects are replaced with newly allocated ones. Items of unordered sets are never reused.
+   * If `target` is null or it's type doesn't match `type` - the new object is created.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   * @param type - &id:oatpp::data::type::Type;
+   * @param target - object to deserialize into.
+   * @param bsonTypeCode - type code of the bson element.
+   * @return - `oatpp::Void` over deserialized object. Same object as `target` if it was reused.
+   */
+  oatpp::Void deserializeInto(utils::parser::Caret& caret, const Type* const type, const oatpp::Void& target, v_char8 bsonTypeCode);
+
   /**
    * Get deserializer config.
    * @return
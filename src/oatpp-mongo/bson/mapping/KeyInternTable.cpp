@@ -0,0 +1,128 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "KeyInternTable.hpp"
+
+namespace oatpp { namespace mongo { namespace bson { namespace mapping {
+
+namespace {
+
+/* generations are unique across tables - a new table at the address of a destroyed one never repeats its generation */
+std::atomic<v_uint64> NEXT_GENERATION(1);
+
+v_uint64 nextGeneration() {
+  return NEXT_GENERATION.fetch_add(1, std::memory_order_relaxed);
+}
+
+}
+
+KeyInternTable::KeyInternTable(v_int32 maxKeys, v_buff_size maxKeySize)
+  : m_maxKeys(maxKeys)
+  , m_maxKeySize(maxKeySize)
+  , m_frozen(false)
+  , m_generation(nextGeneration())
+{}
+
+std::shared_ptr<KeyInternTable> KeyInternTable::createShared(v_int32 maxKeys, v_buff_size maxKeySize) {
+  return std::make_shared<KeyInternTable>(maxKeys, maxKeySize);
+}
+
+oatpp::String KeyInternTable::intern(const data::share::StringKeyLabel& key) {
+  bool interned;
+  return intern(key, interned);
+}
+
+oatpp::String KeyInternTable::intern(const data::share::StringKeyLabel& key, bool& interned) {
+
+  interned = false;
+
+  if(key.getSize() > m_maxKeySize || m_maxKeys <= 0) {
+    return key.toString();
+  }
+
+  /* frozen table is never modified - safe to read without the lock */
+  if(m_frozen.load(std::memory_order_acquire)) {
+    auto it = m_keys.find(key);
+    if(it != m_keys.end()) {
+      interned = true;
+      return it->second;
+    }
+    return key.toString();
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_keys.find(key);
+  if(it != m_keys.end()) {
+    interned = true;
+    return it->second;
+  }
+
+  oatpp::String result = key.toString();
+  if(!m_frozen.load(std::memory_order_relaxed) && (v_int32) m_keys.size() < m_maxKeys) {
+    /* table key points to the interned string itself */
+    m_keys.insert({data::share::StringKeyLabel(result.getPtr(), result->data(), result->size()), result});
+    interned = true;
+  }
+
+  return result;
+
+}
+
+v_int32 KeyInternTable::getMaxKeys() const {
+  return m_maxKeys;
+}
+
+void KeyInternTable::freeze() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_frozen.store(true, std::memory_order_release);
+}
+
+bool KeyInternTable::isFrozen() const {
+  return m_frozen.load(std::memory_order_acquire);
+}
+
+v_int32 KeyInternTable::getKeysCount() {
+  if(m_frozen.load(std::memory_order_acquire)) {
+    return (v_int32) m_keys.size();
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return (v_int32) m_keys.size();
+}
+
+v_uint64 KeyInternTable::getGeneration() const {
+  return m_generation.load(std::memory_order_acquire);
+}
+
+void KeyInternTable::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if(m_frozen.load(std::memory_order_relaxed)) {
+    throw std::runtime_error("[oatpp::mongo::bson::mapping::KeyInternTable::clear()]: Error. Table is frozen.");
+  }
+  m_keys.clear();
+  m_generation.store(nextGeneration(), std::memory_order_release);
+}
+
+}}}}
@@ -0,0 +1,130 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_mongo_bson_mapping_KeyInternTable_hpp
+#define oatpp_mongo_bson_mapping_KeyInternTable_hpp
+
+#include "oatpp/data/share/MemoryLabel.hpp"
+#include "oatpp/Types.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace oatpp { namespace mongo { namespace bson { namespace mapping {
+
+/**
+ * Bounded table of interned document keys. <br>
+ * Repeated keys of schemaless documents (`Fields<Any>` and other maps) share one `oatpp::String`
+ * instead of allocating a new string per key. <br>
+ * Once the table is full, or the key is too long, keys are allocated as usual. <br>
+ * Thread-safe. Can be shared by several deserializers, or created per batch and cleared between batches. <br>
+ * Lookups lock the table until it's frozen by &l:KeyInternTable::freeze ();.
+ * A frozen table is never modified again and lookups don't lock.
+ */
+class KeyInternTable {
+private:
+  v_int32 m_maxKeys;
+  v_buff_size m_maxKeySize;
+  std::mutex m_mutex;
+  std::atomic<bool> m_frozen;
+  std::atomic<v_uint64> m_generation;
+  std::unordered_map<data::share::StringKeyLabel, oatpp::String> m_keys;
+public:
+
+  /**
+   * Constructor.
+   * @param maxKeys - max number of keys in the table.
+   * @param maxKeySize - longer keys are not interned.
+   */
+  KeyInternTable(v_int32 maxKeys = 1024, v_buff_size maxKeySize = 64);
+
+  /**
+   * Create shared KeyInternTable.
+   * @param maxKeys - max number of keys in the table.
+   * @param maxKeySize - longer keys are not interned.
+   * @return - `std::shared_ptr` to KeyInternTable.
+   */
+  static std::shared_ptr<KeyInternTable> createShared(v_int32 maxKeys = 1024, v_buff_size maxKeySize = 64);
+
+  /**
+   * Get interned string for the key. Adds the key to the table if it's not there and the table is not full.
+   * @param key - key. May point to a temporary buffer - it's copied if needed.
+   * @return - `oatpp::String`.
+   */
+  oatpp::String intern(const data::share::StringKeyLabel& key);
+
+  /**
+   * Get interned string for the key. Adds the key to the table if it's not there and the table is not full.
+   * @param key - key. May point to a temporary buffer - it's copied if needed.
+   * @param interned - set to `true` if the result is the string stored in the table.
+   * @return - `oatpp::String`.
+   */
+  oatpp::String intern(const data::share::StringKeyLabel& key, bool& interned);
+
+  /**
+   * Get max number of keys in the table.
+   * @return
+   */
+  v_int32 getMaxKeys() const;
+
+  /**
+   * Stop adding new keys - the table becomes immutable and lookups don't lock anymore. <br>
+   * Call it after the warm-up, when the common keys are already in the table.
+   * A frozen table can't be cleared.
+   */
+  void freeze();
+
+  /**
+   * Check if the table is frozen.
+   * @return
+   */
+  bool isFrozen() const;
+
+  /**
+   * Get number of interned keys.
+   * @return
+   */
+  v_int32 getKeysCount();
+
+  /**
+   * Get generation of the table contents. <br>
+   * Unique across all tables of the process - changes when the table is cleared.
+   * Caches of interned keys check it to drop strings of the previous generation.
+   * @return
+   */
+  v_uint64 getGeneration() const;
+
+  /**
+   * Remove all keys from the table. The table may be full.
+   * @throws - `std::runtime_error` if the table is frozen.
+   */
+  void clear();
+
+};
+
+}}}}
+
+#endif // oatpp_mongo_bson_mapping_KeyInternTable_hpp
@@ -63,6 +63,22 @@ oatpp::Void ObjectMapper::read(oatpp::utils::parser::Caret& caret,
   return m_deserializer->deserialize(caret, type, TypeCode::DOCUMENT_ROOT);
 }
 
+oatpp::Void ObjectMapper::readInto(oatpp::utils::parser::Caret& caret, const oatpp::Void& object) const {
+  if(!object) {
+    throw std::runtime_error("[oatpp::mongo::bson::mapping::ObjectMapper::readInto()]: Error. Object is null.");
+  }
+  return m_deserializer->deserializeInto(caret, object.getValueType(), object, TypeCode::DOCUMENT_ROOT);
+}
+
+void ObjectMapper::freeze() {
+  m_serializer->freeze();
+  m_deserializer->freeze();
+}
+
+bool ObjectMapper::isFrozen() const {
+  return m_serializer->isFrozen() && m_deserializer->isFrozen();
+}
+
 std::shared_ptr<Serializer> ObjectMapper::getSerializer() {
   return m_serializer;
 }
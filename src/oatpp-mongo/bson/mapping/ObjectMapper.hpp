@@ -102,6 +102,51 @@ public:
    */
   oatpp::Void read(oatpp::utils::parser::Caret& caret, const oatpp::data::type::Type* const type, oatpp::data::mapping::ErrorStack& errorStack) const override;
 
+  /**
+   * Deserialize BSON document into an already allocated object. <br>
+   * DTO fields are overwritten in place, nested DTOs, strings and collection items are reused where possible. <br>
+   * Aliasing rule: `object` itself is always modified in place. A nested value is modified in place only if
+   * its DTO field or collection is its only owner (`use_count() == 1`), otherwise the new value is allocated
+   * and the shared one is left intact. Items of `UnorderedSet` are never reused.
+   * See &id:oatpp::mongo::bson::mapping::Deserializer::deserializeInto;.
+   * @param caret - &id:oatpp::utils::parser::Caret;.
+   * @param object - object to deserialize into. Must not be null.
+   * @return - &id:oatpp::Void; holding resultant object. Same as `object` for DTOs.
+   * @throws - `std::runtime_error` if `object` is null.
+   */
+  oatpp::Void readInto(oatpp::utils::parser::Caret& caret, const oatpp::Void& object) const;
+
+  /**
+   * Deserialize BSON document into an already allocated object.
+   * @tparam Wrapper - ObjectWrapper type.
+   * @param str - BSON document.
+   * @param object - object to deserialize into. Must not be null.
+   * @throws - `std::runtime_error` if `object` is null or on a parsing error.
+   */
+  template<class Wrapper>
+  void readInto(const oatpp::String& str, Wrapper& object) const {
+    oatpp::utils::parser::Caret caret(str);
+    auto result = readInto(caret, object);
+    if(caret.hasError()) {
+      throw std::runtime_error(std::string("[oatpp::mongo::bson::mapping::ObjectMapper::readInto()]: Error. ") + caret.getErrorMessage());
+    }
+    object = result.template cast<Wrapper>();
+  }
+
+
+  /**
+   * Freeze configuration of the serializer and deserializer. <br>
+   * Frozen mapper can be shared by all threads - method tables are read without locks,
+   * and scratch state (decode plans cache, frame stacks, buffers of nested documents) is attached to each thread lazily.
+   * See &id:oatpp::mongo::bson::mapping::Serializer::freeze;, &id:oatpp::mongo::bson::mapping::Deserializer::freeze;.
+   */
+  void freeze();
+
+  /**
+   * Check if both serializer and deserializer are frozen.
+   * @return
+   */
+  bool isFrozen() const;
 
   /**
    * Get serializer.
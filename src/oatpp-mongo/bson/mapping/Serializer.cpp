@@ -27,10 +27,19 @@
 
 #include "oatpp/utils/parser/Caret.hpp"
 
+#include <cstring>
+
 namespace oatpp { namespace mongo { namespace bson { namespace mapping {
 
+constexpr v_buff_size Serializer::SCRATCH_STREAM_MAX_CAPACITY;
+
+Serializer::Scratch::Scratch()
+  : streams(&Serializer::resetStream)
+{}
+
 Serializer::Serializer(const std::shared_ptr<Config>& config)
   : m_config(config)
+  , m_frozen(false)
 {
 
   m_methods.resize(data::type::ClassId::getClassCount(), nullptr);
@@ -74,12 +83,57 @@ Serializer::Serializer(const std::shared_ptr<Config>& config)
   setSerializerMethod(oatpp::mongo::bson::__class::InlineArray::CLASS_ID, &Serializer::serializeInlineArray);
 
   setSerializerMethod(oatpp::mongo::bson::__class::ObjectId::CLASS_ID, &Serializer::serializeObjectId);
+  setSerializerMethod(oatpp::mongo::bson::__class::Binary::CLASS_ID, &Serializer::serializeBinary);
+  setSerializerMethod(oatpp::mongo::bson::__class::Decimal128::CLASS_ID, &Serializer::serializeDecimal128);
+  setSerializerMethod(oatpp::mongo::bson::__class::RawValue::CLASS_ID, &Serializer::serializeRawValue);
+  setSerializerMethod(oatpp::mongo::bson::__class::Document::CLASS_ID, &Serializer::serializeDocument);
+  setSerializerMethod(oatpp::mongo::bson::__class::JsonDocument::CLASS_ID, &Serializer::serializeJsonDocument);
 
   setSerializerMethod(oatpp::mongo::bson::__class::DateTime::CLASS_ID, &Serializer::serializeDateTime);
 
+  //----------------
+  // Packed collections of numeric primitives
+
+  enablePacked<oatpp::Vector<oatpp::Int32>>();
+  enablePacked<oatpp::Vector<oatpp::Int64>>();
+  enablePacked<oatpp::Vector<oatpp::Float32>>();
+  enablePacked<oatpp::Vector<oatpp::Float64>>();
+
+  enablePacked<oatpp::List<oatpp::Int32>>();
+  enablePacked<oatpp::List<oatpp::Int64>>();
+  enablePacked<oatpp::List<oatpp::Float32>>();
+  enablePacked<oatpp::List<oatpp::Float64>>();
+
+}
+
+void Serializer::resetStream(data::stream::BufferOutputStream& stream) {
+  if(stream.getCapacity() > SCRATCH_STREAM_MAX_CAPACITY) {
+    stream.reset();
+  } else {
+    stream.setCurrentPosition(0);
+  }
+}
+
+void Serializer::checkNotFrozen(const char* methodName) {
+  if(m_frozen) {
+    throw std::runtime_error(std::string("[oatpp::mongo::bson::mapping::Serializer::") + methodName + "()]: Error. Serializer is frozen.");
+  }
+}
+
+Serializer::Scratch& Serializer::getScratch() {
+  return m_scratch.get();
+}
+
+void Serializer::freeze() {
+  m_frozen = true;
+}
+
+bool Serializer::isFrozen() const {
+  return m_frozen;
 }
 
 void Serializer::setSerializerMethod(const data::type::ClassId& classId, SerializerMethod method) {
+  checkNotFrozen("setSerializerMethod");
   const v_uint32 id = classId.id;
   if(id >= m_methods.size()) {
     m_methods.resize(id + 1, nullptr);
@@ -87,6 +141,53 @@ void Serializer::setSerializerMethod(const data::type::ClassId& classId, Seriali
   m_methods[id] = method;
 }
 
+void Serializer::setPackedMethod(const data::type::Type* type, SerializerMethod method) {
+  checkNotFrozen("setPackedMethod");
+  m_packedMethods[type] = method;
+}
+
+constexpr v_buff_size Serializer::PACKED_BUFFER_SIZE;
+constexpr v_buff_size Serializer::PACKED_ELEMENT_MAX_SIZE;
+
+Serializer::ArrayKey::ArrayKey()
+  : m_size(1)
+{
+  m_data[0] = '0';
+}
+
+data::share::StringKeyLabel Serializer::ArrayKey::getLabel() const {
+  return data::share::StringKeyLabel(nullptr, (const char*) m_data, m_size);
+}
+
+void Serializer::ArrayKey::next() {
+  v_buff_size i = m_size - 1;
+  while(i >= 0 && m_data[i] == '9') {
+    m_data[i] = '0';
+    i --;
+  }
+  if(i >= 0) {
+    m_data[i] ++;
+  } else {
+    std::memmove(m_data + 1, m_data, m_size);
+    m_data[0] = '1';
+    m_size ++;
+  }
+}
+
+v_buff_size Serializer::getArrayKeysSize(v_int32 count) {
+  v_buff_size result = 0;
+  v_int64 lower = 0;
+  v_int64 upper = 10;
+  v_buff_size digits = 1;
+  while(lower < count) {
+    result += ((upper < count ? upper : count) - lower) * digits;
+    lower = upper;
+    upper *= 10;
+    digits ++;
+  }
+  return result;
+}
+
 void Serializer::serializeDateTime(Serializer* serializer,
                                    data::stream::ConsistentOutputStream* stream,
                                    const data::share::StringKeyLabel& key,
@@ -144,20 +245,20 @@ void Serializer::serializeInlineDocs(Serializer* serializer,
 
   if(polymorph) {
 
-    auto str = static_cast<std::string*>(polymorph.get());
-    if(str->size() < 5) {
+    auto label = static_cast<data::share::MemoryLabel*>(polymorph.get());
+    if(label->getSize() < 5) {
       throw std::runtime_error("[oatpp::mongo::bson::mapping::Serializer::serializeInlineDocs()]: Error. Invalid inline object size.");
     }
 
-    oatpp::utils::parser::Caret caret(str->data(), str->size());
+    oatpp::utils::parser::Caret caret((const char*) label->getData(), label->getSize());
     v_int32 inlineSize = bson::Utils::readInt32(caret);
 
-    if(inlineSize != str->size()) {
+    if(inlineSize != label->getSize()) {
       throw std::runtime_error("[oatpp::mongo::bson::mapping::Serializer::serializeInlineDocs()]: Error. Invalid inline object.");
     }
 
     bson::Utils::writeKey(stream, typeCode, key);
-    stream->writeSimple(str->data(), str->size());
+    stream->writeSimple(label->getData(), label->getSize());
 
   } else if(key) {
     bson::Utils::writeKey(stream, TypeCode::NULL_VALUE, key);
@@ -205,6 +306,134 @@ void Serializer::serializeObjectId(Serializer* serializer,
   }
 }
 
+void Serializer::serializeBinary(Serializer* serializer,
+                                 data::stream::ConsistentOutputStream* stream,
+                                 const data::share::StringKeyLabel& key,
+                                 const oatpp::Void& polymorph)
+{
+  (void) serializer;
+
+  if(!key) {
+    throw std::runtime_error("[oatpp::mongo::bson::mapping::Serializer::serializeBinary()]: Error. The key can't be null.");
+  }
+
+  if(polymorph) {
+
+    auto binary = static_cast<bson::type::Binary*>(polymorph.get());
+
+    /* written straight from the binary's buffer */
+    bson::Utils::writeKey(stream, TypeCode::BINARY, key);
+    bson::Utils::writeInt32(stream, (v_int32) binary->getSize());
+    stream->writeCharSimple(binary->getSubtype());
+    if(binary->getSize() > 0) {
+      stream->writeSimple(binary->getData(), binary->getSize());
+    }
+
+  } else {
+    bson::Utils::writeKey(stream, TypeCode::NULL_VALUE, key);
+  }
+}
+
+void Serializer::serializeDecimal128(Serializer* serializer,
+                                     data::stream::ConsistentOutputStream* stream,
+                                     const data::share::StringKeyLabel& key,
+                                     const oatpp::Void& polymorph)
+{
+  (void) serializer;
+
+  if(!key) {
+    throw std::runtime_error("[oatpp::mongo::bson::mapping::Serializer::serializeDecimal128()]: Error. The key can't be null.");
+  }
+
+  if(polymorph) {
+
+    bson::Utils::writeKey(stream, TypeCode::DECIMAL_128, key);
+
+    v_char8 data[bson::type::Decimal128::DATA_SIZE];
+    static_cast<bson::type::Decimal128*>(polymorph.get())->toBytes(data);
+    stream->writeSimple(data, bson::type::Decimal128::DATA_SIZE);
+
+  } else {
+    bson::Utils::writeKey(stream, TypeCode::NULL_VALUE, key);
+  }
+}
+
+void Serializer::serializeRawValue(Serializer* serializer,
+                                   data::stream::ConsistentOutputStream* stream,
+                                   const data::share::StringKeyLabel& key,
+                                   const oatpp::Void& polymorph)
+{
+  (void) serializer;
+
+  if(!key) {
+    throw std::runtime_error("[oatpp::mongo::bson::mapping::Serializer::serializeRawValue()]: Error. The key can't be null.");
+  }
+
+  if(polymorph) {
+    auto value = static_cast<bson::type::RawValue*>(polymorph.get());
+    bson::Utils::writeKey(stream, (TypeCode) value->getTypeCode(), key);
+    stream->writeSimple(value->getData(), value->getSize());
+  } else {
+    bson::Utils::writeKey(stream, TypeCode::NULL_VALUE, key);
+  }
+}
+
+void Serializer::serializeDocument(Serializer* serializer,
+                                   data::stream::ConsistentOutputStream* stream,
+                                   const data::share::StringKeyLabel& key,
+                                   const oatpp::Void& polymorph)
+{
+  (void) serializer;
+
+  if(polymorph) {
+    auto document = static_cast<bson::type::Document*>(polymorph.get());
+    if(!document->isValid()) {
+      throw std::runtime_error("[oatpp::mongo::bson::mapping::Serializer::serializeDocument()]: Error. Invalid document.");
+    }
+    bson::Utils::writeKey(stream, TypeCode::DOCUMENT_EMBEDDED, key);
+    stream->writeSimple(document->getData(), document->getSize());
+  } else if(key) {
+    bson::Utils::writeKey(stream, TypeCode::NULL_VALUE, key);
+  } else {
+    throw std::runtime_error("[oatpp::mongo::bson::mapping::Serializer::serializeDocument()]: Error. null object with null key.");
+  }
+}
+
+void Serializer::serializeJsonDocument(Serializer* serializer,
+                                       data::stream::ConsistentOutputStream* stream,
+                                       const data::share::StringKeyLabel& key,
+                                       const oatpp::Void& polymorph)
+{
+
+  if(polymorph) {
+
+    auto json = static_cast<std::string*>(polymorph.get());
+
+    /* transcoded straight to the output stream in a single pass - no DTOs are created */
+    utils::parser::Caret caret(json->data(), (v_buff_size) json->size());
+    bson::Utils::writeKey(stream, TypeCode::DOCUMENT_EMBEDDED, key);
+    json::JsonToBson::transcode(caret, stream, serializer->m_config->jsonOptions);
+
+    if(!caret.hasError()) {
+      caret.skipBlankChars();
+      if(caret.canContinue()) {
+        caret.setError("[oatpp::mongo::bson::mapping::Serializer::serializeJsonDocument()]: Error. Unexpected data after the JSON object.");
+      }
+    }
+
+    if(caret.hasError()) {
+      throw std::runtime_error(std::string("[oatpp::mongo::bson::mapping::Serializer::serializeJsonDocument()]: "
+                                           "Error. Invalid JSON document. ") + caret.getErrorMessage());
+    }
+
+  } else if(key) {
+    bson::Utils::writeKey(stream, TypeCode::NULL_VALUE, key);
+  } else {
+    throw std::runtime_error("[oatpp::mongo::bson::mapping::Serializer::serializeJsonDocument()]: Error. null object with null key.");
+  }
+
+}
+
 void Serializer::serializeAny(Serializer* serializer,
                               data::stream::ConsistentOutputStream* stream,
                               const data::share::StringKeyLabel& key,
@@ -256,10 +485,17 @@ void Serializer::serializeCollection(Serializer* serializer,
                                      const oatpp::Void& polymorph)
 {
 
+  auto packed = serializer->m_packedMethods.find(polymorph.getValueType());
+  if(packed != serializer->m_packedMethods.end() && packed->second) {
+    packed->second(serializer, stream, key, polymorph);
+    return;
+  }
+
   if(polymorph) {
 
     bson::Utils::writeKey(stream, TypeCode::DOCUMENT_ARRAY, key);
-    data::stream::BufferOutputStream innerStream;
+    ScratchStack<data::stream::BufferOutputStream>::Guard innerStreamGuard(serializer->getScratch().streams);
+    data::stream::BufferOutputStream& innerStream = *innerStreamGuard;
 
     auto dispatcher = static_cast<const data::type::__class::Collection::PolymorphicDispatcher*>(polymorph.getValueType()->polymorphicDispatcher);
     v_int32 index = 0;
@@ -294,7 +530,8 @@ void Serializer::serializeMap(Serializer* serializer,
   if(polymorph) {
 
     bson::Utils::writeKey(stream, TypeCode::DOCUMENT_EMBEDDED, key);
-    data::stream::BufferOutputStream innerStream;
+    ScratchStack<data::stream::BufferOutputStream>::Guard innerStreamGuard(serializer->getScratch().streams);
+    data::stream::BufferOutputStream& innerStream = *innerStreamGuard;
 
     auto dispatcher = static_cast<const data::type::__class::Map::PolymorphicDispatcher*>(polymorph.getValueType()->polymorphicDispatcher);
 
@@ -330,7 +567,8 @@ void Serializer::serializeObject(Serializer* serializer,
 
     bson::Utils::writeKey(stream, TypeCode::DOCUMENT_EMBEDDED, key);
 
-    data::stream::BufferOutputStream innerStream;
+    ScratchStack<data::stream::BufferOutputStream>::Guard innerStreamGuard(serializer->getScratch().streams);
+    data::stream::BufferOutputStream& innerStream = *innerStreamGuard;
 
     auto dispatcher = static_cast<const oatpp::data::type::__class::AbstractObject::PolymorphicDispatcher*>(polymorph.getValueType()->polymorphicDispatcher);
     auto fields = dispatcher->getProperties()->getList();
@@ -26,6 +26,9 @@
 #ifndef oatpp_mongo_bson_mapping_Serializer_hpp
 #define oatpp_mongo_bson_mapping_Serializer_hpp
 
+#include "./ThreadScratch.hpp"
+
+#include "oatpp-mongo/bson/json/JsonToBson.hpp"
 #include "oatpp-mongo/bson/Utils.hpp"
 #include "oatpp-mongo/bson/Types.hpp"
 
@@ -34,6 +37,10 @@
 #include "oatpp/utils/Conversion.hpp"
 #include "oatpp/Types.hpp"
 
+#include <atomic>
+#include <unordered_map>
+#include <cstring>
+
 namespace oatpp { namespace mongo { namespace bson { namespace mapping {
 
 /**
@@ -83,6 +90,11 @@ public:
      */
     std::vector<std::string> enableInterpretations = {};
 
+    /**
+     * Options of the JSON to BSON transcoder used for &id:oatpp::mongo::bson::JsonDocument; values.
+     */
+    json::JsonToBson::Options jsonOptions;
+
   };
 public:
   typedef void (*SerializerMethod)(Serializer*,
@@ -110,6 +122,120 @@ private:
     }
   }
 
+  /**
+   * Decimal index key of the array item. Incremented in place - no string is allocated per item.
+   */
+  class ArrayKey {
+  private:
+    v_char8 m_data[16];
+    v_buff_size m_size;
+  public:
+    ArrayKey();
+    data::share::StringKeyLabel getLabel() const;
+    void next();
+
+    /* write element type-code and the key with its terminating `\0`. Returns number of bytes written */
+    v_buff_size writeElementKey(v_char8* buffer, v_char8 typeCode) const {
+      buffer[0] = typeCode;
+      std::memcpy(buffer + 1, m_data, m_size);
+      buffer[m_size + 1] = 0;
+      return m_size + 2;
+    }
+
+  };
+
+  static v_buff_size getArrayKeysSize(v_int32 count);
+
+  /*
+   * BSON representation of a packed numeric value - same as bson::Utils::writePrimitive().
+   * Int8 - Int32 are written as BSON Int32, UInt32 and Int64 as Int64, UInt64 as Timestamp, floats as Double.
+   */
+  template<typename Value>
+  struct PackedWire {
+
+    typedef typename std::conditional<std::is_floating_point<Value>::value, v_float64,
+            typename std::conditional<(sizeof(Value) < 4 || std::is_same<Value, v_int32>::value), v_int32,
+            typename std::conditional<std::is_same<Value, v_uint64>::value, v_uint64, v_int64>::type>::type>::type Type;
+
+    static v_char8 getTypeCode() {
+      if(std::is_floating_point<Value>::value) return TypeCode::DOUBLE;
+      if(std::is_same<Type, v_int32>::value) return TypeCode::INT_32;
+      if(std::is_same<Type, v_uint64>::value) return TypeCode::TIMESTAMP;
+      return TypeCode::INT_64;
+    }
+
+  };
+
+  /* stack buffer of the packed encoder. Elements are staged here and flushed with a single write */
+  static constexpr v_buff_size PACKED_BUFFER_SIZE = 4096;
+
+  /* max size of the packed element: type-code + 10 digits key + `\0` + 8 bytes value */
+  static constexpr v_buff_size PACKED_ELEMENT_MAX_SIZE = 20;
+
+  template<class Collection>
+  static void serializePacked(Serializer* serializer,
+                              data::stream::ConsistentOutputStream* stream,
+                              const data::share::StringKeyLabel& key,
+                              const oatpp::Void& polymorph)
+  {
+
+    typedef typename Collection::ObjectType::value_type Item;
+    typedef typename Item::ObjectType Value;
+
+    if(!polymorph) {
+      if(!key) {
+        throw std::runtime_error("[oatpp::mongo::bson::mapping::Serializer::serializePacked()]: Error. null object with null key.");
+      }
+      bson::Utils::writeKey(stream, TypeCode::NULL_VALUE, key);
+      return;
+    }
+
+    typedef typename PackedWire<Value>::Type Wire;
+    const v_char8 typeCode = PackedWire<Value>::getTypeCode();
+    const bool includeNulls = serializer->getConfig()->includeNullFields;
+    const auto& items = * static_cast<typename Collection::ObjectType*>(polymorph.get());
+
+    /* array size is known upfront - items are staged in the stack buffer and flushed in chunks */
+
+    v_int32 count = 0;
+    v_buff_size valuesSize = 0;
+    for(const auto& item : items) {
+      if(item) {
+        count ++;
+        valuesSize += sizeof(Wire);
+      } else if(includeNulls) {
+        count ++;
+      }
+    }
+
+    bson::Utils::writeKey(stream, TypeCode::DOCUMENT_ARRAY, key);
+    bson::Utils::writeInt32(stream, (v_int32) (4 + getArrayKeysSize(count) + 2 * count + valuesSize + 1));
+
+    v_char8 buffer[PACKED_BUFFER_SIZE];
+    v_buff_size size = 0;
+
+    ArrayKey index;
+    for(const auto& item : items) {
+      if(size + PACKED_ELEMENT_MAX_SIZE >= PACKED_BUFFER_SIZE) {
+        stream->writeSimple(buffer, size);
+        size = 0;
+      }
+      if(item) {
+        size += index.writeElementKey(buffer + size, typeCode);
+        bson::Utils::storeLE<Wire>(buffer + size, (Wire) * static_cast<Value*>(item.get()));
+        size += sizeof(Wire);
+        index.next();
+      } else if(includeNulls) {
+        size += index.writeElementKey(buffer + size, TypeCode::NULL_VALUE);
+        index.next();
+      }
+    }
+
+    buffer[size ++] = 0;
+    stream->writeSimple(buffer, size);
+
+  }
+
   static void serializeDateTime(Serializer* serializer,
                                 data::stream::ConsistentOutputStream* stream,
                                 const data::share::StringKeyLabel& key,
@@ -141,6 +267,31 @@ private:
                                 const data::share::StringKeyLabel& key,
                                 const oatpp::Void& polymorph);
 
+  static void serializeBinary(Serializer* serializer,
+                              data::stream::ConsistentOutputStream* stream,
+                              const data::share::StringKeyLabel& key,
+                              const oatpp::Void& polymorph);
+
+  static void serializeDecimal128(Serializer* serializer,
+                                  data::stream::ConsistentOutputStream* stream,
+                                  const data::share::StringKeyLabel& key,
+                                  const oatpp::Void& polymorph);
+
+  static void serializeRawValue(Serializer* serializer,
+                                data::stream::ConsistentOutputStream* stream,
+                                const data::share::StringKeyLabel& key,
+                                const oatpp::Void& polymorph);
+
+  static void serializeDocument(Serializer* serializer,
+                                data::stream::ConsistentOutputStream* stream,
+                                const data::share::StringKeyLabel& key,
+                                const oatpp::Void& polymorph);
+
+  static void serializeJsonDocument(Serializer* serializer,
+                                    data::stream::ConsistentOutputStream* stream,
+                                    const data::share::StringKeyLabel& key,
+                                    const oatpp::Void& polymorph);
+
   static void serializeAny(Serializer* serializer,
                            data::stream::ConsistentOutputStream* stream,
                            const data::share::StringKeyLabel& key,
@@ -170,9 +321,33 @@ private:
                  const data::share::StringKeyLabel& key,
                  const oatpp::Void& polymorph);
 
+public:
+
+  /**
+   * Scratch streams with larger capacity are shrunk when released.
+   */
+  static constexpr v_buff_size SCRATCH_STREAM_MAX_CAPACITY = 1024 * 1024;
+
+private:
+
+  /*
+   * Per-thread state of the serializer - reusable buffers of nested documents.
+   */
+  struct Scratch {
+    Scratch();
+    ScratchStack<data::stream::BufferOutputStream> streams;
+  };
+
+private:
+  static void resetStream(data::stream::BufferOutputStream& stream);
+  void checkNotFrozen(const char* methodName);
+  Scratch& getScratch();
 private:
   std::shared_ptr<Config> m_config;
   std::vector<SerializerMethod> m_methods;
+  std::unordered_map<const data::type::Type*, SerializerMethod> m_packedMethods;
+  std::atomic<bool> m_frozen;
+  ThreadScratch<Scratch> m_scratch;
 public:
 
   /**
@@ -181,13 +356,46 @@ public:
    */
   Serializer(const std::shared_ptr<Config>& config = std::make_shared<Config>());
 
+  /**
+   * Freeze configuration of the serializer. <br>
+   * After this call methods can't be changed - setters throw, and the serializer can be used by many threads at once.
+   * Method tables are read without locks, buffers of nested documents are reused per thread.
+   */
+  void freeze();
+
+  /**
+   * Check if configuration is frozen. See &l:Serializer::freeze ();.
+   * @return
+   */
+  bool isFrozen() const;
+
   /**
    * Set serializer method for type.
    * @param classId - &id:oatpp::data::type::ClassId;.
    * @param method - `typedef void (*SerializerMethod)(Serializer*, data::stream::ConsistentOutputStream*, const oatpp::Void&)`.
+   * @throws - `std::runtime_error` if serializer is frozen.
    */
   void setSerializerMethod(const data::type::ClassId& classId, SerializerMethod method);
 
+  /**
+   * Set method to serialize the concrete collection type in one pass. <br>
+   * Takes precedence over the collection method set for the class id. Set `nullptr` to disable.
+   * @param type - concrete collection type. Ex.: `oatpp::Vector<oatpp::Int32>::Class::getType()`.
+   * @param method - `typedef void (*SerializerMethod)(Serializer*, data::stream::ConsistentOutputStream*, const oatpp::Void&)`.
+   * @throws - `std::runtime_error` if serializer is frozen.
+   */
+  void setPackedMethod(const data::type::Type* type, SerializerMethod method);
+
+  /**
+   * Enable packed serialization for the collection of numeric primitives. <br>
+   * Items are written in a single loop - without per-item dispatch and index key strings.
+   * @tparam Collection - collection type. Ex.: `oatpp::Vector<oatpp::Float32>`, `oatpp::List<oatpp::Int64>`.
+   */
+  template<class Collection>
+  void enablePacked() {
+    setPackedMethod(Collection::Class::getType(), &Serializer::serializePacked<Collection>);
+  }
+
   /**
    * Serialize object to stream.
    * @param stream - &id:oatpp::data::stream::ConsistentOutputStream;.
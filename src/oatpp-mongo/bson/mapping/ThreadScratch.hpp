@@ -0,0 +1,215 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_mongo_bson_mapping_ThreadScratch_hpp
+#define oatpp_mongo_bson_mapping_ThreadScratch_hpp
+
+#include "oatpp/Types.hpp"
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace mongo { namespace bson { namespace mapping {
+
+/**
+ * Per-thread scratch state of an object shared between threads. <br>
+ * Every thread gets its own instance of `T` on the first access - the access path takes no locks. <br>
+ * Scratch of a destroyed owner is released when the thread switches to another owner, or on the thread exit.
+ * A thread that only ever uses one owner keeps the scratch of destroyed owners it used before until it exits.
+ * @tparam T - scratch type. Must be default-constructible.
+ */
+template<class T>
+class ThreadScratch {
+private:
+
+  struct Entry {
+    std::weak_ptr<void> owner;
+    std::shared_ptr<T> scratch;
+  };
+
+  struct Registry {
+
+    Registry()
+      : lastId(0)
+      , last(nullptr)
+    {}
+
+    v_uint64 lastId;
+    T* last;
+    std::unordered_map<v_uint64, Entry> entries;
+
+  };
+
+private:
+
+  static Registry& getRegistry() {
+    static thread_local Registry registry;
+    return registry;
+  }
+
+  static v_uint64 nextId() {
+    static std::atomic<v_uint64> counter(0);
+    return ++ counter;
+  }
+
+private:
+  /* ids are never reused, so a new owner never picks up scratch of the destroyed one */
+  std::shared_ptr<void> m_token;
+  v_uint64 m_id;
+public:
+
+  /**
+   * Constructor.
+   */
+  ThreadScratch()
+    : m_token(std::make_shared<v_uint64>(0))
+    , m_id(nextId())
+  {}
+
+  ThreadScratch(const ThreadScratch&) = delete;
+  ThreadScratch& operator=(const ThreadScratch&) = delete;
+
+  /**
+   * Get scratch of the calling thread. Created on the first call in the thread.
+   * @return - `T&`.
+   */
+  T& get() {
+
+    Registry& registry = getRegistry();
+    if(registry.lastId == m_id) {
+      return *registry.last;
+    }
+
+    /* slow path - the thread switches between owners. Release scratch of destroyed owners here */
+    for(auto e = registry.entries.begin(); e != registry.entries.end();) {
+      if(e->second.owner.expired()) {
+        e = registry.entries.erase(e);
+      } else {
+        ++ e;
+      }
+    }
+
+    auto it = registry.entries.find(m_id);
+    if(it == registry.entries.end()) {
+      Entry entry;
+      entry.owner = m_token;
+      entry.scratch = std::make_shared<T>();
+      it = registry.entries.insert({m_id, entry}).first;
+
+    }
+
+    registry.lastId = m_id;
+    registry.last = it->second.scratch.get();
+    return *registry.last;
+
+  }
+
+};
+
+/**
+ * Stack of reusable scratch objects. <br>
+ * Objects are acquired in LIFO order, so nested (re-entrant) calls get their own objects.
+ * The object is reset when released and keeps its allocated capacity for the next use.
+ * @tparam T - object type. Must be default-constructible.
+ */
+template<class T>
+class ScratchStack {
+public:
+  typedef void (*ResetMethod)(T&);
+private:
+  std::vector<std::unique_ptr<T>> m_items;
+  v_int32 m_used;
+  ResetMethod m_reset;
+public:
+
+  /**
+   * Scoped acquisition of the object. Releases the object in destructor.
+   */
+  class Guard {
+  private:
+    ScratchStack* m_stack;
+    T* m_item;
+  public:
+
+    Guard(ScratchStack& stack)
+      : m_stack(&stack)
+      , m_item(stack.acquire())
+    {}
+
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+    ~Guard() {
+      m_stack->release(*m_item);
+    }
+
+    T& operator*() const {
+      return *m_item;
+    }
+
+    T* operator->() const {
+      return m_item;
+    }
+
+  };
+
+public:
+
+  /**
+   * Constructor.
+   * @param reset - method to reset the object on release.
+   */
+  ScratchStack(ResetMethod reset)
+    : m_used(0)
+    , m_reset(reset)
+  {}
+
+  /**
+   * Acquire the object. Must be released by &l:ScratchStack::release (); in LIFO order.
+   * @return
+   */
+  T* acquire() {
+    if(m_used == (v_int32) m_items.size()) {
+      m_items.push_back(std::unique_ptr<T>(new T()));
+    }
+    return m_items[m_used ++].get();
+  }
+
+  /**
+   * Reset and release the last acquired object.
+   * @param item
+   */
+  void release(T& item) {
+    m_reset(item);
+    m_used --;
+  }
+
+};
+
+}}}}
+
+#endif // oatpp_mongo_bson_mapping_ThreadScratch_hpp
@@ -0,0 +1,167 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "Binary.hpp"
+
+#include "oatpp-mongo/bson/Utils.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace mongo { namespace bson { namespace type {
+
+void Binary::readValues(const char* data, v_buff_size count, v_int8* out) {
+  std::memcpy(out, data, count);
+}
+
+void Binary::readValues(const char* data, v_buff_size count, v_uint8* out) {
+  std::memcpy(out, data, count);
+}
+
+void Binary::readValues(const char* data, v_buff_size count, v_float32* out) {
+  Utils::loadLEArray<v_float32>(data, out, count);
+}
+
+Binary Binary::createVector(VectorDType dtype, v_char8 padding, const void* values, v_buff_size size) {
+  auto buffer = std::make_shared<std::string>(VECTOR_HEADER_SIZE + size, '\0');
+  char* data = &(*buffer)[0];
+  data[0] = (char) dtype;
+  data[1] = (char) padding;
+  if(dtype == VectorDType::FLOAT32) {
+    Utils::storeLEArray<v_float32>(data + VECTOR_HEADER_SIZE, (const v_float32*) values, size / 4);
+  } else if(size > 0) {
+    std::memcpy(data + VECTOR_HEADER_SIZE, values, size);
+  }
+  return Binary(Subtype::VECTOR, data::share::MemoryLabel(buffer));
+}
+
+Binary::Binary()
+  : m_subtype(Subtype::GENERIC)
+{}
+
+Binary::Binary(v_char8 subtype, const data::share::MemoryLabel& data)
+  : m_subtype(subtype)
+  , m_data(data)
+{}
+
+Binary::Binary(v_char8 subtype, const oatpp::String& buffer)
+  : m_subtype(subtype)
+  , m_data(buffer ? data::share::MemoryLabel(buffer.getPtr()) : data::share::MemoryLabel())
+{}
+
+Binary::Binary(v_char8 subtype, const std::shared_ptr<std::string>& memoryHandle, const void* data, v_buff_size size)
+  : m_subtype(subtype)
+  , m_data(memoryHandle, data, size)
+{}
+
+Binary Binary::createInt8Vector(const v_int8* values, v_buff_size count) {
+  return createVector(VectorDType::INT8, 0, values, count);
+}
+
+Binary Binary::createFloat32Vector(const v_float32* values, v_buff_size count) {
+  return createVector(VectorDType::FLOAT32, 0, values, count * 4);
+}
+
+Binary Binary::createPackedBitVector(const v_uint8* bytes, v_buff_size bitsCount) {
+  v_buff_size size = (bitsCount + 7) / 8;
+  return createVector(VectorDType::PACKED_BIT, (v_char8) (size * 8 - bitsCount), bytes, size);
+}
+
+v_char8 Binary::getSubtype() const {
+  return m_subtype;
+}
+
+const data::share::MemoryLabel& Binary::getLabel() const {
+  return m_data;
+}
+
+const char* Binary::getData() const {
+  return (const char*) m_data.getData();
+}
+
+v_buff_size Binary::getSize() const {
+  return m_data.getSize();
+}
+
+oatpp::String Binary::toString() const {
+  return m_data.toString();
+}
+
+bool Binary::isVector() const {
+
+  if(m_subtype != Subtype::VECTOR || m_data.getSize() < VECTOR_HEADER_SIZE) {
+    return false;
+  }
+
+  const char* data = getData();
+  v_buff_size size = m_data.getSize() - VECTOR_HEADER_SIZE;
+
+  switch((v_char8) data[0]) {
+    case VectorDType::INT8: return data[1] == 0;
+    case VectorDType::FLOAT32: return data[1] == 0 && size % 4 == 0;
+    case VectorDType::PACKED_BIT: return (v_char8) data[1] < 8 && (size > 0 || data[1] == 0);
+    default:
+      return false;
+  }
+
+}
+
+v_char8 Binary::getVectorDType() const {
+  return (v_char8) getData()[0];
+}
+
+v_char8 Binary::getVectorPadding() const {
+  return (v_char8) getData()[1];
+}
+
+Binary::VectorView<v_int8> Binary::asInt8Vector() const {
+  if(isVector() && getVectorDType() == VectorDType::INT8) {
+    return VectorView<v_int8>(getData() + VECTOR_HEADER_SIZE, getSize() - VECTOR_HEADER_SIZE);
+  }
+  return VectorView<v_int8>();
+}
+
+Binary::VectorView<v_float32> Binary::asFloat32Vector() const {
+  if(isVector() && getVectorDType() == VectorDType::FLOAT32) {
+    return VectorView<v_float32>(getData() + VECTOR_HEADER_SIZE, (getSize() - VECTOR_HEADER_SIZE) / 4);
+  }
+  return VectorView<v_float32>();
+}
+
+Binary::VectorView<v_uint8> Binary::asPackedBitVector() const {
+  if(isVector() && getVectorDType() == VectorDType::PACKED_BIT) {
+    return VectorView<v_uint8>(getData() + VECTOR_HEADER_SIZE, getSize() - VECTOR_HEADER_SIZE);
+  }
+  return VectorView<v_uint8>();
+}
+
+bool Binary::operator==(const Binary &other) const {
+  return m_subtype == other.m_subtype && m_data.equals(other.m_data.getData(), other.m_data.getSize());
+}
+
+bool Binary::operator!=(const Binary &other) const {
+  return !operator==(other);
+}
+
+}}}}
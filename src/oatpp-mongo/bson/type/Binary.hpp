@@ -0,0 +1,283 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_mongo_bson_type_Binary_hpp
+#define oatpp_mongo_bson_type_Binary_hpp
+
+#include "oatpp/data/share/MemoryLabel.hpp"
+#include "oatpp/Types.hpp"
+
+#include <vector>
+
+namespace oatpp { namespace mongo { namespace bson { namespace type {
+
+/**
+ * BSON Binary implementation - subtype plus ref-counted slice of the data. <br>
+ * The data is &id:oatpp::data::share::MemoryLabel;. On deserialization it slices the source buffer,
+ * on serialization it is written straight from the buffer - the bytes are never copied.
+ */
+class Binary : public oatpp::base::Countable {
+public:
+
+  /**
+   * Binary subtypes.
+   */
+  enum Subtype : v_char8 {
+    GENERIC = 0x00,
+    FUNCTION = 0x01,
+    BINARY_OLD = 0x02,
+    UUID_OLD = 0x03,
+    UUID = 0x04,
+    MD5 = 0x05,
+    ENCRYPTED = 0x06,
+    COMPRESSED = 0x07,
+    SENSITIVE = 0x08,
+    VECTOR = 0x09,
+    USER_DEFINED = 0x80
+  };
+
+  /**
+   * Element types of the &l:Binary::Subtype::VECTOR; subtype. <br>
+   * The vector data starts with two bytes - dtype and padding (count of unused bits in the last byte of PACKED_BIT vector).
+   */
+  enum VectorDType : v_char8 {
+    INT8 = 0x03,
+    FLOAT32 = 0x27,
+    PACKED_BIT = 0x10
+  };
+
+  /**
+   * Size of the vector header - dtype and padding.
+   */
+  static constexpr v_buff_size VECTOR_HEADER_SIZE = 2;
+
+  /**
+   * Typed non-owning view over the elements of the vector. <br>
+   * Elements are stored little-endian and may be unaligned - they are read by value.
+   * @tparam T - element type.
+   */
+  template<typename T>
+  class VectorView {
+  private:
+    const char* m_data;
+    v_buff_size m_size;
+  public:
+
+    VectorView()
+      : m_data(nullptr)
+      , m_size(0)
+    {}
+
+    VectorView(const char* data, v_buff_size size)
+      : m_data(data)
+      , m_size(size)
+    {}
+
+    /**
+     * Count of elements.
+     * @return
+     */
+    v_buff_size size() const {
+      return m_size;
+    }
+
+    /**
+     * Get element by index. Index is not checked.
+     * @param index
+     * @return
+     */
+    T operator[](v_buff_size index) const {
+      T result;
+      readValues(m_data + index * sizeof(T), 1, &result);
+      return result;
+    }
+
+    /**
+     * Copy all elements to the buffer of at least `size()` elements.
+     * @param out
+     */
+    void copyTo(T* out) const {
+      readValues(m_data, m_size, out);
+    }
+
+    /**
+     * Copy all elements to a new vector.
+     * @return
+     */
+    std::vector<T> toVector() const {
+      std::vector<T> result(m_size);
+      if(m_size > 0) {
+        readValues(m_data, m_size, result.data());
+      }
+      return result;
+    }
+
+    /**
+     * Check if the view is valid - `false` if the binary is not a vector of this type.
+     * @return
+     */
+    explicit operator bool() const {
+      return m_data != nullptr;
+    }
+
+  };
+
+private:
+  static void readValues(const char* data, v_buff_size count, v_int8* out);
+  static void readValues(const char* data, v_buff_size count, v_uint8* out);
+  static void readValues(const char* data, v_buff_size count, v_float32* out);
+  static Binary createVector(VectorDType dtype, v_char8 padding, const void* values, v_buff_size size);
+private:
+  v_char8 m_subtype;
+  data::share::MemoryLabel m_data;
+public:
+
+  /**
+   * Constructor. Empty binary of the generic subtype.
+   */
+  Binary();
+
+  /**
+   * Constructor.
+   * @param subtype - binary subtype. See &l:Binary::Subtype;.
+   * @param data - &id:oatpp::data::share::MemoryLabel;.
+   */
+  Binary(v_char8 subtype, const data::share::MemoryLabel& data);
+
+  /**
+   * Constructor. Wrap the whole buffer. The buffer is not copied.
+   * @param subtype - binary subtype. See &l:Binary::Subtype;.
+   * @param buffer - buffer holding the data. `nullptr` gives an empty binary.
+   */
+  Binary(v_char8 subtype, const oatpp::String& buffer);
+
+  /**
+   * Constructor. Wrap a slice of the buffer. The buffer is not copied. <br>
+   * `memoryHandle` may be `nullptr` - then the caller must keep the data alive while the Binary is used.
+   * @param subtype - binary subtype. See &l:Binary::Subtype;.
+   * @param memoryHandle - buffer holding the data.
+   * @param data - pointer to the data.
+   * @param size - size of the data.
+   */
+  Binary(v_char8 subtype, const std::shared_ptr<std::string>& memoryHandle, const void* data, v_buff_size size);
+
+  /**
+   * Create binary of &l:Binary::Subtype::VECTOR; subtype with INT8 elements.
+   * @param values
+   * @param count
+   * @return
+   */
+  static Binary createInt8Vector(const v_int8* values, v_buff_size count);
+
+  /**
+   * Create binary of &l:Binary::Subtype::VECTOR; subtype with FLOAT32 elements.
+   * @param values
+   * @param count
+   * @return
+   */
+  static Binary createFloat32Vector(const v_float32* values, v_buff_size count);
+
+  /**
+   * Create binary of &l:Binary::Subtype::VECTOR; subtype with PACKED_BIT elements.
+   * @param bytes - packed bits, the first element is the most significant bit of the first byte.
+   * @param bitsCount - count of bits.
+   * @return
+   */
+  static Binary createPackedBitVector(const v_uint8* bytes, v_buff_size bitsCount);
+
+  /**
+   * Get binary subtype.
+   * @return - See &l:Binary::Subtype;.
+   */
+  v_char8 getSubtype() const;
+
+  /**
+   * Get data label.
+   * @return - &id:oatpp::data::share::MemoryLabel;.
+   */
+  const data::share::MemoryLabel& getLabel() const;
+
+  /**
+   * Pointer to the data.
+   * @return
+   */
+  const char* getData() const;
+
+  /**
+   * Size of the data.
+   * @return
+   */
+  v_buff_size getSize() const;
+
+  /**
+   * Copy the data to a new string.
+   * @return
+   */
+  oatpp::String toString() const;
+
+  /**
+   * Check if binary is a well-formed vector - of &l:Binary::Subtype::VECTOR; subtype with a known dtype.
+   * @return
+   */
+  bool isVector() const;
+
+  /**
+   * Get vector dtype. Call only if &l:Binary::isVector (); is `true`.
+   * @return - See &l:Binary::VectorDType;.
+   */
+  v_char8 getVectorDType() const;
+
+  /**
+   * Get vector padding - count of unused bits in the last byte of PACKED_BIT vector.
+   * @return
+   */
+  v_char8 getVectorPadding() const;
+
+  /**
+   * View INT8 vector elements.
+   * @return - invalid view if binary is not an INT8 vector.
+   */
+  VectorView<v_int8> asInt8Vector() const;
+
+  /**
+   * View FLOAT32 vector elements.
+   * @return - invalid view if binary is not a FLOAT32 vector.
+   */
+  VectorView<v_float32> asFloat32Vector() const;
+
+  /**
+   * View bytes of PACKED_BIT vector. Use &l:Binary::getVectorPadding (); to get count of bits.
+   * @return - invalid view if binary is not a PACKED_BIT vector.
+   */
+  VectorView<v_uint8> asPackedBitVector() const;
+
+  bool operator==(const Binary &other) const;
+  bool operator!=(const Binary &other) const;
+
+};
+
+}}}}
+
+#endif // oatpp_mongo_bson_type_Binary_hpp
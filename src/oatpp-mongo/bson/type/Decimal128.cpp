@@ -0,0 +1,650 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "Decimal128.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace oatpp { namespace mongo { namespace bson { namespace type {
+
+namespace {
+
+const v_int32 EXPONENT_BIAS = 6176;
+
+/* 10^34 - 1 - max coefficient */
+const v_uint64 MAX_COEFFICIENT_HIGH = 0x1ed09bead87c0ULL;
+const v_uint64 MAX_COEFFICIENT_LOW = 0x378d8e63ffffffffULL;
+
+const v_uint64 POW10[20] = {
+  1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+  10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+  1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL,
+  10000000000000000000ULL
+};
+
+const v_float64 POW10_FLOAT[23] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* 128-bit coefficient as four 32-bit limbs - most significant first */
+struct Limbs {
+
+  v_uint32 data[4];
+
+  Limbs(v_uint64 high, v_uint64 low) {
+    data[0] = (v_uint32) (high >> 32);
+    data[1] = (v_uint32) high;
+    data[2] = (v_uint32) (low >> 32);
+    data[3] = (v_uint32) low;
+  }
+
+  bool isZero() const {
+    return (data[0] | data[1] | data[2] | data[3]) == 0;
+  }
+
+  v_uint32 divide(v_uint32 divisor) {
+    v_uint64 remainder = 0;
+    for(v_int32 i = 0; i < 4; i ++) {
+      v_uint64 current = (remainder << 32) | data[i];
+      data[i] = (v_uint32) (current / divisor);
+      remainder = current % divisor;
+    }
+    return (v_uint32) remainder;
+  }
+
+  v_uint64 getHigh() const {
+    return ((v_uint64) data[0] << 32) | data[1];
+  }
+
+  v_uint64 getLow() const {
+    return ((v_uint64) data[2] << 32) | data[3];
+  }
+
+};
+
+void multiplyAdd(v_uint64& high, v_uint64& low, v_uint32 multiplier, v_uint32 addend) {
+  v_uint64 lowLow = (low & 0xFFFFFFFF) * multiplier + addend;
+  v_uint64 lowHigh = (low >> 32) * multiplier + (lowLow >> 32);
+  low = (lowHigh << 32) | (lowLow & 0xFFFFFFFF);
+  high = high * multiplier + (lowHigh >> 32);
+}
+
+/* write coefficient digits to buffer of at least 36 chars, return count of digits */
+v_int32 writeDigits(v_uint64 high, v_uint64 low, char* buffer) {
+
+  if(high == 0) {
+    char tmp[20];
+    v_int32 count = 0;
+    do {
+      tmp[count ++] = (char) ('0' + low % 10);
+      low /= 10;
+    } while(low > 0);
+    for(v_int32 i = 0; i < count; i ++) {
+      buffer[i] = tmp[count - 1 - i];
+    }
+    return count;
+  }
+
+  /* 9 digits per division */
+  char tmp[36];
+  v_int32 count = 0;
+  Limbs limbs(high, low);
+  while(!limbs.isZero()) {
+    v_uint32 chunk = limbs.divide(1000000000);
+    for(v_int32 i = 0; i < 9; i ++) {
+      tmp[count ++] = (char) ('0' + chunk % 10);
+      chunk /= 10;
+    }
+  }
+  while(count > 1 && tmp[count - 1] == '0') {
+    count --;
+  }
+  for(v_int32 i = 0; i < count; i ++) {
+    buffer[i] = tmp[count - 1 - i];
+  }
+  return count;
+
+}
+
+bool equalsIgnoreCase(const char* data, v_buff_size size, const char* text) {
+  v_buff_size textSize = (v_buff_size) std::strlen(text);
+  if(size != textSize) {
+    return false;
+  }
+  for(v_buff_size i = 0; i < size; i ++) {
+    char c = data[i];
+    if(c >= 'A' && c <= 'Z') {
+      c = (char) (c - 'A' + 'a');
+    }
+    if(c != text[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+Decimal128 Decimal128::compose(bool negative, v_int32 exponent, v_uint64 coefficientHigh, v_uint64 coefficientLow) {
+  v_uint64 high = coefficientHigh & 0x1FFFFFFFFFFFFULL;
+  high |= (v_uint64) (exponent + EXPONENT_BIAS) << 49;
+  if(negative) {
+    high |= 0x8000000000000000ULL;
+  }
+  return Decimal128(high, coefficientLow);
+}
+
+void Decimal128::decompose(bool& negative, v_int32& exponent, v_uint64& coefficientHigh, v_uint64& coefficientLow) const {
+
+  negative = (m_high >> 63) != 0;
+
+  if(((m_high >> 61) & 3) == 3) {
+    /* coefficient doesn't fit 113 bits - non-canonical, treated as zero */
+    exponent = (v_int32) ((m_high >> 47) & 0x3FFF) - EXPONENT_BIAS;
+    coefficientHigh = 0;
+    coefficientLow = 0;
+    return;
+  }
+
+  exponent = (v_int32) ((m_high >> 49) & 0x3FFF) - EXPONENT_BIAS;
+  coefficientHigh = m_high & 0x1FFFFFFFFFFFFULL;
+  coefficientLow = m_low;
+
+  if(coefficientHigh > MAX_COEFFICIENT_HIGH || (coefficientHigh == MAX_COEFFICIENT_HIGH && coefficientLow > MAX_COEFFICIENT_LOW)) {
+    coefficientHigh = 0;
+    coefficientLow = 0;
+  }
+
+}
+
+Decimal128::Decimal128()
+  : m_low(0)
+  , m_high((v_uint64) EXPONENT_BIAS << 49)
+{}
+
+Decimal128::Decimal128(v_uint64 high, v_uint64 low)
+  : m_low(low)
+  , m_high(high)
+{}
+
+Decimal128 Decimal128::fromBytes(const void* data) {
+  const v_char8* bytes = (const v_char8*) data;
+  v_uint64 low = 0;
+  v_uint64 high = 0;
+  for(v_int32 i = 7; i >= 0; i --) {
+    low = (low << 8) | bytes[i];
+    high = (high << 8) | bytes[8 + i];
+  }
+  return Decimal128(high, low);
+}
+
+bool Decimal128::tryParse(const char* data, v_buff_size size, Decimal128& result) {
+
+  v_buff_size pos = 0;
+  bool negative = false;
+
+  if(pos < size && (data[pos] == '-' || data[pos] == '+')) {
+    negative = data[pos] == '-';
+    pos ++;
+  }
+
+  if(equalsIgnoreCase(data + pos, size - pos, "infinity") || equalsIgnoreCase(data + pos, size - pos, "inf")) {
+    result = infinity(negative);
+    return true;
+  }
+
+  if(equalsIgnoreCase(data + pos, size - pos, "nan")) {
+    result = nan();
+    return true;
+  }
+
+  v_uint64 high = 0;
+  v_uint64 low = 0;
+  v_int32 digits = 0;           // significant digits in coefficient
+  v_int32 fractionDigits = 0;   // digits after the point stored in coefficient
+  v_int32 droppedDigits = 0;    // trailing zeros of integer part which didn't fit the coefficient
+  bool hasDigits = false;
+  bool hasPoint = false;
+
+  for(; pos < size; pos ++) {
+
+    char c = data[pos];
+
+    if(c == '.') {
+      if(hasPoint) {
+        return false;
+      }
+      hasPoint = true;
+      continue;
+    }
+
+    if(c < '0' || c > '9') {
+      break;
+    }
+
+    hasDigits = true;
+
+    if(digits == MAX_DIGITS) {
+      if(c != '0') {
+        return false; // inexact
+      }
+      if(!hasPoint) {
+        droppedDigits ++;
+      }
+      continue;
+    }
+
+    if(digits > 0 || c != '0') {
+      multiplyAdd(high, low, 10, (v_uint32) (c - '0'));
+      digits ++;
+    }
+
+    if(hasPoint) {
+      fractionDigits ++;
+    }
+
+  }
+
+  if(!hasDigits) {
+    return false;
+  }
+
+  v_int64 exponent = 0;
+
+  if(pos < size && (data[pos] == 'e' || data[pos] == 'E')) {
+
+    pos ++;
+    bool negativeExponent = false;
+    if(pos < size && (data[pos] == '-' || data[pos] == '+')) {
+      negativeExponent = data[pos] == '-';
+      pos ++;
+    }
+
+    if(pos == size) {
+      return false;
+    }
+
+    for(; pos < size; pos ++) {
+      char c = data[pos];
+      if(c < '0' || c > '9') {
+        return false;
+      }
+      if(exponent < 100000) {
+        exponent = exponent * 10 + (c - '0');
+      }
+    }
+
+    if(negativeExponent) {
+      exponent = -exponent;
+    }
+
+  }
+
+  if(pos != size) {
+    return false;
+  }
+
+  exponent = exponent - fractionDigits + droppedDigits;
+
+  /* fit exponent into range - exactly, or fail */
+
+  const bool isZero = (high | low) == 0;
+
+  while(exponent > MAX_EXPONENT && !isZero && digits < MAX_DIGITS) {
+    multiplyAdd(high, low, 10, 0);
+    exponent --;
+    digits ++;
+  }
+
+  while(exponent < MIN_EXPONENT && !isZero) {
+    Limbs limbs(high, low);
+    if(limbs.divide(10) != 0) {
+      return false;
+    }
+    high = limbs.getHigh();
+    low = limbs.getLow();
+    exponent ++;
+  }
+
+  if(exponent > MAX_EXPONENT) {
+    if(!isZero) {
+      return false;
+    }
+    exponent = MAX_EXPONENT;
+  }
+
+  if(exponent < MIN_EXPONENT) {
+    exponent = MIN_EXPONENT;
+  }
+
+  result = compose(negative, (v_int32) exponent, high, low);
+  return true;
+
+}
+
+Decimal128 Decimal128::fromString(const oatpp::String& str) {
+  Decimal128 result;
+  if(!str || !tryParse(str->data(), (v_buff_size) str->size(), result)) {
+    throw std::runtime_error("[oatpp::mongo::bson::type::Decimal128::fromString()]: Error. Invalid decimal string.");
+  }
+  return result;
+}
+
+Decimal128 Decimal128::fromScaledInt64(v_int64 value, v_int32 scale) {
+
+  if(-scale < MIN_EXPONENT || -scale > MAX_EXPONENT) {
+    throw std::runtime_error("[oatpp::mongo::bson::type::Decimal128::fromScaledInt64()]: Error. Scale is out of range.");
+  }
+
+  bool negative = value < 0;
+  v_uint64 magnitude = negative ? (v_uint64) (-(value + 1)) + 1 : (v_uint64) value;
+  return compose(negative, -scale, 0, magnitude);
+
+}
+
+Decimal128 Decimal128::fromDouble(v_float64 value) {
+
+  if(std::isnan(value)) {
+    return nan();
+  }
+
+  if(std::isinf(value)) {
+    return infinity(value < 0);
+  }
+
+  /* shortest of 15, 16, 17 significant digits which round-trips */
+  char buffer[32];
+  for(v_int32 precision = 14; precision <= 16; precision ++) {
+    std::snprintf(buffer, sizeof(buffer), "%.*e", precision, value);
+    if(precision == 16 || std::strtod(buffer, nullptr) == value) {
+      break;
+    }
+  }
+
+  /* decimal point is locale-specific */
+  v_buff_size size = (v_buff_size) std::strlen(buffer);
+  for(v_buff_size i = 0; i < size; i ++) {
+    char c = buffer[i];
+    if(!((c >= '0' && c <= '9') || c == '-' || c == '+' || c == 'e')) {
+      buffer[i] = '.';
+    }
+  }
+
+  Decimal128 result;
+  tryParse(buffer, size, result);
+
+  /* strip trailing zeros of the coefficient - it has at most 17 digits */
+  bool negative;
+  v_int32 exponent;
+  v_uint64 high, low;
+  result.decompose(negative, exponent, high, low);
+  while(low != 0 && low % 10 == 0 && exponent < MAX_EXPONENT) {
+    low /= 10;
+    exponent ++;
+  }
+  if(low == 0) {
+    exponent = 0;
+  }
+
+  /* keep integers of up to 15 digits in plain notation */
+  if(exponent > 0) {
+    v_int32 digits = 0;
+    for(v_uint64 i = low; i > 0; i /= 10) {
+      digits ++;
+    }
+    if(digits + exponent <= 15) {
+      low *= POW10[exponent];
+      exponent = 0;
+    }
+  }
+
+  return compose(negative, exponent, high, low);
+
+}
+
+Decimal128 Decimal128::nan() {
+  return Decimal128(0x7C00000000000000ULL, 0);
+}
+
+Decimal128 Decimal128::infinity(bool negative) {
+  return Decimal128(negative ? 0xF800000000000000ULL : 0x7800000000000000ULL, 0);
+}
+
+v_uint64 Decimal128::getHigh() const {
+  return m_high;
+}
+
+v_uint64 Decimal128::getLow() const {
+  return m_low;
+}
+
+void Decimal128::toBytes(void* data) const {
+  v_char8* bytes = (v_char8*) data;
+  for(v_int32 i = 0; i < 8; i ++) {
+    bytes[i] = (v_char8) (m_low >> (i * 8));
+    bytes[8 + i] = (v_char8) (m_high >> (i * 8));
+  }
+}
+
+bool Decimal128::isNaN() const {
+  return ((m_high >> 58) & 0x1F) == 0x1F;
+}
+
+bool Decimal128::isInfinite() const {
+  return ((m_high >> 58) & 0x1F) == 0x1E;
+}
+
+bool Decimal128::isNegative() const {
+  return (m_high >> 63) != 0;
+}
+
+bool Decimal128::toScaledInt64(v_int32 scale, v_int64& result) const {
+
+  if(isNaN() || isInfinite()) {
+    return false;
+  }
+
+  bool negative;
+  v_int32 exponent;
+  v_uint64 high, low;
+  decompose(negative, exponent, high, low);
+
+  if((high | low) == 0) {
+    result = 0;
+    return true;
+  }
+
+  v_int64 shift = (v_int64) exponent + scale;
+
+  /* drop fraction digits - they must be zeros */
+  if(shift < 0) {
+
+    if(shift < -MAX_DIGITS) {
+      return false;
+    }
+
+    if(high == 0 && shift >= -19) {
+      v_uint64 divisor = POW10[-shift];
+      if(low % divisor != 0) {
+        return false;
+      }
+      low /= divisor;
+    } else {
+      Limbs limbs(high, low);
+      v_int64 count = -shift;
+      while(count > 0) {
+        v_int32 step = count > 9 ? 9 : (v_int32) count;
+        if(limbs.divide((v_uint32) POW10[step]) != 0) {
+          return false;
+        }
+        count -= step;
+      }
+      high = limbs.getHigh();
+      low = limbs.getLow();
+    }
+
+    shift = 0;
+
+  }
+
+  if(high != 0) {
+    return false;
+  }
+
+  const v_uint64 limit = negative ? 0x8000000000000000ULL : 0x7FFFFFFFFFFFFFFFULL;
+
+  if(shift > 19) {
+    return false;
+  }
+
+  if(shift > 0) {
+    v_uint64 multiplier = POW10[shift];
+    if(low > limit / multiplier) {
+      return false;
+    }
+    low *= multiplier;
+  }
+
+  if(low > limit) {
+    return false;
+  }
+
+  result = negative ? (v_int64) (~low + 1) : (v_int64) low;
+  return true;
+
+}
+
+v_float64 Decimal128::toDouble() const {
+
+  if(isNaN()) {
+    return std::numeric_limits<v_float64>::quiet_NaN();
+  }
+
+  if(isInfinite()) {
+    return isNegative() ? -std::numeric_limits<v_float64>::infinity() : std::numeric_limits<v_float64>::infinity();
+  }
+
+  bool negative;
+  v_int32 exponent;
+  v_uint64 high, low;
+  decompose(negative, exponent, high, low);
+
+  v_float64 result;
+
+  if(high == 0 && low <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+    /* both coefficient and power of ten are exact doubles - single rounding */
+    result = (v_float64) low;
+    if(exponent >= 0) {
+      result *= POW10_FLOAT[exponent];
+    } else {
+      result /= POW10_FLOAT[-exponent];
+    }
+  } else {
+    /* no decimal point in the string - not affected by locale */
+    char buffer[48];
+    v_int32 count = writeDigits(high, low, buffer);
+    std::snprintf(buffer + count, sizeof(buffer) - count, "e%d", exponent);
+    result = std::strtod(buffer, nullptr);
+  }
+
+  return negative ? -result : result;
+
+}
+
+oatpp::String Decimal128::toString() const {
+
+  if(isNaN()) {
+    return "NaN";
+  }
+
+  if(isInfinite()) {
+    return isNegative() ? "-Infinity" : "Infinity";
+  }
+
+  bool negative;
+  v_int32 exponent;
+  v_uint64 high, low;
+  decompose(negative, exponent, high, low);
+
+  char digits[36];
+  v_int32 count = writeDigits(high, low, digits);
+  v_int32 adjustedExponent = exponent + count - 1;
+
+  std::string result;
+  result.reserve(48);
+
+  if(negative) {
+    result.push_back('-');
+  }
+
+  if(exponent <= 0 && adjustedExponent >= -6) {
+
+    if(exponent == 0) {
+      result.append(digits, count);
+    } else {
+      v_int32 pointPosition = count + exponent;
+      if(pointPosition > 0) {
+        result.append(digits, pointPosition);
+        result.push_back('.');
+        result.append(digits + pointPosition, count - pointPosition);
+      } else {
+        result.append("0.");
+        result.append(-pointPosition, '0');
+        result.append(digits, count);
+      }
+    }
+
+  } else {
+
+    result.push_back(digits[0]);
+    if(count > 1) {
+      result.push_back('.');
+      result.append(digits + 1, count - 1);
+    }
+    result.push_back('E');
+    result.push_back(adjustedExponent < 0 ? '-' : '+');
+    result.append(std::to_string(adjustedExponent < 0 ? -adjustedExponent : adjustedExponent));
+
+  }
+
+  return oatpp::String(result.data(), (v_buff_size) result.size());
+
+}
+
+bool Decimal128::operator==(const Decimal128 &other) const {
+  return m_high == other.m_high && m_low == other.m_low;
+}
+
+bool Decimal128::operator!=(const Decimal128 &other) const {
+  return !operator==(other);
+}
+
+}}}}
@@ -0,0 +1,188 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_mongo_bson_type_Decimal128_hpp
+#define oatpp_mongo_bson_type_Decimal128_hpp
+
+#include "oatpp/Types.hpp"
+
+namespace oatpp { namespace mongo { namespace bson { namespace type {
+
+/**
+ * BSON Decimal128 implementation - IEEE 754-2008 128-bit decimal, binary integer decimal (BID) encoding. <br>
+ * Value is `(-1)^sign * coefficient * 10^exponent`, where coefficient has up to 34 decimal digits
+ * and exponent is in range [-6176, 6111]. <br>
+ * Conversions never go through a general purpose decimal library: string and scaled int64 conversions are exact,
+ * double conversions take the exact fast path when possible.
+ */
+class Decimal128 : public oatpp::base::Countable {
+public:
+
+  /**
+   * Size of Decimal128 data.
+   */
+  static constexpr v_buff_size DATA_SIZE = 16;
+
+  /**
+   * Max count of coefficient digits.
+   */
+  static constexpr v_int32 MAX_DIGITS = 34;
+
+  /**
+   * Min exponent.
+   */
+  static constexpr v_int32 MIN_EXPONENT = -6176;
+
+  /**
+   * Max exponent.
+   */
+  static constexpr v_int32 MAX_EXPONENT = 6111;
+
+private:
+  v_uint64 m_low;
+  v_uint64 m_high;
+private:
+  static Decimal128 compose(bool negative, v_int32 exponent, v_uint64 coefficientHigh, v_uint64 coefficientLow);
+  void decompose(bool& negative, v_int32& exponent, v_uint64& coefficientHigh, v_uint64& coefficientLow) const;
+public:
+
+  /**
+   * Constructor. Positive zero.
+   */
+  Decimal128();
+
+  /**
+   * Constructor.
+   * @param high - high 64 bits.
+   * @param low - low 64 bits.
+   */
+  Decimal128(v_uint64 high, v_uint64 low);
+
+  /**
+   * Create from 16 bytes of BSON value (little-endian).
+   * @param data
+   * @return
+   */
+  static Decimal128 fromBytes(const void* data);
+
+  /**
+   * Parse decimal string - `[+-]digits[.digits][(e|E)[+-]digits]`, `[+-]Infinity`, `[+-]Inf` or `NaN`. <br>
+   * Conversion is exact - strings which need rounding to fit 34 digits are rejected.
+   * @param data
+   * @param size
+   * @param result
+   * @return - `true` on success.
+   */
+  static bool tryParse(const char* data, v_buff_size size, Decimal128& result);
+
+  /**
+   * Parse decimal string. See &l:Decimal128::tryParse ();.
+   * @param str
+   * @return
+   * @throws - `std::runtime_error` if string is not a valid exact decimal.
+   */
+  static Decimal128 fromString(const oatpp::String& str);
+
+  /**
+   * Create from `value * 10^-scale`. Ex.: `fromScaledInt64(12345, 2)` is `123.45`.
+   * @param value
+   * @param scale - count of fraction digits.
+   * @return
+   */
+  static Decimal128 fromScaledInt64(v_int64 value, v_int32 scale);
+
+  /**
+   * Create from double. The shortest decimal representation which round-trips to the same double is used.
+   * @param value
+   * @return
+   */
+  static Decimal128 fromDouble(v_float64 value);
+
+  /**
+   * Create NaN.
+   * @return
+   */
+  static Decimal128 nan();
+
+  /**
+   * Create infinity.
+   * @param negative
+   * @return
+   */
+  static Decimal128 infinity(bool negative = false);
+
+  /**
+   * Get high 64 bits.
+   * @return
+   */
+  v_uint64 getHigh() const;
+
+  /**
+   * Get low 64 bits.
+   * @return
+   */
+  v_uint64 getLow() const;
+
+  /**
+   * Write 16 bytes of BSON value (little-endian).
+   * @param data - buffer of at least &l:Decimal128::DATA_SIZE; bytes.
+   */
+  void toBytes(void* data) const;
+
+  bool isNaN() const;
+  bool isInfinite() const;
+  bool isNegative() const;
+
+  /**
+   * Convert to value scaled by `10^scale`. Ex.: `123.45` with scale `2` is `12345`.
+   * @param scale - count of fraction digits.
+   * @param result
+   * @return - `false` if value is not exactly representable with the given scale or doesn't fit int64.
+   */
+  bool toScaledInt64(v_int32 scale, v_int64& result) const;
+
+  /**
+   * Convert to double - correctly rounded.
+   * @return
+   */
+  v_float64 toDouble() const;
+
+  /**
+   * Convert to string - same format as the MongoDB drivers use.
+   * @return
+   */
+  oatpp::String toString() const;
+
+  /**
+   * Compare representations - `1.0` and `1.00` are not equal.
+   */
+  bool operator==(const Decimal128 &other) const;
+  bool operator!=(const Decimal128 &other) const;
+
+};
+
+}}}}
+
+#endif // oatpp_mongo_bson_type_Decimal128_hpp
@@ -0,0 +1,102 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "Document.hpp"
+
+#include "oatpp-mongo/bson/Utils.hpp"
+
+namespace oatpp { namespace mongo { namespace bson { namespace type {
+
+Document::Document()
+  : m_data(nullptr)
+{}
+
+Document::Document(const std::shared_ptr<std::string>& buffer)
+  : m_data(buffer ? data::share::MemoryLabel(buffer) : data::share::MemoryLabel(nullptr))
+{}
+
+Document::Document(const oatpp::String& buffer)
+  : Document(buffer.getPtr())
+{}
+
+Document::Document(const std::shared_ptr<std::string>& buffer, v_buff_size offset, v_buff_size size)
+{
+  if(!buffer || offset < 0 || size < 0 || offset > (v_buff_size) buffer->size() - size) {
+    throw std::runtime_error("[oatpp::mongo::bson::type::Document::Document()]: Error. Slice is out of the buffer bounds.");
+  }
+  m_data = data::share::MemoryLabel(buffer, buffer->data() + offset, size);
+}
+
+Document::Document(const data::share::MemoryLabel& label)
+  : m_data(label)
+{
+  if(m_data.getData() && !m_data.getMemoryHandle()) {
+    m_data.captureToOwnMemory();
+  }
+}
+
+const data::share::MemoryLabel& Document::getLabel() const {
+  return m_data;
+}
+
+std::shared_ptr<std::string> Document::getBuffer() const {
+  return m_data.getMemoryHandle();
+}
+
+v_buff_size Document::getOffset() const {
+  auto buffer = m_data.getMemoryHandle();
+  if(!buffer) {
+    return 0;
+  }
+  return (const char*) m_data.getData() - buffer->data();
+}
+
+const char* Document::getData() const {
+  return (const char*) m_data.getData();
+}
+
+v_buff_size Document::getSize() const {
+  return m_data.getSize();
+}
+
+bool Document::isValid() const {
+  const char* data = getData();
+  v_buff_size size = getSize();
+  return data != nullptr && size >= 5 && Utils::loadLE<v_int32>(data) == size && data[size - 1] == 0;
+}
+
+oatpp::String Document::toString() const {
+  return m_data.toString();
+}
+
+bool Document::operator==(const Document &other) const {
+  return m_data.equals(other.m_data.getData(), other.m_data.getSize());
+}
+
+bool Document::operator!=(const Document &other) const {
+  return !operator==(other);
+}
+
+}}}}
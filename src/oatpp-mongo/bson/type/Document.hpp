@@ -0,0 +1,126 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_mongo_bson_type_Document_hpp
+#define oatpp_mongo_bson_type_Document_hpp
+
+#include "oatpp/data/share/MemoryLabel.hpp"
+#include "oatpp/Types.hpp"
+
+namespace oatpp { namespace mongo { namespace bson { namespace type {
+
+/**
+ * Immutable ref-counted view of a BSON document - `(buffer, offset, length)`. <br>
+ * Copying the Document or passing it between the mapper, commands and wire sections never copies the document bytes.
+ * Note: the view keeps the whole source buffer alive.
+ */
+class Document : public oatpp::base::Countable {
+private:
+  data::share::MemoryLabel m_data;
+public:
+
+  /**
+   * Constructor. Empty document view.
+   */
+  Document();
+
+  /**
+   * Constructor. View of the whole buffer.
+   * @param buffer - buffer containing the BSON document.
+   */
+  Document(const std::shared_ptr<std::string>& buffer);
+
+  /**
+   * Constructor. View of the whole buffer.
+   * @param buffer - buffer containing the BSON document.
+   */
+  Document(const oatpp::String& buffer);
+
+  /**
+   * Constructor. View of the buffer slice.
+   * @param buffer - buffer holding the BSON document.
+   * @param offset - offset of the document in the buffer.
+   * @param size - size of the document.
+   * @throws - `std::runtime_error` if the slice is out of the buffer bounds.
+   */
+  Document(const std::shared_ptr<std::string>& buffer, v_buff_size offset, v_buff_size size);
+
+  /**
+   * Constructor. If label has no memory handle its data is copied.
+   * @param label - &id:oatpp::data::share::MemoryLabel;.
+   */
+  Document(const data::share::MemoryLabel& label);
+
+  /**
+   * Get document label.
+   * @return - &id:oatpp::data::share::MemoryLabel;.
+   */
+  const data::share::MemoryLabel& getLabel() const;
+
+  /**
+   * Get source buffer.
+   * @return
+   */
+  std::shared_ptr<std::string> getBuffer() const;
+
+  /**
+   * Offset of the document in the source buffer.
+   * @return
+   */
+  v_buff_size getOffset() const;
+
+  /**
+   * Pointer to the document.
+   * @return
+   */
+  const char* getData() const;
+
+  /**
+   * Size of the document.
+   * @return
+   */
+  v_buff_size getSize() const;
+
+  /**
+   * Check that the view is a well-formed BSON document frame -
+   * int32 size prefix equals to the view size and the last byte is `\0`. Elements are not checked.
+   * @return
+   */
+  bool isValid() const;
+
+  /**
+   * Copy the document to a new string.
+   * @return
+   */
+  oatpp::String toString() const;
+
+  bool operator==(const Document &other) const;
+  bool operator!=(const Document &other) const;
+
+};
+
+}}}}
+
+#endif // oatpp_mongo_bson_type_Document_hpp
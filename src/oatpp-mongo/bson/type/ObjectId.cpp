@@ -27,11 +27,67 @@
 
 #include "oatpp/utils/Random.hpp"
 #include <chrono>
+#include <cstring>
+#include <ctime>
 
 namespace oatpp { namespace mongo { namespace bson { namespace type {
 
+namespace {
+
+/* counter values reserved by the current thread for the given second - [next, end) */
+struct CounterBlock {
+  v_uint32 seconds;
+  v_uint64 next;
+  v_uint64 end;
+};
+
+thread_local CounterBlock COUNTER_BLOCK = {0, 0, 0};
+
+/*
+ * Hex tables are plain literals - constant-initialized, so they are usable from static initializers of other translation units.
+ * HEX_PAIRS - byte -> two hex chars at offset `byte * 2`.
+ * HEX_NIBBLES - hex char -> nibble. Invalid chars map to 0xF0 so that errors can be OR-ed together.
+ */
+const char HEX_PAIRS[] =
+  "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+  "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+  "404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+  "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+  "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+  "a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+  "c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+  "e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+const v_char8 HEX_NIBBLES[256] = {
+  0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+  0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+  0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+  0xF0, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+  0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+  0xF0, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+  0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+  0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+  0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+  0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+  0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+  0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+  0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+  0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+  0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0
+};
+
+}
+
+constexpr v_buff_size ObjectId::DATA_SIZE;
+constexpr v_buff_size ObjectId::STRING_SIZE;
+constexpr v_uint64 ObjectId::COUNTER_BLOCK_SIZE;
+constexpr v_buff_size ObjectId::MAX_GENERATE_COUNT;
+
 const std::string ObjectId::PROCESS_UNIQUE = seedProcessUnique();
-std::atomic<v_uint64> ObjectId::COUNTER(seedCounter());
+
+/* only the lower 24 bits go to the id. Seed is kept small so that the counter never wraps */
+std::atomic<v_uint64> ObjectId::COUNTER(seedCounter() & 0xFFFFFF);
 
 std::string ObjectId::seedProcessUnique() {
   v_char8 buff[5];
@@ -45,28 +101,149 @@ v_uint64 ObjectId::seedCounter() {
   return result;
 }
 
-ObjectId::ObjectId() {
-
-  v_uint32 counter = (++ COUNTER) % 16777216;
-  v_uint32 seconds = (v_uint32 )std::chrono::duration_cast<std::chrono::seconds>
+v_uint32 ObjectId::currentSeconds() {
+#if defined(CLOCK_REALTIME_COARSE)
+  /* vDSO clock with a tick resolution - more than enough for seconds */
+  struct timespec ts;
+  if(clock_gettime(CLOCK_REALTIME_COARSE, &ts) == 0) {
+    return (v_uint32) ts.tv_sec;
+  }
+#endif
+  return (v_uint32) std::chrono::duration_cast<std::chrono::seconds>
     (std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+v_uint64 ObjectId::reserveCounters(v_uint32 seconds, v_uint64 count) {
+
+  CounterBlock& block = COUNTER_BLOCK;
+
+  /* leftovers of the previous second are dropped - ids of one thread stay ordered by counter within a timestamp */
+  if(block.seconds != seconds) {
+    block.seconds = seconds;
+    block.next = 0;
+    block.end = 0;
+  }
+
+  if(block.end - block.next < count) {
+
+    if(count >= COUNTER_BLOCK_SIZE) {
+      return COUNTER.fetch_add(count, std::memory_order_relaxed);
+    }
 
-  m_data[0] = (v_char8) (0xFF & (seconds >> 24));
-  m_data[1] = (v_char8) (0xFF & (seconds >> 16));
-  m_data[2] = (v_char8) (0xFF & (seconds >> 8));
-  m_data[3] = (v_char8) (0xFF &  seconds);
+    block.next = COUNTER.fetch_add(COUNTER_BLOCK_SIZE, std::memory_order_relaxed);
+    block.end = block.next + COUNTER_BLOCK_SIZE;
+
+  }
+
+  v_uint64 result = block.next;
+  block.next += count;
+  return result;
+
+}
+
+void ObjectId::writeId(p_char8 data, v_uint32 seconds, v_uint64 counter) {
+
+  data[0] = (v_char8) (0xFF & (seconds >> 24));
+  data[1] = (v_char8) (0xFF & (seconds >> 16));
+  data[2] = (v_char8) (0xFF & (seconds >> 8));
+  data[3] = (v_char8) (0xFF &  seconds);
 
   for(v_buff_size i = 0; i < 5; i ++) {
-    m_data[4 + i] = PROCESS_UNIQUE[i];
+    data[4 + i] = PROCESS_UNIQUE[i];
+  }
+
+  data[ 9] = (v_char8) (0xFF & (counter >> 16));
+  data[10] = (v_char8) (0xFF & (counter >> 8));
+  data[11] = (v_char8) (0xFF &  counter);
+
+}
+
+void ObjectId::checkGenerateCount(v_buff_size count) {
+  if(count > MAX_GENERATE_COUNT) {
+    throw std::runtime_error("[oatpp::mongo::bson::type::ObjectId::generate()]: Error. "
+                             "Count exceeds the 24-bit counter range of one timestamp.");
+  }
+}
+
+void ObjectId::generate(v_buff_size count, p_char8 data) {
+  if(count <= 0) {
+    return;
+  }
+  checkGenerateCount(count);
+  v_uint32 seconds = currentSeconds();
+  v_uint64 counter = reserveCounters(seconds, count);
+  for(v_buff_size i = 0; i < count; i ++) {
+    writeId(data + i * DATA_SIZE, seconds, counter + i);
+  }
+}
+
+void ObjectId::generate(v_buff_size count, std::vector<ObjectId>& ids) {
+  if(count <= 0) {
+    return;
+  }
+  checkGenerateCount(count);
+  v_uint32 seconds = currentSeconds();
+  v_uint64 counter = reserveCounters(seconds, count);
+  v_char8 data[DATA_SIZE];
+  ids.reserve(ids.size() + count);
+  for(v_buff_size i = 0; i < count; i ++) {
+    writeId(data, seconds, counter + i);
+    ids.emplace_back(data);
   }
+}
+
+ObjectId ObjectId::minForTime(v_uint32 seconds) {
+  v_char8 data[DATA_SIZE];
+  std::memset(data, 0, DATA_SIZE);
+  data[0] = (v_char8) (0xFF & (seconds >> 24));
+  data[1] = (v_char8) (0xFF & (seconds >> 16));
+  data[2] = (v_char8) (0xFF & (seconds >> 8));
+  data[3] = (v_char8) (0xFF &  seconds);
+  return ObjectId(data);
+}
 
-  m_data[ 9] = (v_char8) (0xFF & (counter >> 16));
-  m_data[10] = (v_char8) (0xFF & (counter >> 8));
-  m_data[11] = (v_char8) (0xFF &  counter);
+ObjectId ObjectId::maxForTime(v_uint32 seconds) {
+  v_char8 data[DATA_SIZE];
+  std::memset(data, 0xFF, DATA_SIZE);
+  data[0] = (v_char8) (0xFF & (seconds >> 24));
+  data[1] = (v_char8) (0xFF & (seconds >> 16));
+  data[2] = (v_char8) (0xFF & (seconds >> 8));
+  data[3] = (v_char8) (0xFF &  seconds);
+  return ObjectId(data);
+}
+
+std::vector<ObjectId::Range> ObjectId::splitTimeRange(v_uint32 fromSeconds, v_uint32 toSeconds, v_int32 count) {
 
+  if(count <= 0) {
+    throw std::runtime_error("[oatpp::mongo::bson::type::ObjectId::splitTimeRange()]: Error. Count must be positive.");
+  }
+
+  if(fromSeconds > toSeconds) {
+    throw std::runtime_error("[oatpp::mongo::bson::type::ObjectId::splitTimeRange()]: Error. Invalid time interval.");
+  }
+
+  std::vector<Range> result;
+  const v_uint64 duration = toSeconds - fromSeconds;
+  v_uint32 lower = fromSeconds;
+
+  for(v_int32 i = 1; i <= count; i ++) {
+    v_uint32 upper = fromSeconds + (v_uint32) (duration * i / count);
+    if(upper > lower) {
+      result.push_back(Range{minForTime(lower), minForTime(upper)});
+      lower = upper;
+    }
+  }
+
+  return result;
+
+}
+
+ObjectId::ObjectId() {
+  v_uint32 seconds = currentSeconds();
+  writeId(m_data, seconds, reserveCounters(seconds, 1));
 }
 
-ObjectId::ObjectId(v_char8 data[DATA_SIZE]) {
+ObjectId::ObjectId(const v_char8 data[DATA_SIZE]) {
   for(v_buff_size i = 0; i < DATA_SIZE; i ++) {
     m_data[i] = data[i];
   }
@@ -81,32 +258,58 @@ v_buff_size ObjectId::getSize() const {
 }
 
 v_uint32 ObjectId::getTimestamp() const {
-  return (m_data[0] << 24) | (m_data[1] << 16) | (m_data[2] << 8) | m_data[3];
+  return ((v_uint32) m_data[0] << 24) | ((v_uint32) m_data[1] << 16) | ((v_uint32) m_data[2] << 8) | (v_uint32) m_data[3];
 }
 
 oatpp::String ObjectId::toString() const {
-  static const v_char8 alphabet[16] {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
-  oatpp::String result(DATA_SIZE * 2);
-  p_char8 rdata = (p_char8) result->data();
+  oatpp::String result(STRING_SIZE);
+  toString((char*) result->data());
+  return result;
+}
+
+void ObjectId::toString(char* buffer) const {
   for(v_buff_size i = 0; i < DATA_SIZE; i ++) {
-    auto a = m_data[i];
-    v_char8 b1 = 0x0F & (a >> 4);
-    v_char8 b2 = 0x0F & (a);
-    rdata[i * 2    ] = alphabet[b1];
-    rdata[i * 2 + 1] = alphabet[b2];
+    std::memcpy(buffer + i * 2, &HEX_PAIRS[m_data[i] * 2], 2);
   }
-  return result;
 }
 
-bool ObjectId::operator==(const ObjectId &other) const {
+bool ObjectId::tryParse(const char* data, v_buff_size size, ObjectId& result) {
 
-  v_uint64 m1 = *((p_uint64) m_data);
-  v_uint64 o1 = *((p_uint64) other.m_data);
+  if(data == nullptr || size != STRING_SIZE) {
+    return false;
+  }
 
-  v_uint32 m2 = *((p_uint32) &m_data[8]);
-  v_uint32 o2 = *((p_uint32) &other.m_data[8]);
+  const v_char8* str = (const v_char8*) data;
+  v_char8 bytes[DATA_SIZE];
+  v_char8 invalid = 0;
 
-  return m1 == o1 && m2 == o2;
+  for(v_buff_size i = 0; i < DATA_SIZE; i ++) {
+    v_char8 high = HEX_NIBBLES[str[i * 2]];
+    v_char8 low = HEX_NIBBLES[str[i * 2 + 1]];
+    invalid |= high | low;
+    bytes[i] = (v_char8) ((high << 4) | (low & 0x0F));
+  }
+
+  if(invalid & 0xF0) {
+    return false;
+  }
+
+  std::memcpy(result.m_data, bytes, DATA_SIZE);
+  return true;
+
+}
+
+ObjectId ObjectId::fromString(const oatpp::String& str) {
+  v_char8 zero[DATA_SIZE] = {};
+  ObjectId result(zero);
+  if(!str || !tryParse(str->data(), (v_buff_size) str->size(), result)) {
+    throw std::runtime_error("[oatpp::mongo::bson::type::ObjectId::fromString()]: Error. Invalid ObjectId string.");
+  }
+  return result;
+}
+
+bool ObjectId::operator==(const ObjectId &other) const {
+  return std::memcmp(m_data, other.m_data, DATA_SIZE) == 0;
 }
 
 bool ObjectId::operator!=(const ObjectId &other) const {
@@ -28,6 +28,8 @@
 
 #include "oatpp/Types.hpp"
 #include <atomic>
+#include <cstring>
+#include <vector>
 
 namespace oatpp { namespace mongo { namespace bson { namespace type {
 
@@ -35,20 +37,91 @@ namespace oatpp { namespace mongo { namespace bson { namespace type {
  * BSON ObjectId implementation.
  */
 class ObjectId : public oatpp::base::Countable {
+public:
+
+  /**
+   * Range of ObjectIds. See &l:ObjectId::splitTimeRange ();.
+   */
+  struct Range;
+
 private:
   static const std::string PROCESS_UNIQUE;
   static std::atomic<v_uint64> COUNTER;
   static std::string seedProcessUnique();
   static v_uint64 seedCounter();
+  static v_uint32 currentSeconds();
+  static v_uint64 reserveCounters(v_uint32 seconds, v_uint64 count);
+  static void checkGenerateCount(v_buff_size count);
+  static void writeId(p_char8 data, v_uint32 seconds, v_uint64 counter);
 public:
   /**
    * Size of ObjectId data.
    */
   static constexpr v_buff_size DATA_SIZE = 12;
+
+  /**
+   * Size of ObjectId hex string.
+   */
+  static constexpr v_buff_size STRING_SIZE = DATA_SIZE * 2;
+
+  /**
+   * Number of counter values a thread takes from the shared counter at once.
+   * Ids of one thread are generated from its block without touching shared state.
+   * Block is bound to the second it was taken in and is discarded when the clock moves on.
+   */
+  static constexpr v_uint64 COUNTER_BLOCK_SIZE = 1024;
+
+  /**
+   * Max number of ids in one &l:ObjectId::generate (); call. <br>
+   * All ids of the call share one timestamp, so more ids would wrap the 24-bit counter.
+   */
+  static constexpr v_buff_size MAX_GENERATE_COUNT = 0xFFFFFF;
 private:
   v_char8 m_data[DATA_SIZE];
 public:
 
+  /**
+   * Generate `count` new ids into the raw buffer. Clock is read once for the whole batch.
+   * @param count - number of ids to generate.
+   * @param data - buffer of `count * DATA_SIZE` bytes
+   * @throws - `std::runtime_error` if `count > MAX_GENERATE_COUNT`.
+   */
+  static void generate(v_buff_size count, p_char8 data);
+
+  /**
+   * Generate `count` new ids and append them to the vector. Clock is read once for the whole batch.
+   * @param count - number of ids to generate.
+   * @param ids - vector to append ids to
+   * @throws - `std::runtime_error` if `count > MAX_GENERATE_COUNT`.
+   */
+  static void generate(v_buff_size count, std::vector<ObjectId>& ids);
+
+  /**
+   * Get the smallest ObjectId with the given timestamp.
+   * @param seconds - unix time in seconds.
+   * @return - ObjectId with zero process-unique and counter parts.
+   */
+  static ObjectId minForTime(v_uint32 seconds);
+
+  /**
+   * Get the largest ObjectId with the given timestamp.
+   * @param seconds - unix time in seconds.
+   * @return - ObjectId with all bits set in process-unique and counter parts.
+   */
+  static ObjectId maxForTime(v_uint32 seconds);
+
+  /**
+   * Split time interval `[fromSeconds, toSeconds)` into `count` consecutive ranges of (almost) equal duration. <br>
+   * Ranges don't overlap and together cover all ObjectIds with timestamps within the interval.
+   * Ranges shorter than one second are dropped, so fewer than `count` ranges are returned for short intervals.
+   * @param fromSeconds - start of the interval, inclusive.
+   * @param toSeconds - end of the interval, exclusive.
+   * @param count - number of ranges.
+   * @return - `std::vector` of &l:ObjectId::Range;.
+   * @throws - `std::runtime_error` if `count` is not positive or `fromSeconds > toSeconds`.
+   */
+  static std::vector<Range> splitTimeRange(v_uint32 fromSeconds, v_uint32 toSeconds, v_int32 count);
+
   /**
    * Constructor. Creates new ObjectId.
    */
@@ -58,7 +131,7 @@ public:
    * Constructor. Creates ObjectId from byte array.
    * @param m_data
    */
-  ObjectId(v_char8 m_data[DATA_SIZE]);
+  ObjectId(const v_char8 m_data[DATA_SIZE]);
 
   /**
    * Get raw data of ObjectId.
@@ -84,11 +157,106 @@ public:
    */
   oatpp::String toString() const;
 
+  /**
+   * Write lowercase hex string to the caller buffer. Doesn't allocate.
+   * @param buffer - buffer of at least &l:ObjectId::STRING_SIZE; chars. The string is not `\0`-terminated.
+   */
+  void toString(char* buffer) const;
+
+  /**
+   * Parse ObjectId from 24-chars hex string. Both upper and lower case digits are accepted.
+   * @param data - string data.
+   * @param size - string size.
+   * @param result - parsed ObjectId. Untouched if string is invalid.
+   * @return - `true` on success.
+   */
+  static bool tryParse(const char* data, v_buff_size size, ObjectId& result);
+
+  /**
+   * Parse ObjectId from 24-chars hex string. See &l:ObjectId::tryParse ();.
+   * @param str - hex string.
+   * @return - ObjectId.
+   * @throws - `std::runtime_error` if string is not a valid ObjectId.
+   */
+  static ObjectId fromString(const oatpp::String& str);
+
+  /**
+   * Hash of raw ObjectId data. Mixes all 96 bits into 64-bit hash.
+   * @param data - &l:ObjectId::DATA_SIZE; bytes.
+   * @return - hash.
+   */
+  static v_uint64 hashData(const v_char8* data) {
+    v_uint64 head;
+    v_uint32 tail;
+    std::memcpy(&head, data, 8);
+    std::memcpy(&tail, data + 8, 4);
+    v_uint64 h = head ^ ((v_uint64) tail * 0x9E3779B97F4A7C15ULL);
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  /**
+   * Get hash code. Stable within the process only.
+   * @return - hash.
+   */
+  v_uint64 hashCode() const {
+    return hashData(m_data);
+  }
+
   bool operator==(const ObjectId &other) const;
   bool operator!=(const ObjectId &other) const;
 
+  /*
+   * Ordering is bytewise - same as the server sort order for ObjectIds.
+   */
+
+  bool operator<(const ObjectId &other) const {
+    return std::memcmp(m_data, other.m_data, DATA_SIZE) < 0;
+  }
+
+  bool operator>(const ObjectId &other) const {
+    return std::memcmp(m_data, other.m_data, DATA_SIZE) > 0;
+  }
+
+  bool operator<=(const ObjectId &other) const {
+    return std::memcmp(m_data, other.m_data, DATA_SIZE) <= 0;
+  }
+
+  bool operator>=(const ObjectId &other) const {
+    return std::memcmp(m_data, other.m_data, DATA_SIZE) >= 0;
+  }
+
+};
+
+/**
+ * Range of ObjectIds. `lowerBound` is inclusive, `upperBound` is exclusive. <br>
+ * Query as `{_id: {$gte: lowerBound, $lt: upperBound}}`.
+ */
+struct ObjectId::Range {
+  ObjectId lowerBound;
+  ObjectId upperBound;
 };
 
 }}}}
 
+namespace std {
+
+template<>
+struct hash<oatpp::mongo::bson::type::ObjectId> {
+
+  typedef oatpp::mongo::bson::type::ObjectId argument_type;
+  typedef v_uint64 result_type;
+
+  result_type operator()(const oatpp::mongo::bson::type::ObjectId& id) const noexcept {
+    return id.hashCode();
+  }
+
+};
+
+}
+
 #endif // oatpp_mongo_bson_type_ObjectId_hpp
@@ -0,0 +1,170 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_mongo_bson_type_ObjectIdMap_hpp
+#define oatpp_mongo_bson_type_ObjectIdMap_hpp
+
+#include "./ObjectIdSet.hpp"
+
+namespace oatpp { namespace mongo { namespace bson { namespace type {
+
+/**
+ * Flat hash map with &l:ObjectId; keys. <br>
+ * Keys are kept in &l:ObjectIdSet;, values are stored densely in the insertion order of the keys.
+ * Entries can't be removed, only cleared all at once.
+ * @tparam Value - value type. Must be default-constructible for &l:ObjectIdMap::operator[] ();.
+ */
+template<typename Value>
+class ObjectIdMap {
+private:
+  ObjectIdSet m_keys;
+  std::vector<Value> m_values;
+public:
+
+  /**
+   * Constructor.
+   * @param expectedSize - number of entries to reserve space for.
+   */
+  ObjectIdMap(v_buff_size expectedSize = 0)
+    : m_keys(expectedSize)
+  {
+    m_values.reserve(expectedSize);
+  }
+
+  /**
+   * Insert entry if there is no such key yet. Existing value is not replaced.
+   * @param id - key.
+   * @param value - value.
+   * @return - `true` if entry was inserted.
+   */
+  bool insert(const ObjectId& id, const Value& value) {
+    bool inserted;
+    m_keys.insertIndex(id, inserted);
+    if(inserted) {
+      m_values.push_back(value);
+    }
+    return inserted;
+  }
+
+  /**
+   * Get value by key. Inserts default-constructed value if there is no such key.
+   * @param id - key.
+   * @return - reference to value. Valid until the next insert.
+   */
+  Value& operator[](const ObjectId& id) {
+    bool inserted;
+    v_buff_size index = m_keys.insertIndex(id, inserted);
+    if(inserted) {
+      m_values.emplace_back();
+    }
+    return m_values[index];
+  }
+
+  /**
+   * Find value by key.
+   * @param id - key.
+   * @return - pointer to value or `nullptr` if there is no such key. Valid until the next insert.
+   */
+  Value* find(const ObjectId& id) {
+    v_buff_size index = m_keys.indexOf(id);
+    return index < 0 ? nullptr : &m_values[index];
+  }
+
+  /**
+   * Find value by key.
+   * @param id - key.
+   * @return - pointer to value or `nullptr` if there is no such key. Valid until the next insert.
+   */
+  const Value* find(const ObjectId& id) const {
+    v_buff_size index = m_keys.indexOf(id);
+    return index < 0 ? nullptr : &m_values[index];
+  }
+
+  /**
+   * Check if map contains the key.
+   * @param id - key.
+   * @return
+   */
+  bool contains(const ObjectId& id) const {
+    return m_keys.contains(id);
+  }
+
+  /**
+   * Get key by its position in the insertion order.
+   * @param index - position. Must be less than &l:ObjectIdMap::size ();.
+   * @return - key.
+   */
+  ObjectId getKey(v_buff_size index) const {
+    return m_keys.get(index);
+  }
+
+  /**
+   * Get value by its position in the insertion order.
+   * @param index - position. Must be less than &l:ObjectIdMap::size ();.
+   * @return - value.
+   */
+  Value& getValue(v_buff_size index) {
+    return m_values[index];
+  }
+
+  /**
+   * Get value by its position in the insertion order.
+   * @param index - position. Must be less than &l:ObjectIdMap::size ();.
+   * @return - value.
+   */
+  const Value& getValue(v_buff_size index) const {
+    return m_values[index];
+  }
+
+  /**
+   * Number of entries.
+   * @return
+   */
+  v_buff_size size() const {
+    return m_keys.size();
+  }
+
+  /**
+   * Reserve space for entries.
+   * @param size - number of entries.
+   */
+  void reserve(v_buff_size size) {
+    m_keys.reserve(size);
+    m_values.reserve(size);
+  }
+
+  /**
+   * Remove all entries.
+   */
+  void clear() {
+    m_keys.clear();
+    m_values.clear();
+  }
+
+};
+
+}}}}
+
+#endif // oatpp_mongo_bson_type_ObjectIdMap_hpp
@@ -0,0 +1,140 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ObjectIdSet.hpp"
+
+namespace oatpp { namespace mongo { namespace bson { namespace type {
+
+ObjectIdSet::ObjectIdSet(v_buff_size expectedSize)
+  : m_mask(0)
+{
+  reserve(expectedSize);
+}
+
+v_buff_size ObjectIdSet::findSlot(const v_char8* data, v_uint64 hash) const {
+  if(m_slots.empty()) {
+    return -1;
+  }
+  const v_uint32 tag = getTag(hash);
+  v_uint64 index = hash & m_mask;
+  while(true) {
+    const Slot& slot = m_slots[index];
+    if(slot.tag == 0) {
+      return (v_buff_size) index;
+    }
+    if(slot.tag == tag && std::memcmp(m_keys[slot.position].data, data, ObjectId::DATA_SIZE) == 0) {
+      return (v_buff_size) index;
+    }
+    index = (index + 1) & m_mask;
+  }
+}
+
+void ObjectIdSet::rehash(v_buff_size capacity) {
+  std::vector<Slot> slots(capacity, Slot{0, 0});
+  m_mask = (v_uint64) capacity - 1;
+  for(v_buff_size i = 0; i < (v_buff_size) m_keys.size(); i ++) {
+    v_uint64 hash = ObjectId::hashData(m_keys[i].data);
+    v_uint64 index = hash & m_mask;
+    while(slots[index].tag != 0) {
+      index = (index + 1) & m_mask;
+    }
+    slots[index].tag = getTag(hash);
+    slots[index].position = (v_uint32) i;
+  }
+  m_slots.swap(slots);
+}
+
+bool ObjectIdSet::insert(const ObjectId& id) {
+  bool inserted;
+  insertIndex(id, inserted);
+  return inserted;
+}
+
+v_buff_size ObjectIdSet::insertIndex(const ObjectId& id, bool& inserted) {
+
+  /* keep load factor under 3/4 */
+  if(((v_buff_size) m_keys.size() + 1) * 4 > (v_buff_size) m_slots.size() * 3) {
+    rehash(m_slots.empty() ? 16 : (v_buff_size) m_slots.size() * 2);
+  }
+
+  const v_char8* data = id.getData();
+  v_uint64 hash = ObjectId::hashData(data);
+  Slot& slot = m_slots[findSlot(data, hash)];
+
+  if(slot.tag != 0) {
+    inserted = false;
+    return slot.position;
+  }
+
+  slot.tag = getTag(hash);
+  slot.position = (v_uint32) m_keys.size();
+  m_keys.emplace_back();
+  std::memcpy(m_keys.back().data, data, ObjectId::DATA_SIZE);
+
+  inserted = true;
+  return slot.position;
+
+}
+
+bool ObjectIdSet::contains(const ObjectId& id) const {
+  return indexOf(id) >= 0;
+}
+
+v_buff_size ObjectIdSet::indexOf(const ObjectId& id) const {
+  const v_char8* data = id.getData();
+  v_buff_size index = findSlot(data, ObjectId::hashData(data));
+  if(index < 0 || m_slots[index].tag == 0) {
+    return -1;
+  }
+  return m_slots[index].position;
+}
+
+ObjectId ObjectIdSet::get(v_buff_size index) const {
+  return ObjectId(m_keys[index].data);
+}
+
+v_buff_size ObjectIdSet::size() const {
+  return (v_buff_size) m_keys.size();
+}
+
+void ObjectIdSet::reserve(v_buff_size size) {
+  v_buff_size capacity = 16;
+  while(capacity * 3 < size * 4) {
+    capacity *= 2;
+  }
+  if(capacity > (v_buff_size) m_slots.size()) {
+    m_keys.reserve(size);
+    rehash(capacity);
+  }
+}
+
+void ObjectIdSet::clear() {
+  m_keys.clear();
+  for(auto& slot : m_slots) {
+    slot.tag = 0;
+  }
+}
+
+}}}}
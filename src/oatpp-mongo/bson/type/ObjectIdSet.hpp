@@ -0,0 +1,131 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_mongo_bson_type_ObjectIdSet_hpp
+#define oatpp_mongo_bson_type_ObjectIdSet_hpp
+
+#include "./ObjectId.hpp"
+
+#include <vector>
+
+namespace oatpp { namespace mongo { namespace bson { namespace type {
+
+/**
+ * Flat open-addressing hash set of ObjectIds. <br>
+ * Ids are stored densely in insertion order (12 bytes each), the hash index holds
+ * 8-byte slots: hash tag + position of the id. Ids can't be removed, only cleared all at once.
+ */
+class ObjectIdSet {
+private:
+
+  struct Key {
+    v_char8 data[ObjectId::DATA_SIZE];
+  };
+
+  struct Slot {
+    /* high bits of the hash, never `0`. `0` marks an empty slot */
+    v_uint32 tag;
+    v_uint32 position;
+  };
+
+private:
+
+  static v_uint32 getTag(v_uint64 hash) {
+    return (v_uint32) (hash >> 32) | 1;
+  }
+
+private:
+  std::vector<Key> m_keys;
+  std::vector<Slot> m_slots;
+  v_uint64 m_mask;
+private:
+  v_buff_size findSlot(const v_char8* data, v_uint64 hash) const;
+  void rehash(v_buff_size capacity);
+public:
+
+  /**
+   * Constructor.
+   * @param expectedSize - number of ids to reserve space for.
+   */
+  ObjectIdSet(v_buff_size expectedSize = 0);
+
+  /**
+   * Add id to the set.
+   * @param id - &l:ObjectId;.
+   * @return - `true` if id was not in the set.
+   */
+  bool insert(const ObjectId& id);
+
+  /**
+   * Add id to the set if it's not there yet.
+   * @param id - &l:ObjectId;.
+   * @param inserted - out parameter. `true` if id was not in the set.
+   * @return - position of the id in the insertion order.
+   */
+  v_buff_size insertIndex(const ObjectId& id, bool& inserted);
+
+  /**
+   * Check if set contains the id.
+   * @param id - &l:ObjectId;.
+   * @return
+   */
+  bool contains(const ObjectId& id) const;
+
+  /**
+   * Get position of the id in the insertion order.
+   * @param id - &l:ObjectId;.
+   * @return - position or `-1` if there is no such id.
+   */
+  v_buff_size indexOf(const ObjectId& id) const;
+
+  /**
+   * Get id by its position in the insertion order.
+   * @param index - position. Must be less than &l:ObjectIdSet::size ();.
+   * @return - &l:ObjectId;.
+   */
+  ObjectId get(v_buff_size index) const;
+
+  /**
+   * Number of ids in the set.
+   * @return
+   */
+  v_buff_size size() const;
+
+  /**
+   * Reserve space for ids so that no rehash happens until the size is reached.
+   * @param size - number of ids.
+   */
+  void reserve(v_buff_size size);
+
+  /**
+   * Remove all ids. Keeps the allocated memory.
+   */
+  void clear();
+
+};
+
+}}}}
+
+#endif // oatpp_mongo_bson_type_ObjectIdSet_hpp
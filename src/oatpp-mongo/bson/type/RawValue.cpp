@@ -0,0 +1,59 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "RawValue.hpp"
+
+namespace oatpp { namespace mongo { namespace bson { namespace type {
+
+RawValue::RawValue(v_char8 typeCode, const data::share::MemoryLabel& data)
+  : m_typeCode(typeCode)
+  , m_data(data)
+{}
+
+v_char8 RawValue::getTypeCode() const {
+  return m_typeCode;
+}
+
+const data::share::MemoryLabel& RawValue::getLabel() const {
+  return m_data;
+}
+
+const char* RawValue::getData() const {
+  return (const char*) m_data.getData();
+}
+
+v_buff_size RawValue::getSize() const {
+  return m_data.getSize();
+}
+
+bool RawValue::operator==(const RawValue &other) const {
+  return m_typeCode == other.m_typeCode && m_data.equals(other.m_data.getData(), other.m_data.getSize());
+}
+
+bool RawValue::operator!=(const RawValue &other) const {
+  return !operator==(other);
+}
+
+}}}}
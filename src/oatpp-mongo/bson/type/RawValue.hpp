@@ -0,0 +1,83 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_mongo_bson_type_RawValue_hpp
+#define oatpp_mongo_bson_type_RawValue_hpp
+
+#include "oatpp/data/share/MemoryLabel.hpp"
+#include "oatpp/Types.hpp"
+
+namespace oatpp { namespace mongo { namespace bson { namespace type {
+
+/**
+ * Raw BSON element value - type-code plus ref-counted slice of the value bytes in the source buffer. <br>
+ * Used for elements which have no mapped type (Regexp, JavaScript code, Symbol, MinKey, MaxKey, etc.),
+ * so that they are written back byte-for-byte.
+ */
+class RawValue : public oatpp::base::Countable {
+private:
+  v_char8 m_typeCode;
+  data::share::MemoryLabel m_data;
+public:
+
+  /**
+   * Constructor.
+   * @param typeCode - BSON type-code of the element.
+   * @param data - value bytes - everything after the element key.
+   */
+  RawValue(v_char8 typeCode, const data::share::MemoryLabel& data);
+
+  /**
+   * Get BSON type-code of the element.
+   * @return - &id:oatpp::mongo::bson::TypeCode;.
+   */
+  v_char8 getTypeCode() const;
+
+  /**
+   * Get value bytes label.
+   * @return - &id:oatpp::data::share::MemoryLabel;.
+   */
+  const data::share::MemoryLabel& getLabel() const;
+
+  /**
+   * Pointer to the value bytes.
+   * @return
+   */
+  const char* getData() const;
+
+  /**
+   * Size of the value bytes.
+   * @return
+   */
+  v_buff_size getSize() const;
+
+  bool operator==(const RawValue &other) const;
+  bool operator!=(const RawValue &other) const;
+
+};
+
+}}}}
+
+#endif // oatpp_mongo_bson_type_RawValue_hpp
@@ -0,0 +1,334 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "CursorBatch.hpp"
+
+#include <exception>
+
+namespace oatpp { namespace mongo { namespace driver { namespace command {
+
+CursorBatch::Job::Job(v_int32 pRangesCount, v_buff_size documentsCount)
+  : rangesCount(pRangesCount)
+  , next(0)
+  , completed(0)
+  , errors(pRangesCount)
+  , result(documentsCount)
+{}
+
+CursorBatch::CursorBatch()
+  : m_cursorId(0)
+{}
+
+bool CursorBatch::readDocumentBegin(utils::parser::Caret& caret, v_buff_size& documentEnd) {
+
+  v_buff_size documentStart = caret.getPosition();
+  v_int32 documentSize = bson::Utils::readInt32(caret);
+  if(caret.hasError()) {
+    return false;
+  }
+
+  if(documentSize < 5 || documentStart + documentSize > caret.getDataSize()) {
+    caret.setError("[oatpp::mongo::driver::command::CursorBatch::readDocumentBegin()]: Error. Invalid document size.");
+    return false;
+  }
+
+  documentEnd = documentStart + documentSize;
+  return true;
+
+}
+
+bool CursorBatch::readDocumentEnd(utils::parser::Caret& caret, v_buff_size documentEnd) {
+
+  if(caret.hasError()) {
+    return false;
+  }
+
+  if(caret.getPosition() != documentEnd - 1 || !caret.canContinueAtChar(0, 1)) {
+    caret.setError("[oatpp::mongo::driver::command::CursorBatch::readDocumentEnd()]: Error. '\\0' - expected");
+    return false;
+  }
+
+  return true;
+
+}
+
+bool CursorBatch::readCursor(utils::parser::Caret& caret) {
+
+  v_buff_size documentEnd;
+  if(!readDocumentBegin(caret, documentEnd)) {
+    return false;
+  }
+
+  while(caret.canContinue() && caret.getPosition() < documentEnd - 1) {
+
+    v_char8 typeCode;
+    auto key = bson::Utils::readKey(caret, typeCode);
+    if(caret.hasError()) {
+      return false;
+    }
+
+    if(typeCode == bson::TypeCode::DOCUMENT_ARRAY && (key == "firstBatch" || key == "nextBatch")) {
+
+      if(!readBatch(caret)) {
+        return false;
+      }
+
+    } else if(typeCode == bson::TypeCode::INT_64 && key == "id") {
+
+      m_cursorId = bson::Utils::readInt64(caret);
+
+    } else if(typeCode == bson::TypeCode::STRING && key == "ns") {
+
+      v_int32 size = bson::Utils::readInt32(caret);
+      if(size < 1 || size + caret.getPosition() > documentEnd) {
+        caret.setError("[oatpp::mongo::driver::command::CursorBatch::readCursor()]: Error. Invalid namespace size.");
+        return false;
+      }
+      m_namespace = oatpp::String(caret.getCurrData(), size - 1);
+      caret.inc(size);
+
+    } else {
+      bson::Utils::skipElement(caret, typeCode);
+    }
+
+  }
+
+  return readDocumentEnd(caret, documentEnd);
+
+}
+
+bool CursorBatch::readBatch(utils::parser::Caret& caret) {
+
+  v_buff_size documentEnd;
+  if(!readDocumentBegin(caret, documentEnd)) {
+    return false;
+  }
+
+  while(caret.canContinue() && caret.getPosition() < documentEnd - 1) {
+
+    v_char8 typeCode;
+    bson::Utils::skipKey(caret, typeCode);
+    if(caret.hasError()) {
+      return false;
+    }
+
+    if(typeCode != bson::TypeCode::DOCUMENT_EMBEDDED) {
+      caret.setError("[oatpp::mongo::driver::command::CursorBatch::readBatch()]: Error. Batch item is not a document.");
+      return false;
+    }
+
+    const char* itemData = caret.getCurrData();
+    v_buff_size itemStart = caret.getPosition();
+    v_int32 itemSize = bson::Utils::readInt32(caret);
+    if(caret.hasError()) {
+      return false;
+    }
+
+    if(itemSize < 5 || itemStart + itemSize > documentEnd - 1) {
+      caret.setError("[oatpp::mongo::driver::command::CursorBatch::readBatch()]: Error. Invalid document size.");
+      return false;
+    }
+
+    caret.setPosition(itemStart + itemSize);
+    m_documents.push_back(data::share::MemoryLabel(m_body.getPtr(), itemData, itemSize));
+
+  }
+
+  return readDocumentEnd(caret, documentEnd);
+
+}
+
+bool CursorBatch::readFromCaret(utils::parser::Caret& caret) {
+
+  m_body = caret.getDataMemoryHandle();
+  m_cursorId = 0;
+  m_namespace = nullptr;
+  m_documents.clear();
+
+  v_buff_size documentEnd;
+  if(!readDocumentBegin(caret, documentEnd)) {
+    return false;
+  }
+
+  while(caret.canContinue() && caret.getPosition() < documentEnd - 1) {
+
+    v_char8 typeCode;
+    auto key = bson::Utils::readKey(caret, typeCode);
+    if(caret.hasError()) {
+      return false;
+    }
+
+    if(typeCode == bson::TypeCode::DOCUMENT_EMBEDDED && key == "cursor") {
+      if(!readCursor(caret)) {
+        return false;
+      }
+    } else {
+      bson::Utils::skipElement(caret, typeCode);
+    }
+
+  }
+
+  return readDocumentEnd(caret, documentEnd);
+
+}
+
+void CursorBatch::readFromOpMsg(const wire::OpMsg& reply) {
+
+  for(auto& section : reply.sections) {
+
+    if(section->getType() == wire::Section::TYPE_BODY) {
+
+      auto body = std::static_pointer_cast<wire::BodySection>(section);
+      if(!body->document) {
+        break;
+      }
+
+      utils::parser::Caret caret(body->document);
+      if(!readFromCaret(caret)) {
+        throw std::runtime_error(std::string("[oatpp::mongo::driver::command::CursorBatch::readFromOpMsg()]: "
+                                             "Error. Can't read cursor batch. ") + caret.getErrorMessage());
+      }
+      return;
+
+    }
+
+  }
+
+  throw std::runtime_error("[oatpp::mongo::driver::command::CursorBatch::readFromOpMsg()]: Error. Reply has no body section.");
+
+}
+
+v_int64 CursorBatch::getCursorId() const {
+  return m_cursorId;
+}
+
+oatpp::String CursorBatch::getNamespace() const {
+  return m_namespace;
+}
+
+const std::vector<data::share::MemoryLabel>& CursorBatch::getDocuments() const {
+  return m_documents;
+}
+
+void CursorBatch::deserializeRange(const ObjectMapper* mapper, const Type* type,
+                                   v_buff_size from, v_buff_size to,
+                                   std::vector<oatpp::Void>* result) const
+{
+
+  for(v_buff_size i = from; i < to; i ++) {
+
+    const auto& document = m_documents[i];
+    data::mapping::ErrorStack errorStack;
+
+    if(m_body) {
+      /* read on the caret over the whole body to keep the memory handle of the source buffer */
+      utils::parser::Caret caret(m_body);
+      caret.setPosition((const char*) document.getData() - m_body->data());
+      (*result)[i] = mapper->read(caret, type, errorStack);
+      checkReadResult(caret, errorStack);
+    } else {
+      utils::parser::Caret caret((const char*) document.getData(), document.getSize());
+      (*result)[i] = mapper->read(caret, type, errorStack);
+      checkReadResult(caret, errorStack);
+    }
+
+  }
+
+}
+
+void CursorBatch::checkReadResult(utils::parser::Caret& caret, const data::mapping::ErrorStack& errorStack) {
+
+  if(caret.hasError()) {
+    throw std::runtime_error(std::string("[oatpp::mongo::driver::command::CursorBatch::deserialize()]: "
+                                         "Error. Can't deserialize document. ") + caret.getErrorMessage());
+  }
+
+  if(!errorStack.empty()) {
+    throw std::runtime_error(std::string("[oatpp::mongo::driver::command::CursorBatch::deserialize()]: "
+                                         "Error. Can't deserialize document. ") + *errorStack.stacktrace());
+  }
+
+}
+
+std::vector<oatpp::Void> CursorBatch::deserialize(const ObjectMapper& mapper, const Type* type, WorkerPool* pool) const {
+
+  const v_buff_size count = m_documents.size();
+
+  v_int32 rangesCount = pool ? pool->getThreadsCount() + 1 : 1;
+  if(rangesCount > count) {
+    rangesCount = (v_int32) count;
+  }
+  if(rangesCount <= 1) {
+    std::vector<oatpp::Void> result(count);
+    deserializeRange(&mapper, type, 0, count, &result);
+    return result;
+  }
+
+  /*
+   * Ranges are claimed by the calling thread and by pool workers through the atomic counter.
+   * The calling thread claims whatever is left by busy workers, so it never waits for a queued task -
+   * late workers find no ranges left and only touch the job they share ownership of.
+   */
+  auto job = std::make_shared<Job>(rangesCount, count);
+  const ObjectMapper* mapperPtr = &mapper;
+
+  auto work = [this, job, mapperPtr, type, count] {
+    v_int32 range;
+    while((range = job->next.fetch_add(1)) < job->rangesCount) {
+      try {
+        deserializeRange(mapperPtr, type, count * range / job->rangesCount, count * (range + 1) / job->rangesCount, &job->result);
+      } catch (...) {
+        job->errors[range] = std::current_exception();
+      }
+      std::lock_guard<std::mutex> lock(job->mutex);
+      job->completed ++;
+      job->condition.notify_all();
+    }
+  };
+
+  for(v_int32 i = 1; i < rangesCount; i ++) {
+    pool->execute(work);
+  }
+
+  work();
+
+  {
+    std::unique_lock<std::mutex> lock(job->mutex);
+    while(job->completed < job->rangesCount) {
+      job->condition.wait(lock);
+    }
+  }
+
+  for(auto& error : job->errors) {
+    if(error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  return std::move(job->result);
+
+}
+
+}}}}
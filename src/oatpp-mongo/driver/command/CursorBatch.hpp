@@ -0,0 +1,162 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_mongo_driver_command_CursorBatch_hpp
+#define oatpp_mongo_driver_command_CursorBatch_hpp
+
+#include "./WorkerPool.hpp"
+
+#include "oatpp-mongo/driver/wire/OpMsg.hpp"
+#include "oatpp-mongo/bson/mapping/ObjectMapper.hpp"
+
+#include "oatpp/data/share/MemoryLabel.hpp"
+#include "oatpp/utils/parser/Caret.hpp"
+#include "oatpp/Types.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace oatpp { namespace mongo { namespace driver { namespace command {
+
+/**
+ * Batch of documents returned by the server in `cursor.firstBatch` or `cursor.nextBatch`
+ * of the `find`/`getMore` reply. <br>
+ * Documents are kept as slices of the reply body and can be deserialized in parallel.
+ */
+class CursorBatch {
+public:
+  typedef bson::mapping::ObjectMapper ObjectMapper;
+private:
+
+  /*
+   * State of one parallel deserialize() call shared with the pool tasks.
+   */
+  struct Job {
+    Job(v_int32 pRangesCount, v_buff_size documentsCount);
+    const v_int32 rangesCount;
+    std::atomic<v_int32> next;
+    std::mutex mutex;
+    std::condition_variable condition;
+    v_int32 completed;
+    std::vector<std::exception_ptr> errors;
+    std::vector<oatpp::Void> result;
+  };
+
+private:
+  static bool readDocumentBegin(utils::parser::Caret& caret, v_buff_size& documentEnd);
+  static bool readDocumentEnd(utils::parser::Caret& caret, v_buff_size documentEnd);
+  static void checkReadResult(utils::parser::Caret& caret, const data::mapping::ErrorStack& errorStack);
+private:
+  bool readCursor(utils::parser::Caret& caret);
+  bool readBatch(utils::parser::Caret& caret);
+  void deserializeRange(const ObjectMapper* mapper, const Type* type,
+                        v_buff_size from, v_buff_size to,
+                        std::vector<oatpp::Void>* result) const;
+private:
+  oatpp::String m_body;
+  v_int64 m_cursorId;
+  oatpp::String m_namespace;
+  std::vector<data::share::MemoryLabel> m_documents;
+public:
+
+  /**
+   * Constructor.
+   */
+  CursorBatch();
+
+  /**
+   * Read batch from the reply body document. <br>
+   * If caret was created over `oatpp::String` then documents hold a reference to that string,
+   * otherwise caller is responsible to keep the data alive while the batch is used.
+   * @param caret - &id:oatpp::utils::parser::Caret; positioned at the beginning of the reply body document.
+   * @return - `true` on success.
+   */
+  bool readFromCaret(utils::parser::Caret& caret);
+
+  /**
+   * Read batch from OP_MSG reply.
+   * @param reply - &id:oatpp::mongo::driver::wire::OpMsg;.
+   * @throws - `std::runtime_error` if reply has no body section or it can't be parsed.
+   */
+  void readFromOpMsg(const wire::OpMsg& reply);
+
+  /**
+   * Get cursor id. `0` means that cursor is exhausted.
+   * @return
+   */
+  v_int64 getCursorId() const;
+
+  /**
+   * Get namespace of the cursor.
+   * @return
+   */
+  oatpp::String getNamespace() const;
+
+  /**
+   * Get documents of the batch.
+   * @return - slices of the reply body, one per document.
+   */
+  const std::vector<data::share::MemoryLabel>& getDocuments() const;
+
+  /**
+   * Deserialize documents of the batch. <br>
+   * Documents are split in equal ranges between the calling thread and threads of the `pool`.
+   * Results are returned in the batch order.
+   * @param mapper - BSON object mapper. Must not be modified while deserialization is running.
+   * @param type - type of resultant objects.
+   * @param pool - &id:oatpp::mongo::driver::command::WorkerPool; to reuse between calls.
+   * If `nullptr` - documents are deserialized in the calling thread.
+   * @return - deserialized documents.
+   * @throws - `std::runtime_error` if any of documents can't be deserialized.
+   */
+  std::vector<oatpp::Void> deserialize(const ObjectMapper& mapper, const Type* type, WorkerPool* pool = nullptr) const;
+
+  /**
+   * Deserialize documents of the batch. <br>
+   * Same as `deserialize(mapper, Wrapper::Class::getType(), pool)`.
+   * @tparam Wrapper - type of resultant objects.
+   * @param mapper - BSON object mapper.
+   * @param pool - &id:oatpp::mongo::driver::command::WorkerPool;. If `nullptr` - documents are deserialized in the calling thread.
+   * @return - deserialized documents.
+   */
+  template<class Wrapper>
+  std::vector<Wrapper> deserialize(const ObjectMapper& mapper, WorkerPool* pool = nullptr) const {
+    auto values = deserialize(mapper, Wrapper::Class::getType(), pool);
+    std::vector<Wrapper> result;
+    result.reserve(values.size());
+    for(auto& value : values) {
+      result.push_back(value.template cast<Wrapper>());
+    }
+    return result;
+  }
+
+};
+
+}}}}
+
+#endif // oatpp_mongo_driver_command_CursorBatch_hpp
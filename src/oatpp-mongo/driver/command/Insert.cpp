@@ -43,7 +43,14 @@ Insert::Insert(const oatpp::String &databaseName,
 }
 
 void Insert::addDocument(const oatpp::String &document) {
-  m_documents->documents.push_back(document);
+  m_documents->documents.push_back(bson::type::Document(document));
+}
+
+void Insert::addDocument(const bson::Document& document) {
+  if(!document || !document->isValid()) {
+    throw std::runtime_error("[oatpp::mongo::driver::command::Insert::addDocument()]: Error. Invalid document.");
+  }
+  m_documents->documents.push_back(*document);
 }
 
 wire::Message Insert::toMessage(ObjectMapper* commandObjectMapper) {
@@ -66,6 +66,13 @@ public:
 
   void addDocument(const oatpp::String& document);
 
+  /**
+   * Add document to insert. Document bytes are not copied - the command holds a reference to the document buffer.
+   * @param document - &id:oatpp::mongo::bson::Document;.
+   * @throws - `std::runtime_error` if document is null or is not a valid BSON document.
+   */
+  void addDocument(const bson::Document& document);
+
   wire::Message toMessage(ObjectMapper* commandObjectMapper) override;
 
 };
@@ -0,0 +1,102 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "WorkerPool.hpp"
+
+namespace oatpp { namespace mongo { namespace driver { namespace command {
+
+WorkerPool::WorkerPool(v_int32 threadsCount)
+  : m_stopped(false)
+{
+
+  if(threadsCount <= 0) {
+    threadsCount = (v_int32) std::thread::hardware_concurrency();
+  }
+  if(threadsCount <= 0) {
+    threadsCount = 1;
+  }
+
+  m_threads.reserve(threadsCount);
+  for(v_int32 i = 0; i < threadsCount; i ++) {
+    m_threads.push_back(std::thread(&WorkerPool::run, this));
+  }
+
+}
+
+WorkerPool::~WorkerPool() {
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopped = true;
+  }
+  m_condition.notify_all();
+
+  for(auto& thread : m_threads) {
+    thread.join();
+  }
+
+}
+
+void WorkerPool::run() {
+
+  while(true) {
+
+    std::function<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      while(!m_stopped && m_tasks.empty()) {
+        m_condition.wait(lock);
+      }
+      if(m_tasks.empty()) {
+        return;
+      }
+      task = std::move(m_tasks.front());
+      m_tasks.pop_front();
+    }
+
+    try {
+      task();
+    } catch (...) {
+      // tasks are responsible to report their own errors
+    }
+
+  }
+
+}
+
+v_int32 WorkerPool::getThreadsCount() const {
+  return (v_int32) m_threads.size();
+}
+
+void WorkerPool::execute(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push_back(std::move(task));
+  }
+  m_condition.notify_one();
+}
+
+}}}}
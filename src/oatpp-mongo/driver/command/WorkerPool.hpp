@@ -0,0 +1,90 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_mongo_driver_command_WorkerPool_hpp
+#define oatpp_mongo_driver_command_WorkerPool_hpp
+
+#include "oatpp/Types.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace mongo { namespace driver { namespace command {
+
+/**
+ * Fixed-size pool of long-lived worker threads. <br>
+ * Threads are started in the constructor and joined in the destructor.
+ * Tasks are executed in the order of submission.
+ */
+class WorkerPool {
+private:
+  void run();
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::list<std::function<void()>> m_tasks;
+  bool m_stopped;
+  std::vector<std::thread> m_threads;
+public:
+
+  /**
+   * Constructor. Starts worker threads.
+   * @param threadsCount - number of threads. If `<= 0` - `std::thread::hardware_concurrency()` is used.
+   */
+  WorkerPool(v_int32 threadsCount = 0);
+
+  /**
+   * Non-copyable.
+   */
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  /**
+   * Destructor. Waits for already submitted tasks to finish and joins worker threads.
+   */
+  ~WorkerPool();
+
+  /**
+   * Get number of worker threads.
+   * @return
+   */
+  v_int32 getThreadsCount() const;
+
+  /**
+   * Submit task for execution. <br>
+   * Task must not throw - exceptions escaping the task are swallowed.
+   * @param task
+   */
+  void execute(std::function<void()> task);
+
+};
+
+}}}}
+
+#endif // oatpp_mongo_driver_command_WorkerPool_hpp
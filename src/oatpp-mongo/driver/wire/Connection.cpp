@@ -24,6 +24,7 @@
  ***************************************************************************/
 
 #include "Connection.hpp"
+#include "OpMsg.hpp"
 
 #include "oatpp-mongo/bson/Utils.hpp"
 #include "oatpp/data/stream/BufferStream.hpp"
@@ -32,10 +33,23 @@ namespace oatpp { namespace mongo { namespace driver { namespace wire {
 
 Connection::Connection(const provider::ResourceHandle<data::stream::IOStream>& connection)
   : m_connection(connection)
+  , m_broken(false)
 {}
 
+void Connection::checkUsable(const char* method) const {
+  if(m_broken) {
+    throw std::runtime_error(std::string("[oatpp::mongo::driver::wire::Connection::") + method + "()]: Error. Connection is broken.");
+  }
+}
+
+bool Connection::isBroken() const {
+  return m_broken;
+}
+
 v_io_size Connection::write(const Message& message) {
 
+  checkUsable("write");
+
   if(message.header.messageLength != 16 + message.data->size()) {
     throw std::runtime_error("[oatpp::mongo::driver::wire::Connection::write()]: Error. Invalid message header.");
   }
@@ -60,10 +74,15 @@ v_io_size Connection::write(const Message& message) {
 
 v_io_size Connection::read(Message& message) {
 
+  checkUsable("read");
+
   const v_buff_size headerSize = 16;
   v_char8 headerDataBuffer[headerSize];
   auto res1 = m_connection.object->readExactSizeDataSimple(headerDataBuffer, headerSize);
   if(res1 != headerSize) {
+    if(res1 > 0) {
+      m_broken = true;
+    }
     return res1;
   }
 
@@ -73,6 +92,10 @@ v_io_size Connection::read(Message& message) {
   oatpp::String dataBuffer(message.header.messageLength - headerSize);
   auto res2 = m_connection.object->readExactSizeDataSimple((void*)dataBuffer->data(), dataBuffer->size());
 
+  if(res2 < (v_io_size) dataBuffer->size()) {
+    m_broken = true;
+  }
+
   if(res2 < 0) {
     return res2;
   }
@@ -83,5 +106,95 @@ v_io_size Connection::read(Message& message) {
 
 }
 
+constexpr v_buff_size Connection::STREAM_CHUNK_SIZE;
+
+v_io_size Connection::drain(v_int64 remaining) {
+
+  /* skip the rest of the message to keep the stream positioned at the next message header */
+
+  v_io_size progress = 0;
+
+  while(remaining > 0) {
+    v_buff_size chunkSize = remaining < STREAM_CHUNK_SIZE ? (v_buff_size) remaining : STREAM_CHUNK_SIZE;
+    auto res = m_connection.object->readExactSizeDataSimple(m_chunkBuffer.data(), chunkSize);
+    if(res < chunkSize) {
+      m_broken = true;
+      return res < 0 ? progress : progress + res;
+    }
+    progress += res;
+    remaining -= res;
+  }
+
+  return progress;
+
+}
+
+v_io_size Connection::read(MessageHeader& header, OpMsgStreamParser& parser) {
+
+  checkUsable("read");
+
+  const v_buff_size headerSize = 16;
+  v_char8 headerDataBuffer[headerSize];
+  auto res1 = m_connection.object->readExactSizeDataSimple(headerDataBuffer, headerSize);
+  if(res1 != headerSize) {
+    if(res1 > 0) {
+      m_broken = true;
+    }
+    return res1;
+  }
+
+  utils::parser::Caret caret((const char*)headerDataBuffer, headerSize);
+  header.readFromCaret(caret);
+
+  if(header.opCode != OpMsg::OP_CODE || header.messageLength < headerSize) {
+    m_broken = true; // message body is unread and its size can't be trusted
+    throw std::runtime_error("[oatpp::mongo::driver::wire::Connection::read()]: Error. Not an OP_MSG message.");
+  }
+
+  v_int64 remaining = header.messageLength - headerSize;
+  parser.reset(remaining);
+
+  m_chunkBuffer.resize(STREAM_CHUNK_SIZE);
+  v_io_size progress = res1;
+
+  while(remaining > 0 && !parser.hasError()) {
+
+    v_buff_size chunkSize = remaining < STREAM_CHUNK_SIZE ? (v_buff_size) remaining : STREAM_CHUNK_SIZE;
+    auto res = m_connection.object->readExactSizeDataSimple(m_chunkBuffer.data(), chunkSize);
+    if(res < 0) {
+      m_broken = true;
+      return res;
+    }
+
+    progress += res;
+    remaining -= res;
+
+    try {
+      parser.feed(m_chunkBuffer.data(), res);
+    } catch (...) {
+      /* document callback has thrown - keep the stream positioned at the next message header */
+      if(res < chunkSize) {
+        m_broken = true;
+      } else {
+        drain(remaining);
+      }
+      throw;
+    }
+
+    if(res < chunkSize) {
+      m_broken = true;
+      return progress;
+    }
+
+  }
+
+  if(remaining > 0) {
+    progress += drain(remaining);
+  }
+
+  return progress;
+
+}
+
 }}}}
 
@@ -27,17 +27,30 @@
 #define oatpp_mongo_driver_wire_Connection_hpp
 
 #include "./Message.hpp"
+#include "./OpMsgStreamParser.hpp"
 #include "oatpp/provider/Provider.hpp"
 #include "oatpp/data/stream/Stream.hpp"
 
+#include <vector>
+
 namespace oatpp { namespace mongo { namespace driver { namespace wire {
 
 /**
  * MongoDB connection.
  */
 class Connection {
+public:
+  /**
+   * Size of the chunk read from the stream and fed to &id:oatpp::mongo::driver::wire::OpMsgStreamParser;.
+   */
+  static constexpr v_buff_size STREAM_CHUNK_SIZE = 16 * 1024;
+private:
+  void checkUsable(const char* method) const;
+  v_io_size drain(v_int64 remaining);
 private:
   provider::ResourceHandle<data::stream::IOStream> m_connection;
+  std::vector<v_char8> m_chunkBuffer;
+  bool m_broken;
 public:
 
   Connection(const provider::ResourceHandle<data::stream::IOStream>& connection);
@@ -45,6 +58,27 @@ public:
   v_io_size write(const Message& message);
   v_io_size read(Message& message);
 
+  /**
+   * Read OP_MSG message streaming its body through the parser chunk by chunk. <br>
+   * The message body is never held in memory as a whole - documents are emitted by the parser as they arrive.
+   * Check `parser.isFinished()` and `parser.hasError()` for the parsing result. <br>
+   * On a parsing error, or if the document callback throws, the rest of the message is read and discarded,
+   * so the connection stays usable. Exception of the callback is rethrown.
+   * If the message can't be read to its end, the connection is marked broken - see &l:Connection::isBroken ();.
+   * @param header - &id:oatpp::mongo::driver::wire::MessageHeader; of the read message.
+   * @param parser - &id:oatpp::mongo::driver::wire::OpMsgStreamParser;.
+   * @return - number of bytes read or an error code of the stream.
+   * @throws - `std::runtime_error` if message is not an OP_MSG, or the connection is broken.
+   * Rethrows exception of the document callback.
+   */
+  v_io_size read(MessageHeader& header, OpMsgStreamParser& parser);
+
+  /**
+   * Check if the connection lost its position in the stream (the message was read partially). <br>
+   * Broken connection can't be used anymore - its reads and writes throw.
+   * @return
+   */
+  bool isBroken() const;
 
 };
 
@@ -119,7 +119,7 @@ void DocumentSequenceSection::writeToStream(data::stream::ConsistentOutputStream
 
   v_int32 size = 4 + identifier->size() + 1;
   for(auto& doc : documents) {
-    size += doc->size();
+    size += doc.getSize();
   }
   bson::Utils::writeInt32(stream, size);
 
@@ -127,7 +127,7 @@ void DocumentSequenceSection::writeToStream(data::stream::ConsistentOutputStream
   stream->writeCharSimple(0);
 
   for(auto& doc : documents) {
-    *stream << doc;
+    stream->writeSimple(doc.getData(), doc.getSize());
   }
 
 }
@@ -152,6 +152,8 @@ bool DocumentSequenceSection::readFromCaret(utils::parser::Caret& caret) {
 
     progress += identifier->size() + 1;
 
+    std::shared_ptr<std::string> memoryHandle = caret.getDataMemoryHandle();
+
     while(caret.canContinue() && progress < overallSize) {
 
       auto label = caret.putLabel();
@@ -161,10 +163,16 @@ bool DocumentSequenceSection::readFromCaret(utils::parser::Caret& caret) {
         return false;
       }
       caret.inc((v_buff_size) docSize - 4);
-      oatpp::String document = label.toString();
-      documents.push_back(document);
+      label.end();
+
+      /* slice the message buffer if it's ref-counted, copy otherwise */
+      if(memoryHandle) {
+        documents.push_back(bson::type::Document(data::share::MemoryLabel(memoryHandle, label.getData(), label.getSize())));
+      } else {
+        documents.push_back(bson::type::Document(label.toString()));
+      }
 
-      progress += document->size();
+      progress += docSize;
 
     }
 
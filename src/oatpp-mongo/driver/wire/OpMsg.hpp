@@ -26,6 +26,8 @@
 #ifndef oatpp_mongo_driver_wire_OpMsg_hpp
 #define oatpp_mongo_driver_wire_OpMsg_hpp
 
+#include "oatpp-mongo/bson/type/Document.hpp"
+
 #include "oatpp/data/stream/Stream.hpp"
 #include "oatpp/utils/parser/Caret.hpp"
 #include "oatpp/Types.hpp"
@@ -106,7 +108,10 @@ public:
 
   oatpp::String identifier;
 
-  std::list<oatpp::String> documents;
+  /**
+   * Documents of the sequence. Read documents are views of the message buffer if it's ref-counted.
+   */
+  std::list<bson::type::Document> documents;
 
 public:
 
@@ -0,0 +1,588 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "OpMsgStreamParser.hpp"
+#include "OpMsg.hpp"
+
+#include "oatpp-mongo/bson/Utils.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace mongo { namespace driver { namespace wire {
+
+namespace {
+
+  v_int32 tokenToInt32(const std::string& token) {
+    utils::parser::Caret caret(token.data(), token.size());
+    return bson::Utils::readInt32(caret);
+  }
+
+  v_int64 tokenToInt64(const std::string& token) {
+    utils::parser::Caret caret(token.data(), token.size());
+    return bson::Utils::readInt64(caret);
+  }
+
+  v_float64 tokenToFloat64(const std::string& token) {
+    utils::parser::Caret caret(token.data(), token.size());
+    return bson::Utils::readFloat64(caret);
+  }
+
+}
+
+OpMsgStreamParser::OpMsgStreamParser(const DocumentCallback& callback)
+  : m_callback(callback)
+{
+  reset(0);
+}
+
+void OpMsgStreamParser::reset(v_int64 bodySize) {
+
+  m_state = STATE_FLAGS;
+  m_errorMessage = nullptr;
+
+  m_bodySize = bodySize;
+  m_sectionsEnd = bodySize;
+  m_position = 0;
+  m_need = 4;
+  m_token.clear();
+
+  m_frames.clear();
+  m_pendingFrameKind = FRAME_ROOT;
+  m_elementType = 0;
+  m_valueTarget = TARGET_OK;
+  m_skipExtra = 0;
+  m_cstringsToSkip = 0;
+
+  m_inSequence = false;
+  m_sequenceEnd = 0;
+
+  m_document = nullptr;
+  m_documentFill = 0;
+
+  m_checksumPresent = false;
+  m_sequenceIdentifier = nullptr;
+  m_cursorId = 0;
+  m_namespace = nullptr;
+  m_ok = 0;
+  m_documentsCount = 0;
+
+}
+
+void OpMsgStreamParser::setError(const char* message) {
+  m_state = STATE_ERROR;
+  m_errorMessage = message;
+}
+
+void OpMsgStreamParser::expect(State state, v_int64 size) {
+  m_state = state;
+  m_need = size;
+  m_token.clear();
+}
+
+v_int64 OpMsgStreamParser::getFrameEnd() const {
+  if(m_frames.empty()) {
+    return m_sectionsEnd;
+  }
+  return m_frames.back().end;
+}
+
+bool OpMsgStreamParser::checkBounds(v_int64 size) {
+  /* element must end before the terminating '\0' of the document */
+  if(size < 0 || m_position + size > getFrameEnd() - 1) {
+    setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::checkBounds()]: Error. Element exceeds document bounds.");
+    return false;
+  }
+  return true;
+}
+
+void OpMsgStreamParser::onToken() {
+
+  switch(m_state) {
+
+    case STATE_FLAGS: {
+      v_int32 flags = tokenToInt32(m_token);
+      m_checksumPresent = (flags & OpMsg::FLAG_CHECKSUM_PRESENT) > 0;
+      m_sectionsEnd = m_bodySize - (m_checksumPresent ? 4 : 0);
+      if(m_position >= m_sectionsEnd) {
+        setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::onToken()]: Error. Message has no sections.");
+        return;
+      }
+      expect(STATE_SECTION_KIND, 1);
+      return;
+    }
+
+    case STATE_SECTION_KIND: {
+      v_uint8 kind = (v_uint8) m_token[0];
+      if(kind == Section::TYPE_BODY) {
+        m_inSequence = false;
+        m_pendingFrameKind = FRAME_ROOT;
+        expect(STATE_DOCUMENT_SIZE, 4);
+      } else if(kind == Section::TYPE_DOCUMENT_SEQUENCE) {
+        expect(STATE_SEQUENCE_SIZE, 4);
+      } else {
+        setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::onToken()]: Error. Invalid section type.");
+      }
+      return;
+    }
+
+    case STATE_SEQUENCE_SIZE: {
+      v_int32 size = tokenToInt32(m_token);
+      m_sequenceEnd = m_position - 4 + size;
+      if(size < 5 || m_sequenceEnd > m_sectionsEnd) {
+        setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::onToken()]: Error. Invalid Sequence size.");
+        return;
+      }
+      m_inSequence = true;
+      expect(STATE_SEQUENCE_IDENTIFIER, 0);
+      return;
+    }
+
+    case STATE_SEQUENCE_IDENTIFIER: {
+      m_sequenceIdentifier = oatpp::String(m_token.data(), m_token.size());
+      if(m_position > m_sequenceEnd) {
+        setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::onToken()]: Error. Invalid Sequence identifier.");
+      } else if(m_position == m_sequenceEnd) {
+        m_inSequence = false;
+        afterSection();
+      } else {
+        expect(STATE_EMIT_SIZE, 4);
+      }
+      return;
+    }
+
+    case STATE_DOCUMENT_SIZE: {
+      v_int32 size = tokenToInt32(m_token);
+      v_int64 end = m_position - 4 + size;
+      v_int64 limit = m_frames.empty() ? m_sectionsEnd : m_frames.back().end - 1;
+      if(size < 5 || end > limit) {
+        setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::onToken()]: Error. Invalid document size.");
+        return;
+      }
+      Frame frame;
+      frame.kind = m_pendingFrameKind;
+      frame.end = end;
+      m_frames.push_back(frame);
+      expect(STATE_ELEMENT_TYPE, 1);
+      return;
+    }
+
+    case STATE_ELEMENT_TYPE: {
+      v_char8 typeCode = (v_char8) m_token[0];
+      if(typeCode == 0) {
+        if(m_position != m_frames.back().end) {
+          setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::onToken()]: Error. Unexpected document terminator.");
+          return;
+        }
+        m_frames.pop_back();
+        afterValue();
+        return;
+      }
+      if(m_position >= m_frames.back().end) {
+        setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::onToken()]: Error. Document is not terminated.");
+        return;
+      }
+      m_elementType = typeCode;
+      expect(STATE_ELEMENT_KEY, 0);
+      return;
+    }
+
+    case STATE_ELEMENT_KEY:
+      onKey();
+      return;
+
+    case STATE_VALUE: {
+      if(m_valueTarget == TARGET_CURSOR_ID) {
+        m_cursorId = tokenToInt64(m_token);
+      } else if(m_elementType == bson::TypeCode::INT_32) {
+        m_ok = tokenToInt32(m_token);
+      } else if(m_elementType == bson::TypeCode::INT_64) {
+        m_ok = (v_float64) tokenToInt64(m_token);
+      } else {
+        m_ok = tokenToFloat64(m_token);
+      }
+      afterValue();
+      return;
+    }
+
+    case STATE_STRING_SIZE: {
+      v_int32 size = tokenToInt32(m_token);
+      if(size < 1 || !checkBounds(size)) {
+        setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::onToken()]: Error. Invalid string size.");
+        return;
+      }
+      expect(STATE_STRING, size);
+      return;
+    }
+
+    case STATE_STRING: {
+      if(m_token[m_token.size() - 1] != 0) {
+        setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::onToken()]: Error. String is not terminated.");
+        return;
+      }
+      m_namespace = oatpp::String(m_token.data(), m_token.size() - 1);
+      afterValue();
+      return;
+    }
+
+    case STATE_SKIP_SIZE: {
+      v_int64 size = (v_int64) tokenToInt32(m_token) + m_skipExtra;
+      if(!checkBounds(size)) {
+        return;
+      }
+      if(size == 0) {
+        afterValue();
+      } else {
+        expect(STATE_SKIP, size);
+      }
+      return;
+    }
+
+    case STATE_EMIT_SIZE: {
+      v_int32 size = tokenToInt32(m_token);
+      v_int64 end = m_position - 4 + size;
+      v_int64 limit = m_inSequence ? m_sequenceEnd : m_frames.back().end - 1;
+      if(size < 5 || end > limit) {
+        setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::onToken()]: Error. Invalid document size.");
+        return;
+      }
+      m_document = oatpp::String((v_buff_size) size);
+      std::memcpy((void*) m_document->data(), m_token.data(), 4);
+      m_documentFill = 4;
+      m_state = STATE_EMIT;
+      m_need = size - 4;
+      return;
+    }
+
+    case STATE_CHECKSUM:
+      m_state = STATE_FINISHED;
+      return;
+
+    default:
+      setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::onToken()]: Error. Invalid state.");
+      return;
+
+  }
+
+}
+
+void OpMsgStreamParser::onKey() {
+
+  const v_char8 typeCode = m_elementType;
+
+  switch(m_frames.back().kind) {
+
+    case FRAME_ROOT:
+      if(typeCode == bson::TypeCode::DOCUMENT_EMBEDDED && m_token == "cursor") {
+        m_pendingFrameKind = FRAME_CURSOR;
+        expect(STATE_DOCUMENT_SIZE, 4);
+        return;
+      }
+      if(m_token == "ok" && (typeCode == bson::TypeCode::DOUBLE || typeCode == bson::TypeCode::INT_32 || typeCode == bson::TypeCode::INT_64)) {
+        v_int64 size = (typeCode == bson::TypeCode::INT_32) ? 4 : 8;
+        if(checkBounds(size)) {
+          m_valueTarget = TARGET_OK;
+          expect(STATE_VALUE, size);
+        }
+        return;
+      }
+      break;
+
+    case FRAME_CURSOR:
+      if(typeCode == bson::TypeCode::DOCUMENT_ARRAY && (m_token == "firstBatch" || m_token == "nextBatch")) {
+        m_pendingFrameKind = FRAME_BATCH;
+        expect(STATE_DOCUMENT_SIZE, 4);
+        return;
+      }
+      if(typeCode == bson::TypeCode::INT_64 && m_token == "id") {
+        if(checkBounds(8)) {
+          m_valueTarget = TARGET_CURSOR_ID;
+          expect(STATE_VALUE, 8);
+        }
+        return;
+      }
+      if(typeCode == bson::TypeCode::STRING && m_token == "ns") {
+        expect(STATE_STRING_SIZE, 4);
+        return;
+      }
+      break;
+
+    case FRAME_BATCH:
+      if(typeCode != bson::TypeCode::DOCUMENT_EMBEDDED) {
+        setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::onKey()]: Error. Batch item is not a document.");
+        return;
+      }
+      expect(STATE_EMIT_SIZE, 4);
+      return;
+
+  }
+
+  skipValue();
+
+}
+
+void OpMsgStreamParser::skipValue() {
+
+  v_int64 size = 0;
+
+  switch(m_elementType) {
+
+    case bson::TypeCode::UNDEFINED:
+    case bson::TypeCode::NULL_VALUE:
+    case bson::TypeCode::MIN_KEY:
+    case bson::TypeCode::MAX_KEY:
+      afterValue();
+      return;
+
+    case bson::TypeCode::BOOLEAN: size = 1; break;
+    case bson::TypeCode::INT_32: size = 4; break;
+
+    case bson::TypeCode::DOUBLE:
+    case bson::TypeCode::DATE_TIME:
+    case bson::TypeCode::TIMESTAMP:
+    case bson::TypeCode::INT_64: size = 8; break;
+
+    case bson::TypeCode::OBJECT_ID: size = 12; break;
+    case bson::TypeCode::DECIMAL_128: size = 16; break;
+
+    case bson::TypeCode::STRING:
+    case bson::TypeCode::JAVASCRIPT_CODE:
+    case bson::TypeCode::SYMBOL:
+      m_skipExtra = 0;
+      expect(STATE_SKIP_SIZE, 4);
+      return;
+
+    case bson::TypeCode::BINARY:
+      m_skipExtra = 1;
+      expect(STATE_SKIP_SIZE, 4);
+      return;
+
+    case bson::TypeCode::BD_POINTER:
+      m_skipExtra = 12;
+      expect(STATE_SKIP_SIZE, 4);
+      return;
+
+    case bson::TypeCode::DOCUMENT_EMBEDDED:
+    case bson::TypeCode::DOCUMENT_ARRAY:
+    case bson::TypeCode::JAVASCRIPT_CODE_WS:
+      m_skipExtra = -4;
+      expect(STATE_SKIP_SIZE, 4);
+      return;
+
+    case bson::TypeCode::REGEXP:
+      m_cstringsToSkip = 2;
+      expect(STATE_SKIP_CSTRING, 0);
+      return;
+
+    default:
+      setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::skipValue()]: Error. Unknown element type-code.");
+      return;
+
+  }
+
+  if(checkBounds(size)) {
+    expect(STATE_SKIP, size);
+  }
+
+}
+
+void OpMsgStreamParser::afterValue() {
+  if(m_frames.empty()) {
+    afterSection();
+  } else {
+    expect(STATE_ELEMENT_TYPE, 1);
+  }
+}
+
+void OpMsgStreamParser::afterSection() {
+  if(m_position == m_sectionsEnd) {
+    if(m_checksumPresent) {
+      expect(STATE_CHECKSUM, 4);
+    } else {
+      m_state = STATE_FINISHED;
+    }
+  } else if(m_position > m_sectionsEnd) {
+    setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::afterSection()]: Error. Section exceeds message bounds.");
+  } else {
+    expect(STATE_SECTION_KIND, 1);
+  }
+}
+
+void OpMsgStreamParser::afterEmit() {
+
+  if(m_document->data()[m_document->size() - 1] != 0) {
+    setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::afterEmit()]: Error. Document is not terminated.");
+    return;
+  }
+
+  oatpp::String document = m_document;
+  m_document = nullptr;
+  m_documentsCount ++;
+
+  /* move to the next state first - the callback is user code and may throw */
+
+  if(m_inSequence) {
+    if(m_position == m_sequenceEnd) {
+      m_inSequence = false;
+      afterSection();
+    } else {
+      expect(STATE_EMIT_SIZE, 4);
+    }
+  } else {
+    afterValue();
+  }
+
+  try {
+    m_callback(document);
+  } catch (...) {
+    setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::afterEmit()]: Error. Document callback has thrown.");
+    throw;
+  }
+
+}
+
+v_buff_size OpMsgStreamParser::feed(const void* data, v_buff_size size) {
+
+  const v_char8* bytes = (const v_char8*) data;
+
+  v_buff_size available = size;
+  if(m_bodySize - m_position < available) {
+    available = (v_buff_size) (m_bodySize - m_position);
+  }
+
+  v_buff_size i = 0;
+
+  while(i < available && m_state != STATE_FINISHED && m_state != STATE_ERROR) {
+
+    const v_buff_size rest = available - i;
+
+    switch(m_state) {
+
+      case STATE_SKIP: {
+        v_buff_size n = m_need < rest ? (v_buff_size) m_need : rest;
+        i += n;
+        m_position += n;
+        m_need -= n;
+        if(m_need == 0) {
+          afterValue();
+        }
+        break;
+      }
+
+      case STATE_EMIT: {
+        v_buff_size n = m_need < rest ? (v_buff_size) m_need : rest;
+        std::memcpy((char*) m_document->data() + m_documentFill, &bytes[i], n);
+        m_documentFill += n;
+        i += n;
+        m_position += n;
+        m_need -= n;
+        if(m_need == 0) {
+          afterEmit();
+        }
+        break;
+      }
+
+      case STATE_SKIP_CSTRING:
+      case STATE_SEQUENCE_IDENTIFIER:
+      case STATE_ELEMENT_KEY: {
+        const v_char8* terminator = (const v_char8*) std::memchr(&bytes[i], 0, rest);
+        v_buff_size n = terminator ? (terminator - &bytes[i]) : rest;
+        if(m_state != STATE_SKIP_CSTRING) {
+          m_token.append((const char*) &bytes[i], n);
+        }
+        if(terminator) {
+          n ++;
+        }
+        i += n;
+        m_position += n;
+        if(terminator) {
+          if(m_state == STATE_SKIP_CSTRING) {
+            if(-- m_cstringsToSkip == 0) {
+              afterValue();
+            }
+          } else {
+            onToken();
+          }
+        }
+        break;
+      }
+
+      default: {
+        v_buff_size n = (v_buff_size) m_need - (v_buff_size) m_token.size();
+        if(n > rest) {
+          n = rest;
+        }
+        m_token.append((const char*) &bytes[i], n);
+        i += n;
+        m_position += n;
+        if((v_int64) m_token.size() == m_need) {
+          onToken();
+        }
+      }
+
+    }
+
+  }
+
+  if(m_position == m_bodySize && m_state != STATE_FINISHED && m_state != STATE_ERROR) {
+    setError("[oatpp::mongo::driver::wire::OpMsgStreamParser::feed()]: Error. Unexpected end of message.");
+  }
+
+  return i;
+
+}
+
+bool OpMsgStreamParser::isFinished() const {
+  return m_state == STATE_FINISHED;
+}
+
+bool OpMsgStreamParser::hasError() const {
+  return m_state == STATE_ERROR;
+}
+
+const char* OpMsgStreamParser::getErrorMessage() const {
+  return m_errorMessage;
+}
+
+oatpp::String OpMsgStreamParser::getSequenceIdentifier() const {
+  return m_sequenceIdentifier;
+}
+
+v_int64 OpMsgStreamParser::getCursorId() const {
+  return m_cursorId;
+}
+
+oatpp::String OpMsgStreamParser::getNamespace() const {
+  return m_namespace;
+}
+
+v_float64 OpMsgStreamParser::getOk() const {
+  return m_ok;
+}
+
+v_int64 OpMsgStreamParser::getDocumentsCount() const {
+  return m_documentsCount;
+}
+
+}}}}
@@ -0,0 +1,211 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#ifndef oatpp_mongo_driver_wire_OpMsgStreamParser_hpp
+#define oatpp_mongo_driver_wire_OpMsgStreamParser_hpp
+
+#include "oatpp/Types.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace oatpp { namespace mongo { namespace driver { namespace wire {
+
+/**
+ * Resumable push-parser of the OP_MSG body. <br>
+ * Accepts the message body in chunks as they arrive and emits documents one by one:
+ * <ul>
+ *   <li>Each document of &id:oatpp::mongo::driver::wire::DocumentSequenceSection;.</li>
+ *   <li>Each document of the `cursor.firstBatch` or `cursor.nextBatch` array of the body section.</li>
+ * </ul>
+ * Only the document being emitted is buffered, everything else is skipped as it arrives.
+ * So peak memory is about one document, not one message. <br>
+ * `cursor.id`, `cursor.ns`, and `ok` of the body section are captured.
+ */
+class OpMsgStreamParser {
+public:
+
+  /**
+   * Callback called for each completed document.
+   */
+  typedef std::function<void(const oatpp::String& document)> DocumentCallback;
+
+private:
+
+  enum State : v_int32 {
+    STATE_FLAGS,
+    STATE_SECTION_KIND,
+    STATE_SEQUENCE_SIZE,
+    STATE_SEQUENCE_IDENTIFIER,
+    STATE_DOCUMENT_SIZE,
+    STATE_ELEMENT_TYPE,
+    STATE_ELEMENT_KEY,
+    STATE_VALUE,
+    STATE_STRING_SIZE,
+    STATE_STRING,
+    STATE_SKIP_SIZE,
+    STATE_SKIP,
+    STATE_SKIP_CSTRING,
+    STATE_EMIT_SIZE,
+    STATE_EMIT,
+    STATE_CHECKSUM,
+    STATE_FINISHED,
+    STATE_ERROR
+  };
+
+  enum FrameKind : v_int32 {
+    FRAME_ROOT,
+    FRAME_CURSOR,
+    FRAME_BATCH
+  };
+
+  enum ValueTarget : v_int32 {
+    TARGET_CURSOR_ID,
+    TARGET_OK
+  };
+
+  struct Frame {
+    FrameKind kind;
+    v_int64 end;
+  };
+
+private:
+  void setError(const char* message);
+  void expect(State state, v_int64 size);
+  v_int64 getFrameEnd() const;
+  bool checkBounds(v_int64 size);
+  void onToken();
+  void onKey();
+  void skipValue();
+  void afterValue();
+  void afterSection();
+  void afterEmit();
+private:
+  DocumentCallback m_callback;
+  State m_state;
+  const char* m_errorMessage;
+
+  v_int64 m_bodySize;
+  v_int64 m_sectionsEnd;
+  v_int64 m_position;
+  v_int64 m_need;
+  std::string m_token;
+
+  std::vector<Frame> m_frames;
+  FrameKind m_pendingFrameKind;
+  v_char8 m_elementType;
+  ValueTarget m_valueTarget;
+  v_int32 m_skipExtra;
+  v_int32 m_cstringsToSkip;
+
+  bool m_inSequence;
+  v_int64 m_sequenceEnd;
+
+  oatpp::String m_document;
+  v_int64 m_documentFill;
+
+  bool m_checksumPresent;
+  oatpp::String m_sequenceIdentifier;
+  v_int64 m_cursorId;
+  oatpp::String m_namespace;
+  v_float64 m_ok;
+  v_int64 m_documentsCount;
+public:
+
+  /**
+   * Constructor.
+   * @param callback - called for each completed document.
+   */
+  OpMsgStreamParser(const DocumentCallback& callback);
+
+  /**
+   * Reset parser to start parsing new message.
+   * @param bodySize - size of the message without header. `messageLength - 16`.
+   */
+  void reset(v_int64 bodySize);
+
+  /**
+   * Feed next chunk of the message body.
+   * @param data - chunk data.
+   * @param size - chunk size.
+   * @return - number of bytes consumed. Less than `size` if message is finished or on error.
+   * @throws - rethrows exception of the document callback. The parser is left in the error state.
+   */
+  v_buff_size feed(const void* data, v_buff_size size);
+
+  /**
+   * Whole message was parsed successfully.
+   * @return
+   */
+  bool isFinished() const;
+
+  /**
+   * Check if error occurred.
+   * @return
+   */
+  bool hasError() const;
+
+  /**
+   * Get error message.
+   * @return - error message or `nullptr`.
+   */
+  const char* getErrorMessage() const;
+
+  /**
+   * Identifier of the last document sequence section.
+   * @return
+   */
+  oatpp::String getSequenceIdentifier() const;
+
+  /**
+   * `cursor.id` of the body section. `0` if not present.
+   * @return
+   */
+  v_int64 getCursorId() const;
+
+  /**
+   * `cursor.ns` of the body section.
+   * @return
+   */
+  oatpp::String getNamespace() const;
+
+  /**
+   * `ok` value of the body section. `0` if not present.
+   * @return
+   */
+  v_float64 getOk() const;
+
+  /**
+   * Number of documents emitted so far.
+   * @return
+   */
+  v_int64 getDocumentsCount() const;
+
+};
+
+}}}}
+
+#endif // oatpp_mongo_driver_wire_OpMsgStreamParser_hpp
@@ -0,0 +1,184 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "BinaryTest.hpp"
+
+#include "oatpp-mongo/bson/mapping/ObjectMapper.hpp"
+
+#include "oatpp/Types.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+namespace oatpp { namespace mongo { namespace test { namespace bson {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class ObjWithBinary : public oatpp::DTO {
+
+  DTO_INIT(ObjWithBinary, DTO)
+
+  DTO_FIELD(String, name) = "binary";
+  DTO_FIELD(oatpp::mongo::bson::Binary, data);
+  DTO_FIELD(oatpp::mongo::bson::Binary, embedding);
+
+};
+
+class ObjWithArray : public oatpp::DTO {
+
+  DTO_INIT(ObjWithArray, DTO)
+
+  DTO_FIELD(String, name) = "binary";
+  DTO_FIELD(Vector<Float32>, embedding);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+typedef oatpp::mongo::bson::type::Binary Binary;
+
+}
+
+void BinaryTest::onRun() {
+
+  oatpp::mongo::bson::mapping::ObjectMapper mapper;
+
+  {
+    OATPP_LOGI(TAG, "null binary...");
+    auto obj = ObjWithBinary::createShared();
+    auto clone = mapper.readFromString<oatpp::Object<ObjWithBinary>>(mapper.writeToString(obj));
+    OATPP_ASSERT(clone->name == "binary");
+    OATPP_ASSERT(!clone->data);
+    OATPP_ASSERT(!clone->embedding);
+    OATPP_LOGI(TAG, "null binary - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "binary from null string...");
+    Binary empty(Binary::USER_DEFINED, oatpp::String(nullptr));
+    OATPP_ASSERT(empty.getSubtype() == Binary::USER_DEFINED);
+    OATPP_ASSERT(empty.getSize() == 0);
+
+    auto obj = ObjWithBinary::createShared();
+    obj->data = empty;
+    auto clone = mapper.readFromString<oatpp::Object<ObjWithBinary>>(mapper.writeToString(obj));
+    OATPP_ASSERT(clone->data);
+    OATPP_ASSERT(clone->data->getSubtype() == Binary::USER_DEFINED);
+    OATPP_ASSERT(clone->data->getSize() == 0);
+    OATPP_LOGI(TAG, "binary from null string - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "zero-copy read and write...");
+
+    oatpp::String payload = "some binary payload";
+
+    auto obj = ObjWithBinary::createShared();
+    obj->data = Binary(Binary::USER_DEFINED, payload);
+    OATPP_ASSERT(obj->data->getData() == payload->data());
+
+    auto bson = mapper.writeToString(obj);
+    auto clone = mapper.readFromString<oatpp::Object<ObjWithBinary>>(bson);
+
+    OATPP_ASSERT(clone->data);
+    OATPP_ASSERT(clone->data->getSubtype() == Binary::USER_DEFINED);
+    OATPP_ASSERT(clone->data->toString() == payload);
+    OATPP_ASSERT(*clone->data == *obj->data);
+
+    /* binary points into the source buffer */
+    OATPP_ASSERT(clone->data->getData() > bson->data());
+    OATPP_ASSERT(clone->data->getData() + clone->data->getSize() < bson->data() + bson->size());
+    OATPP_ASSERT(clone->data->getLabel().getMemoryHandle() == bson.getPtr());
+
+    OATPP_ASSERT(mapper.writeToString(clone) == bson);
+
+    OATPP_LOGI(TAG, "zero-copy read and write - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "vector subtype...");
+
+    std::vector<v_float32> values;
+    for(v_int32 i = 0; i < 1536; i ++) {
+      values.push_back(i * 0.25f - 100);
+    }
+
+    auto obj = ObjWithBinary::createShared();
+    obj->embedding = Binary::createFloat32Vector(values.data(), (v_buff_size) values.size());
+
+    auto bson = mapper.writeToString(obj);
+    auto clone = mapper.readFromString<oatpp::Object<ObjWithBinary>>(bson);
+
+    OATPP_ASSERT(clone->embedding->getSubtype() == Binary::VECTOR);
+    OATPP_ASSERT(clone->embedding->isVector());
+    OATPP_ASSERT(clone->embedding->getVectorDType() == Binary::FLOAT32);
+    OATPP_ASSERT(!clone->embedding->asInt8Vector());
+
+    auto view = clone->embedding->asFloat32Vector();
+    OATPP_ASSERT(view);
+    OATPP_ASSERT(view.size() == 1536);
+    OATPP_ASSERT(view[0] == -100);
+    OATPP_ASSERT(view[1535] == 1535 * 0.25f - 100);
+    OATPP_ASSERT(view.toVector() == values);
+
+    /* same data as BSON array of doubles */
+    auto arrayObj = ObjWithArray::createShared();
+    arrayObj->embedding = oatpp::Vector<oatpp::Float32>::createShared();
+    for(auto v : values) {
+      arrayObj->embedding->push_back(v);
+    }
+    auto arrayBson = mapper.writeToString(arrayObj);
+    OATPP_LOGD(TAG, "binary vector document size=%ld, array document size=%ld", (long) bson->size(), (long) arrayBson->size());
+    OATPP_ASSERT(bson->size() * 3 < arrayBson->size());
+
+    std::vector<v_int8> bytes = {-128, -1, 0, 1, 127};
+    auto int8Vector = Binary::createInt8Vector(bytes.data(), (v_buff_size) bytes.size());
+    OATPP_ASSERT(int8Vector.asInt8Vector().toVector() == bytes);
+    OATPP_ASSERT(!int8Vector.asFloat32Vector());
+
+    std::vector<v_uint8> bits = {0xFF, 0x80};
+    auto bitVector = Binary::createPackedBitVector(bits.data(), 9);
+    OATPP_ASSERT(bitVector.getVectorPadding() == 7);
+    OATPP_ASSERT(bitVector.asPackedBitVector().toVector() == bits);
+
+    OATPP_LOGI(TAG, "vector subtype - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "binary in Any...");
+    auto fields = oatpp::Fields<oatpp::Any>::createShared();
+    fields->push_back({"bin", oatpp::Any(oatpp::mongo::bson::Binary(Binary(Binary::GENERIC, oatpp::String("abc"))))});
+    auto bson = mapper.writeToString(fields);
+    auto clone = mapper.readFromString<oatpp::Fields<oatpp::Any>>(bson);
+    auto binary = clone["bin"].retrieve<oatpp::mongo::bson::Binary>();
+    OATPP_ASSERT(binary);
+    OATPP_ASSERT(binary->toString() == "abc");
+    OATPP_ASSERT(mapper.writeToString(clone) == bson);
+    OATPP_LOGI(TAG, "binary in Any - OK");
+  }
+
+}
+
+}}}}
@@ -0,0 +1,286 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "BsonToJsonTest.hpp"
+
+#include "oatpp-mongo/bson/json/BsonToJson.hpp"
+#include "oatpp-mongo/bson/mapping/ObjectMapper.hpp"
+#include "oatpp-mongo/bson/Utils.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+
+#include "oatpp/Types.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+#include <clocale>
+#include <limits>
+#include <string>
+
+namespace oatpp { namespace mongo { namespace test { namespace bson {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Inner : public oatpp::DTO {
+
+  DTO_INIT(Inner, DTO)
+
+  DTO_FIELD(String, name) = "inner";
+
+};
+
+class Obj : public oatpp::DTO {
+
+  DTO_INIT(Obj, DTO)
+
+  DTO_FIELD(oatpp::mongo::bson::ObjectId, _id);
+  DTO_FIELD(String, str) = "say \"hi\"\n\ttab\\";
+  DTO_FIELD(Int32, i32) = -42;
+  DTO_FIELD(Int64, i64) = 1234567890123;
+  DTO_FIELD(Float64, f64) = 0.5;
+  DTO_FIELD(Float64, whole) = 2.0;
+  DTO_FIELD(Boolean, flag) = true;
+  DTO_FIELD(String, none);
+  DTO_FIELD(oatpp::mongo::bson::DateTime, date) = 1356351330501;
+  DTO_FIELD(List<Int32>, list) = {1, 2, 3};
+  DTO_FIELD(Object<Inner>, inner) = Inner::createShared();
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+typedef oatpp::mongo::bson::TypeCode TypeCode;
+
+std::string int32LE(v_int32 value) {
+  std::string result(4, '\0');
+  oatpp::mongo::bson::Utils::storeLE<v_int32>(&result[0], value);
+  return result;
+}
+
+std::string cstring(const std::string& value) {
+  return value + std::string(1, '\0');
+}
+
+std::string bsonString(const std::string& value) {
+  return int32LE((v_int32) value.size() + 1) + cstring(value);
+}
+
+std::string element(v_char8 typeCode, const std::string& key, const std::string& value) {
+  return std::string(1, (char) typeCode) + cstring(key) + value;
+}
+
+std::string document(const std::string& elements) {
+  return int32LE((v_int32) elements.size() + 5) + elements + std::string(1, '\0');
+}
+
+bool transcodeFails(const std::string& bson) {
+  try {
+    oatpp::mongo::bson::json::BsonToJson::transcodeToString(bson);
+  } catch (std::runtime_error&) {
+    return true;
+  }
+  return false;
+}
+
+}
+
+void BsonToJsonTest::onRun() {
+
+  typedef oatpp::mongo::bson::json::BsonToJson BsonToJson;
+
+  oatpp::mongo::bson::mapping::ObjectMapper bsonMapper;
+
+  auto obj = Obj::createShared();
+  obj->_id = oatpp::mongo::bson::type::ObjectId::fromString("5f0000010203040506070809");
+  auto bson = bsonMapper.writeToString(obj);
+
+  {
+    OATPP_LOGI(TAG, "Relaxed format...");
+    auto json = BsonToJson::transcodeToString(bson);
+    OATPP_LOGD(TAG, "json='%s'", json->c_str());
+    OATPP_ASSERT(json ==
+      "{\"_id\":{\"$oid\":\"5f0000010203040506070809\"},"
+      "\"str\":\"say \\\"hi\\\"\\n\\ttab\\\\\","
+      "\"i32\":-42,"
+      "\"i64\":1234567890123,"
+      "\"f64\":0.5,"
+      "\"whole\":2.0,"
+      "\"flag\":true,"
+      "\"none\":null,"
+      "\"date\":{\"$date\":\"2012-12-24T12:15:30.501Z\"},"
+      "\"list\":[1,2,3],"
+      "\"inner\":{\"name\":\"inner\"}}");
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Canonical format...");
+    BsonToJson::Options options;
+    options.format = BsonToJson::Format::CANONICAL;
+    auto json = BsonToJson::transcodeToString(bson, options);
+    OATPP_LOGD(TAG, "json='%s'", json->c_str());
+    OATPP_ASSERT(json ==
+      "{\"_id\":{\"$oid\":\"5f0000010203040506070809\"},"
+      "\"str\":\"say \\\"hi\\\"\\n\\ttab\\\\\","
+      "\"i32\":{\"$numberInt\":\"-42\"},"
+      "\"i64\":{\"$numberLong\":\"1234567890123\"},"
+      "\"f64\":{\"$numberDouble\":\"0.5\"},"
+      "\"whole\":{\"$numberDouble\":\"2.0\"},"
+      "\"flag\":true,"
+      "\"none\":null,"
+      "\"date\":{\"$date\":{\"$numberLong\":\"1356351330501\"}},"
+      "\"list\":[{\"$numberInt\":\"1\"},{\"$numberInt\":\"2\"},{\"$numberInt\":\"3\"}],"
+      "\"inner\":{\"name\":\"inner\"}}");
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Non-finite doubles...");
+    auto doubles = Obj::createShared();
+    doubles->f64 = std::numeric_limits<v_float64>::quiet_NaN();
+    doubles->whole = -std::numeric_limits<v_float64>::infinity();
+    auto json = BsonToJson::transcodeToString(bsonMapper.writeToString(doubles));
+    OATPP_ASSERT(json->find("\"f64\":{\"$numberDouble\":\"NaN\"}") != std::string::npos);
+    OATPP_ASSERT(json->find("\"whole\":{\"$numberDouble\":\"-Infinity\"}") != std::string::npos);
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Doubles don't depend on the locale...");
+    const char* locales[] = {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "ru_RU.UTF-8"};
+    std::string previous = std::setlocale(LC_NUMERIC, nullptr);
+    for(const char* locale : locales) {
+      if(std::setlocale(LC_NUMERIC, locale) != nullptr) {
+        OATPP_LOGD(TAG, "locale='%s'", locale);
+        auto json = BsonToJson::transcodeToString(bson);
+        OATPP_ASSERT(json->find("\"f64\":0.5,") != std::string::npos);
+        OATPP_ASSERT(json->find("\"whole\":2.0,") != std::string::npos);
+        break;
+      }
+    }
+    std::setlocale(LC_NUMERIC, previous.c_str());
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Special types...");
+
+    std::string objectId("\x5f\x00\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09", 12);
+
+    std::string decimal(16, '\0');
+    oatpp::mongo::bson::type::Decimal128::fromString("-1.23E+5").toBytes(&decimal[0]);
+
+    std::string code = bsonString("return x;");
+    std::string scope = document(element(TypeCode::INT_32, "x", int32LE(1)));
+
+    std::string elements =
+      element(TypeCode::BINARY, "bin", int32LE(5) + std::string(1, '\x80') + "hello") +
+      element(TypeCode::REGEXP, "re", cstring("^a\"b") + cstring("im")) +
+      element(TypeCode::TIMESTAMP, "ts", int32LE(7) + int32LE(1356351330)) +
+      element(TypeCode::DECIMAL_128, "dec", decimal) +
+      element(TypeCode::JAVASCRIPT_CODE, "code", bsonString("f()")) +
+      element(TypeCode::JAVASCRIPT_CODE_WS, "cws", int32LE((v_int32) (4 + code.size() + scope.size())) + code + scope) +
+      element(TypeCode::BD_POINTER, "ptr", bsonString("db.coll") + objectId) +
+      element(TypeCode::SYMBOL, "sym", bsonString("s")) +
+      element(TypeCode::UNDEFINED, "undef", "") +
+      element(TypeCode::MIN_KEY, "min", "") +
+      element(TypeCode::MAX_KEY, "max", "");
+
+    auto json = BsonToJson::transcodeToString(document(elements));
+    OATPP_LOGD(TAG, "json='%s'", json->c_str());
+    OATPP_ASSERT(json ==
+      "{\"bin\":{\"$binary\":{\"base64\":\"aGVsbG8=\",\"subType\":\"80\"}},"
+      "\"re\":{\"$regularExpression\":{\"pattern\":\"^a\\\"b\",\"options\":\"im\"}},"
+      "\"ts\":{\"$timestamp\":{\"t\":1356351330,\"i\":7}},"
+      "\"dec\":{\"$numberDecimal\":\"-1.23E+5\"},"
+      "\"code\":{\"$code\":\"f()\"},"
+      "\"cws\":{\"$code\":\"return x;\",\"$scope\":{\"x\":1}},"
+      "\"ptr\":{\"$dbPointer\":{\"$ref\":\"db.coll\",\"$id\":{\"$oid\":\"5f0000010203040506070809\"}}},"
+      "\"sym\":{\"$symbol\":\"s\"},"
+      "\"undef\":{\"$undefined\":true},"
+      "\"min\":{\"$minKey\":1},"
+      "\"max\":{\"$maxKey\":1}}");
+
+    BsonToJson::Options options;
+    options.format = BsonToJson::Format::CANONICAL;
+    auto canonical = BsonToJson::transcodeToString(document(elements), options);
+    OATPP_ASSERT(canonical->find("\"cws\":{\"$code\":\"return x;\",\"$scope\":{\"x\":{\"$numberInt\":\"1\"}}}") != std::string::npos);
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "String escaping...");
+    for(v_int32 size = 0; size < 40; size ++) {
+      for(v_int32 pos = 0; pos < size; pos ++) {
+        std::string str(size, 'a');
+        str[pos] = '\x1f';
+        oatpp::data::stream::BufferOutputStream stream;
+        BsonToJson::writeString(&stream, str.data(), str.size());
+        std::string expected = "\"" + str.substr(0, pos) + "\\u001f" + str.substr(pos + 1) + "\"";
+        OATPP_ASSERT(stream.toStdString() == expected);
+      }
+    }
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Malformed document...");
+    std::string truncated = *bson;
+    truncated.resize(truncated.size() - 10);
+    bool thrown = false;
+    try {
+      BsonToJson::transcodeToString(truncated);
+    } catch (std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+
+    std::string broken = *bson;
+    broken[4] = 0x42; // unknown type-code of the first element
+    oatpp::utils::parser::Caret caret(broken);
+    oatpp::data::stream::BufferOutputStream stream;
+    BsonToJson::transcode(caret, &stream);
+    OATPP_ASSERT(caret.hasError());
+
+    std::string nested = document(element(TypeCode::INT_32, "a", int32LE(1)));
+
+    /* nested document claims more bytes than it has */
+    std::string oversized = nested;
+    oversized[0] = (char) (nested.size() + 3);
+    OATPP_ASSERT(transcodeFails(document(element(TypeCode::DOCUMENT_EMBEDDED, "n", oversized) + element(TypeCode::INT_32, "b", int32LE(2)))));
+
+    /* nested document misses its terminator */
+    std::string unterminated = nested;
+    unterminated[unterminated.size() - 1] = 1;
+    OATPP_ASSERT(transcodeFails(document(element(TypeCode::DOCUMENT_EMBEDDED, "n", unterminated))));
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
+}
+
+}}}}
@@ -0,0 +1,157 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ByteOrderTest.hpp"
+
+#include "oatpp-mongo/bson/Utils.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace mongo { namespace test { namespace bson {
+
+namespace {
+
+typedef oatpp::mongo::bson::Utils Utils;
+
+const v_char8 INT32_BYTES[4] = {0x78, 0x56, 0x34, 0xF2};
+const v_char8 INT64_BYTES[8] = {0xEF, 0xCD, 0xAB, 0x89, 0x67, 0x45, 0x23, 0xF1};
+
+/* 1.5 as little-endian IEEE 754 double */
+const v_char8 FLOAT64_BYTES[8] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x3F};
+
+}
+
+void ByteOrderTest::onRun() {
+
+  {
+    OATPP_LOGI(TAG, "compile-time byte-order...");
+    OATPP_ASSERT(Utils::INT_BO == Utils::detectIntBO());
+    OATPP_ASSERT(Utils::FLOAT_BO == Utils::detectFloatBO());
+    OATPP_LOGI(TAG, "compile-time byte-order - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "unaligned load/store...");
+
+    v_char8 buffer[16];
+
+    for(v_int32 offset = 0; offset < 8; offset ++) {
+
+      std::memcpy(buffer + offset, INT32_BYTES, 4);
+      OATPP_ASSERT(Utils::loadLE<v_int32>(buffer + offset) == (v_int32) 0xF2345678);
+      OATPP_ASSERT(Utils::loadLE<v_uint32>(buffer + offset) == 0xF2345678);
+
+      std::memcpy(buffer + offset, INT64_BYTES, 8);
+      OATPP_ASSERT(Utils::loadLE<v_int64>(buffer + offset) == (v_int64) 0xF123456789ABCDEF);
+      OATPP_ASSERT(Utils::loadLE<v_uint64>(buffer + offset) == 0xF123456789ABCDEF);
+
+      std::memcpy(buffer + offset, FLOAT64_BYTES, 8);
+      OATPP_ASSERT(Utils::loadLE<v_float64>(buffer + offset) == 1.5);
+
+      std::memset(buffer, 0, sizeof(buffer));
+      Utils::storeLE<v_int32>(buffer + offset, (v_int32) 0xF2345678);
+      OATPP_ASSERT(std::memcmp(buffer + offset, INT32_BYTES, 4) == 0);
+
+      Utils::storeLE<v_int64>(buffer + offset, (v_int64) 0xF123456789ABCDEF);
+      OATPP_ASSERT(std::memcmp(buffer + offset, INT64_BYTES, 8) == 0);
+
+      Utils::storeLE<v_float64>(buffer + offset, 1.5);
+      OATPP_ASSERT(std::memcmp(buffer + offset, FLOAT64_BYTES, 8) == 0);
+
+    }
+
+    OATPP_LOGI(TAG, "unaligned load/store - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "stream codecs...");
+
+    oatpp::data::stream::BufferOutputStream stream;
+    stream.writeCharSimple(0); // shift everything by one byte
+    Utils::writeInt32(&stream, -2);
+    Utils::writeInt64(&stream, -3);
+    Utils::writeUInt64(&stream, 0xFFFFFFFFFFFFFFF0);
+    Utils::writeFloat64(&stream, -0.25);
+
+    auto data = stream.toString();
+    OATPP_ASSERT(data->size() == 1 + 4 + 8 + 8 + 8);
+
+    oatpp::utils::parser::Caret caret(data);
+    caret.inc();
+    OATPP_ASSERT(Utils::readInt32(caret) == -2);
+    OATPP_ASSERT(Utils::readInt64(caret) == -3);
+    OATPP_ASSERT(Utils::readUInt64(caret) == 0xFFFFFFFFFFFFFFF0);
+    OATPP_ASSERT(Utils::readFloat64(caret) == -0.25);
+    OATPP_ASSERT(!caret.hasError());
+    OATPP_ASSERT(caret.getPosition() == caret.getDataSize());
+
+    OATPP_LOGI(TAG, "stream codecs - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "truncated values...");
+
+    oatpp::utils::parser::Caret caret((const char*) INT64_BYTES, 3);
+    OATPP_ASSERT(Utils::readInt32(caret) == 0);
+    OATPP_ASSERT(caret.hasError());
+    OATPP_ASSERT(caret.getPosition() == 0);
+
+    oatpp::utils::parser::Caret caret2((const char*) FLOAT64_BYTES, 7);
+    OATPP_ASSERT(Utils::readFloat64(caret2) == 0);
+    OATPP_ASSERT(caret2.hasError());
+
+    OATPP_LOGI(TAG, "truncated values - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "read performance...");
+
+    const v_int32 count = 1024 * 1024;
+    std::string buffer;
+    buffer.resize(count * 8);
+    for(v_int32 i = 0; i < count; i ++) {
+      Utils::storeLE<v_int64>(&buffer[i * 8], (v_int64) i * 3);
+    }
+
+    v_int64 sum = 0;
+    {
+      oatpp::test::PerformanceChecker checker("readInt64 x 1M");
+      oatpp::utils::parser::Caret caret(buffer.data(), (v_buff_size) buffer.size());
+      for(v_int32 i = 0; i < count; i ++) {
+        sum += Utils::readInt64(caret);
+      }
+    }
+    OATPP_ASSERT(sum == (v_int64) count * (count - 1) / 2 * 3);
+
+    OATPP_LOGI(TAG, "read performance - OK");
+  }
+
+}
+
+}}}}
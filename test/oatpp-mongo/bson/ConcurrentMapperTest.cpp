@@ -0,0 +1,224 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ConcurrentMapperTest.hpp"
+
+#include "oatpp-mongo/bson/mapping/ObjectMapper.hpp"
+
+#include "oatpp/Types.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace mongo { namespace test { namespace bson {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Item : public oatpp::DTO {
+
+  DTO_INIT(Item, DTO)
+
+  DTO_FIELD(Int32, index);
+  DTO_FIELD(String, name);
+
+};
+
+class Batch : public oatpp::DTO {
+
+  DTO_INIT(Batch, DTO)
+
+  DTO_FIELD(Int64, id);
+  DTO_FIELD(List<Object<Item>>, items);
+  DTO_FIELD(Fields<Int32>, counters);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Object<Batch> createBatch(v_int64 id) {
+  auto batch = Batch::createShared();
+  batch->id = id;
+  batch->items = List<Object<Item>>::createShared();
+  batch->counters = Fields<Int32>::createShared();
+  for(v_int32 i = 0; i < 10; i ++) {
+    auto item = Item::createShared();
+    item->index = i;
+    item->name = oatpp::String("item_" + std::to_string(i));
+    batch->items->push_back(item);
+    batch->counters->push_back({item->name, i * 2});
+  }
+  return batch;
+}
+
+bool checkBatch(const oatpp::Object<Batch>& batch, v_int64 id) {
+  if(!batch || batch->id != id || !batch->items || batch->items->size() != 10 || !batch->counters || batch->counters->size() != 10) {
+    return false;
+  }
+  v_int32 i = 0;
+  for(auto& item : *batch->items) {
+    if(item->index != i || item->name != oatpp::String("item_" + std::to_string(i))) {
+      return false;
+    }
+    i ++;
+  }
+  return true;
+}
+
+}
+
+void ConcurrentMapperTest::onRun() {
+
+  {
+    OATPP_LOGI(TAG, "Frozen mapper rejects configuration...");
+
+    oatpp::mongo::bson::mapping::ObjectMapper mapper;
+    OATPP_ASSERT(!mapper.isFrozen());
+
+    mapper.getDeserializer()->enablePacked<oatpp::Vector<oatpp::Int32>>();
+    mapper.getSerializer()->enablePacked<oatpp::Vector<oatpp::Int32>>();
+    mapper.freeze();
+    OATPP_ASSERT(mapper.isFrozen());
+
+    bool thrown = false;
+    try {
+      mapper.getSerializer()->enablePacked<oatpp::Vector<oatpp::Int64>>();
+    } catch (std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+
+    thrown = false;
+    try {
+      mapper.getDeserializer()->enablePacked<oatpp::Vector<oatpp::Int64>>();
+    } catch (std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Method changed after use is picked up by decode plans...");
+
+    oatpp::mongo::bson::mapping::ObjectMapper mapper;
+    auto bson = mapper.writeToString(createBatch(1));
+    OATPP_ASSERT(checkBatch(mapper.readFromString<oatpp::Object<Batch>>(bson), 1));
+
+    mapper.getDeserializer()->setDeserializerMethod(oatpp::data::type::__class::Int64::CLASS_ID,
+      [](oatpp::mongo::bson::mapping::Deserializer*, oatpp::utils::parser::Caret& caret, const oatpp::Type* const, v_char8) -> oatpp::Void {
+        caret.inc(8);
+        return oatpp::Int64(42);
+      });
+
+    OATPP_ASSERT(checkBatch(mapper.readFromString<oatpp::Object<Batch>>(bson), 42));
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "One frozen mapper shared by threads...");
+
+    auto mapper = oatpp::mongo::bson::mapping::ObjectMapper::createShared();
+    mapper->freeze();
+
+    const v_int32 threadsCount = 8;
+    const v_int32 iterations = 1000;
+
+    std::atomic<v_int32> failures(0);
+    std::vector<std::thread> threads;
+
+    for(v_int32 t = 0; t < threadsCount; t ++) {
+      threads.push_back(std::thread([mapper, t, iterations, &failures] {
+        for(v_int32 i = 0; i < iterations; i ++) {
+          v_int64 id = (v_int64) t * iterations + i;
+          auto bson = mapper->writeToString(createBatch(id));
+          auto clone = mapper->readFromString<oatpp::Object<Batch>>(bson);
+          if(!checkBatch(clone, id)) {
+            failures ++;
+          }
+        }
+      }));
+    }
+
+    for(auto& thread : threads) {
+      thread.join();
+    }
+
+    OATPP_ASSERT(failures == 0);
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Interned keys are shared by threads...");
+
+    auto table = oatpp::mongo::bson::mapping::KeyInternTable::createShared();
+    auto deserializerConfig = oatpp::mongo::bson::mapping::Deserializer::Config::createShared();
+    deserializerConfig->keyInternTable = table;
+    auto mapper = std::make_shared<oatpp::mongo::bson::mapping::ObjectMapper>(
+      oatpp::mongo::bson::mapping::Serializer::Config::createShared(), deserializerConfig
+    );
+    mapper->freeze();
+
+    auto bson = mapper->writeToString(createBatch(1));
+
+    const v_int32 threadsCount = 8;
+    std::vector<const std::string*> keys(threadsCount, nullptr);
+    std::vector<std::thread> threads;
+
+    for(v_int32 t = 0; t < threadsCount; t ++) {
+      threads.push_back(std::thread([mapper, bson, t, &keys] {
+        for(v_int32 i = 0; i < 100; i ++) {
+          auto clone = mapper->readFromString<oatpp::Object<Batch>>(bson);
+          const std::string* key = clone->counters->front().first.get();
+          if(i > 0 && key != keys[t]) {
+            keys[t] = nullptr;
+            return;
+          }
+          keys[t] = key;
+        }
+      }));
+    }
+
+    for(auto& thread : threads) {
+      thread.join();
+    }
+
+    for(v_int32 t = 0; t < threadsCount; t ++) {
+      OATPP_ASSERT(keys[t] != nullptr);
+      OATPP_ASSERT(keys[t] == keys[0]);
+    }
+    OATPP_ASSERT(table->getKeysCount() == 10);
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
+}
+
+}}}}
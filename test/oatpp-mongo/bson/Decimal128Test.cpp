@@ -0,0 +1,201 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "Decimal128Test.hpp"
+
+#include "oatpp-mongo/bson/mapping/ObjectMapper.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include "oatpp/Types.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+#include <cstring>
+#include <limits>
+
+namespace oatpp { namespace mongo { namespace test { namespace bson {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Price : public oatpp::DTO {
+
+  DTO_INIT(Price, DTO)
+
+  DTO_FIELD(String, symbol);
+  DTO_FIELD(oatpp::mongo::bson::Decimal128, bid);
+  DTO_FIELD(oatpp::mongo::bson::Decimal128, ask);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+typedef oatpp::mongo::bson::type::Decimal128 Decimal128;
+
+void checkString(const char* text, const char* expected) {
+  Decimal128 value;
+  bool ok = Decimal128::tryParse(text, (v_buff_size) std::strlen(text), value);
+  if(expected == nullptr) {
+    OATPP_ASSERT(!ok);
+  } else {
+    OATPP_ASSERT(ok);
+    OATPP_ASSERT(value.toString() == expected);
+  }
+}
+
+}
+
+void Decimal128Test::onRun() {
+
+  {
+    OATPP_LOGI(TAG, "string conversions...");
+
+    checkString("1.0", "1.0");
+    checkString("0", "0");
+    checkString("-0", "-0");
+    checkString("0.00", "0.00");
+    checkString("123.45", "123.45");
+    checkString(".5", "0.5");
+    checkString("1e3", "1E+3");
+    checkString("0.000001", "0.000001");
+    checkString("0.0000001", "1E-7");
+    checkString("-1.23E-10", "-1.23E-10");
+    checkString("1234567890123456789012345678901234", "1234567890123456789012345678901234");
+    checkString("12345678901234567890123456789012340", "1.234567890123456789012345678901234E+34");
+    checkString("9.999999999999999999999999999999999E+6144", "9.999999999999999999999999999999999E+6144");
+    checkString("1E-6176", "1E-6176");
+    checkString("0E-7000", "0E-6176");
+    checkString("Infinity", "Infinity");
+    checkString("-inf", "-Infinity");
+    checkString("NaN", "NaN");
+
+    /* inexact or invalid */
+    checkString("12345678901234567890123456789012345", nullptr);
+    checkString("1E-6177", nullptr);
+    checkString("1.2.3", nullptr);
+    checkString("1e", nullptr);
+    checkString("abc", nullptr);
+    checkString("", nullptr);
+
+    /* BSON bytes of 1.0 */
+    auto one = Decimal128::fromString("1.0");
+    OATPP_ASSERT(one.getHigh() == 0x303E000000000000ULL);
+    OATPP_ASSERT(one.getLow() == 10);
+
+    OATPP_LOGI(TAG, "string conversions - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "scaled int64 conversions...");
+
+    v_int64 value;
+    OATPP_ASSERT(Decimal128::fromString("123.45").toScaledInt64(2, value) && value == 12345);
+    OATPP_ASSERT(Decimal128::fromString("123.4500").toScaledInt64(2, value) && value == 12345);
+    OATPP_ASSERT(Decimal128::fromString("-7").toScaledInt64(4, value) && value == -70000);
+    OATPP_ASSERT(Decimal128::fromString("-9223372036854775808").toScaledInt64(0, value) && value == std::numeric_limits<v_int64>::min());
+    OATPP_ASSERT(!Decimal128::fromString("123.45").toScaledInt64(1, value));
+    OATPP_ASSERT(!Decimal128::fromString("9223372036854775808").toScaledInt64(0, value));
+    OATPP_ASSERT(!Decimal128::nan().toScaledInt64(0, value));
+
+    OATPP_ASSERT(Decimal128::fromScaledInt64(-12345, 2).toString() == "-123.45");
+    OATPP_ASSERT(Decimal128::fromScaledInt64(100, 0).toString() == "100");
+
+    OATPP_LOGI(TAG, "scaled int64 conversions - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "double conversions...");
+
+    OATPP_ASSERT(Decimal128::fromString("123.45").toDouble() == 123.45);
+    OATPP_ASSERT(Decimal128::fromString("-0.1").toDouble() == -0.1);
+    OATPP_ASSERT(Decimal128::fromString("1.234567890123456789E+100").toDouble() == 1.234567890123456789E+100);
+
+    OATPP_ASSERT(Decimal128::fromDouble(0.1).toString() == "0.1");
+    OATPP_ASSERT(Decimal128::fromDouble(100).toString() == "100");
+    OATPP_ASSERT(Decimal128::fromDouble(-2.5e-300).toString() == "-2.5E-300");
+
+    const v_float64 values[] = {0.1, 123.45, 1e300, 3.141592653589793, 1.0 / 3};
+    for(v_float64 v : values) {
+      OATPP_ASSERT(Decimal128::fromDouble(v).toDouble() == v);
+    }
+
+    OATPP_LOGI(TAG, "double conversions - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "DTO field...");
+
+    oatpp::mongo::bson::mapping::ObjectMapper mapper;
+
+    auto price = Price::createShared();
+    price->symbol = "ABC";
+    price->bid = Decimal128::fromString("101.25");
+    auto bson = mapper.writeToString(price);
+
+    auto clone = mapper.readFromString<oatpp::Object<Price>>(bson);
+    OATPP_ASSERT(clone->symbol == "ABC");
+    OATPP_ASSERT(clone->bid->toString() == "101.25");
+    OATPP_ASSERT(!clone->ask);
+    OATPP_ASSERT(mapper.writeToString(clone) == bson);
+
+    auto any = mapper.readFromString<oatpp::Fields<oatpp::Any>>(bson);
+    OATPP_ASSERT(any["bid"].retrieve<oatpp::mongo::bson::Decimal128>()->toString() == "101.25");
+
+    OATPP_LOGI(TAG, "DTO field - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "conversions performance...");
+
+    const v_int32 count = 1000000;
+    v_int64 checksum = 0;
+
+    {
+      oatpp::test::PerformanceChecker checker("scaled int64 -> Decimal128 -> scaled int64");
+      for(v_int32 i = 0; i < count; i ++) {
+        v_int64 value;
+        Decimal128::fromScaledInt64(i, 2).toScaledInt64(4, value);
+        checksum += value;
+      }
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("Decimal128 -> string -> Decimal128");
+      for(v_int32 i = 0; i < count; i ++) {
+        auto str = Decimal128::fromScaledInt64(i, 2).toString();
+        Decimal128 value;
+        Decimal128::tryParse(str->data(), (v_buff_size) str->size(), value);
+        checksum += (v_int64) value.getLow();
+      }
+    }
+
+    OATPP_ASSERT(checksum != 0);
+    OATPP_LOGI(TAG, "conversions performance - OK");
+  }
+
+}
+
+}}}}
@@ -0,0 +1,217 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "DecodePlanTest.hpp"
+
+#include "oatpp-mongo/bson/mapping/ObjectMapper.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include "oatpp/Types.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace mongo { namespace test { namespace bson {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Sub : public oatpp::DTO {
+
+  DTO_INIT(Sub, DTO)
+
+  DTO_FIELD(String, name);
+  DTO_FIELD(List<Int32>, values);
+
+};
+
+class Obj : public oatpp::DTO {
+
+  DTO_INIT(Obj, DTO)
+
+  DTO_FIELD(String, str);
+  DTO_FIELD(Int32, i32);
+  DTO_FIELD(Int64, i64);
+  DTO_FIELD(Float64, f64);
+  DTO_FIELD(Boolean, b);
+  DTO_FIELD(Object<Sub>, sub);
+  DTO_FIELD(Fields<String>, map);
+
+};
+
+/* Some fields of Obj - in different order, and of different types */
+class Shuffled : public oatpp::DTO {
+
+  DTO_INIT(Shuffled, DTO)
+
+  DTO_FIELD(Object<Sub>, sub);
+  DTO_FIELD(Any, i64);
+  DTO_FIELD(String, str);
+  DTO_FIELD(Int32, unknown) = 7;
+  DTO_FIELD(Int32, i32);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+typedef oatpp::mongo::bson::mapping::ObjectMapper ObjectMapper;
+typedef oatpp::mongo::bson::mapping::Serializer Serializer;
+typedef oatpp::mongo::bson::mapping::Deserializer Deserializer;
+
+oatpp::Object<Obj> createObj(v_int32 index) {
+  auto obj = Obj::createShared();
+  obj->str = "obj_" + std::to_string(index);
+  obj->i32 = index;
+  obj->i64 = (v_int64) index * 1000;
+  obj->f64 = index * 0.25;
+  obj->b = (index % 2) == 0;
+  obj->sub = Sub::createShared();
+  obj->sub->name = "sub";
+  obj->sub->values = oatpp::List<oatpp::Int32>::createShared();
+  obj->sub->values->push_back(index);
+  obj->sub->values->push_back(index + 1);
+  obj->map = oatpp::Fields<oatpp::String>::createShared();
+  obj->map->push_back({"key", "value"});
+  return obj;
+}
+
+std::shared_ptr<ObjectMapper> createMapper(bool useDecodePlans) {
+  auto config = Deserializer::Config::createShared();
+  config->useDecodePlans = useDecodePlans;
+  return std::make_shared<ObjectMapper>(Serializer::Config::createShared(), config);
+}
+
+}
+
+void DecodePlanTest::onRun() {
+
+  auto mapper = createMapper(true);
+  auto genericMapper = createMapper(false);
+
+  {
+    OATPP_LOGI(TAG, "fields in order...");
+    auto bson = mapper->writeToString(createObj(10));
+    auto obj = mapper->readFromString<oatpp::Object<Obj>>(bson);
+    OATPP_ASSERT(obj->str == "obj_10");
+    OATPP_ASSERT(obj->i32 == 10);
+    OATPP_ASSERT(obj->i64 == 10000);
+    OATPP_ASSERT(obj->f64 == 2.5);
+    OATPP_ASSERT(obj->b == true);
+    OATPP_ASSERT(obj->sub->name == "sub");
+    OATPP_ASSERT(obj->sub->values->size() == 2);
+    OATPP_ASSERT(obj->map->size() == 1);
+    OATPP_ASSERT(mapper->writeToString(obj) == bson);
+    OATPP_LOGI(TAG, "fields in order - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "shuffled fields and unexpected type-codes...");
+    auto bson = mapper->writeToString(createObj(10));
+
+    /* Any field has no expected type-code - it's read by the generic path */
+    auto obj = mapper->readFromString<oatpp::Object<Shuffled>>(bson);
+    auto genericObj = genericMapper->readFromString<oatpp::Object<Shuffled>>(bson);
+
+    OATPP_ASSERT(obj->str == "obj_10");
+    OATPP_ASSERT(obj->i32 == 10);
+    OATPP_ASSERT(obj->i64.retrieve<oatpp::Int64>() == 10000);
+    OATPP_ASSERT(obj->unknown == 7);
+    OATPP_ASSERT(obj->sub->values->size() == 2);
+    OATPP_ASSERT(mapper->writeToString(obj) == genericMapper->writeToString(genericObj));
+    OATPP_LOGI(TAG, "shuffled fields and unexpected type-codes - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "null fields...");
+    auto obj = Obj::createShared();
+    obj->i32 = 1;
+    auto bson = mapper->writeToString(obj);
+    auto result = mapper->readFromString<oatpp::Object<Obj>>(bson);
+    OATPP_ASSERT(result->i32 == 1);
+    OATPP_ASSERT(!result->str);
+    OATPP_ASSERT(!result->sub);
+    OATPP_ASSERT(!result->map);
+    OATPP_LOGI(TAG, "null fields - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "decode plan vs generic path...");
+
+    auto list = oatpp::List<oatpp::Object<Obj>>::createShared();
+    for(v_int32 i = 0; i < 1000; i ++) {
+      list->push_back(createObj(i));
+    }
+    auto bson = mapper->writeToString(list);
+
+    OATPP_ASSERT(mapper->writeToString(mapper->readFromString<oatpp::List<oatpp::Object<Obj>>>(bson)) == bson);
+    OATPP_ASSERT(genericMapper->writeToString(genericMapper->readFromString<oatpp::List<oatpp::Object<Obj>>>(bson)) == bson);
+
+    const v_int32 iterations = 100;
+
+    {
+      oatpp::test::PerformanceChecker checker("decode plan");
+      for(v_int32 i = 0; i < iterations; i ++) {
+        mapper->readFromString<oatpp::List<oatpp::Object<Obj>>>(bson);
+      }
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("generic path");
+      for(v_int32 i = 0; i < iterations; i ++) {
+        genericMapper->readFromString<oatpp::List<oatpp::Object<Obj>>>(bson);
+      }
+    }
+
+    OATPP_LOGI(TAG, "decode plan vs generic path - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "concurrent plan compilation...");
+
+    auto sharedMapper = createMapper(true);
+    auto bson = sharedMapper->writeToString(createObj(5));
+
+    std::vector<std::thread> threads;
+    for(v_int32 t = 0; t < 8; t ++) {
+      threads.push_back(std::thread([sharedMapper, bson] {
+        for(v_int32 i = 0; i < 100; i ++) {
+          auto obj = sharedMapper->readFromString<oatpp::Object<Obj>>(bson);
+          OATPP_ASSERT(obj->i32 == 5);
+          OATPP_ASSERT(obj->sub->values->size() == 2);
+        }
+      }));
+    }
+    for(auto& thread : threads) {
+      thread.join();
+    }
+
+    OATPP_LOGI(TAG, "concurrent plan compilation - OK");
+  }
+
+}
+
+}}}}
@@ -0,0 +1,178 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "DocumentTest.hpp"
+
+#include "oatpp-mongo/driver/wire/OpMsg.hpp"
+#include "oatpp-mongo/bson/mapping/ObjectMapper.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/Types.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+namespace oatpp { namespace mongo { namespace test { namespace bson {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Inner : public oatpp::DTO {
+
+  DTO_INIT(Inner, DTO)
+
+  DTO_FIELD(String, name) = "inner";
+  DTO_FIELD(Int32, value) = 42;
+
+};
+
+class Outer : public oatpp::DTO {
+
+  DTO_INIT(Outer, DTO)
+
+  DTO_FIELD(String, f1) = "Hello";
+  DTO_FIELD(oatpp::mongo::bson::Document, document);
+  DTO_FIELD(String, f2) = "World";
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+}
+
+void DocumentTest::onRun() {
+
+  oatpp::mongo::bson::mapping::ObjectMapper bsonMapper;
+
+  auto innerBson = bsonMapper.writeToString(Inner::createShared());
+
+  {
+    OATPP_LOGI(TAG, "Test null field...");
+    auto obj = Outer::createShared();
+    auto bson = bsonMapper.writeToString(obj);
+    auto clone = bsonMapper.readFromString<oatpp::Object<Outer>>(bson);
+    OATPP_ASSERT(clone);
+    OATPP_ASSERT(!clone->document);
+    OATPP_ASSERT(clone->f1 == obj->f1);
+    OATPP_ASSERT(clone->f2 == obj->f2);
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Test field round-trip...");
+    auto obj = Outer::createShared();
+    obj->document = oatpp::mongo::bson::type::Document(innerBson);
+    OATPP_ASSERT(obj->document->getData() == innerBson->data());
+
+    auto bson = bsonMapper.writeToString(obj);
+    auto clone = bsonMapper.readFromString<oatpp::Object<Outer>>(bson);
+
+    OATPP_ASSERT(clone);
+    OATPP_ASSERT(clone->f1 == obj->f1);
+    OATPP_ASSERT(clone->f2 == obj->f2);
+    OATPP_ASSERT(clone->document);
+    OATPP_ASSERT(clone->document->isValid());
+    OATPP_ASSERT(*clone->document == *obj->document);
+
+    /* the field is a view of the source buffer - no copy */
+    OATPP_ASSERT(clone->document->getBuffer().get() == bson.getPtr().get());
+    OATPP_ASSERT(clone->document->getData() == bson->data() + clone->document->getOffset());
+
+    auto inner = bsonMapper.readFromString<oatpp::Object<Inner>>(clone->document->toString());
+    OATPP_ASSERT(inner);
+    OATPP_ASSERT(inner->name == "inner");
+    OATPP_ASSERT(inner->value == 42);
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Test root document...");
+    auto document = bsonMapper.readFromString<oatpp::mongo::bson::Document>(innerBson);
+    OATPP_ASSERT(document);
+    OATPP_ASSERT(document->getOffset() == 0);
+    OATPP_ASSERT(document->getSize() == (v_buff_size) innerBson->size());
+    OATPP_ASSERT(bsonMapper.writeToString(document) == innerBson);
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Test slice...");
+    auto buffer = std::make_shared<std::string>("xyz" + *innerBson + "abc");
+    oatpp::mongo::bson::type::Document document(buffer, 3, innerBson->size());
+    OATPP_ASSERT(document.isValid());
+    OATPP_ASSERT(document.getBuffer() == buffer);
+    OATPP_ASSERT(document.toString() == innerBson);
+
+    oatpp::mongo::bson::type::Document shifted(buffer, 2, innerBson->size());
+    OATPP_ASSERT(!shifted.isValid());
+
+    bool thrown = false;
+    try {
+      oatpp::mongo::bson::type::Document outOfBounds(buffer, 4, innerBson->size());
+    } catch (std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Test invalid document...");
+    auto obj = Outer::createShared();
+    obj->document = oatpp::mongo::bson::type::Document(oatpp::String("not a document"));
+    bool thrown = false;
+    try {
+      bsonMapper.writeToString(obj);
+    } catch (std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Test document sequence...");
+    oatpp::mongo::driver::wire::DocumentSequenceSection sequence("documents");
+    sequence.documents.push_back(oatpp::mongo::bson::type::Document(innerBson));
+    sequence.documents.push_back(oatpp::mongo::bson::type::Document(innerBson));
+
+    oatpp::data::stream::BufferOutputStream stream;
+    sequence.writeToStream(&stream);
+    auto data = stream.toString();
+
+    oatpp::utils::parser::Caret caret(data);
+    oatpp::mongo::driver::wire::DocumentSequenceSection clone(nullptr);
+    OATPP_ASSERT(clone.readFromCaret(caret));
+    OATPP_ASSERT(clone.identifier == "documents");
+    OATPP_ASSERT(clone.documents.size() == 2);
+    for(auto& document : clone.documents) {
+      OATPP_ASSERT(document == sequence.documents.front());
+      OATPP_ASSERT(document.getBuffer().get() == data.getPtr().get());
+    }
+    OATPP_LOGI(TAG, "OK");
+  }
+
+}
+
+}}}}
@@ -102,7 +102,7 @@ void InlineDocumentTest::onRun() {
     auto inlineBson = bsonMapper.writeToString(inlineObj);
 
     auto obj = ObjWithInlineDocument::createShared();
-    obj->inlineDocument = oatpp::mongo::bson::InlineDocument(inlineBson.getPtr());
+    obj->inlineDocument = oatpp::mongo::bson::InlineDocument(inlineBson);
 
     auto bson = bsonMapper.writeToString(obj);
     auto clone = bsonMapper.readFromString<oatpp::Object<ObjWithInlineDocument>>(bson);
@@ -112,7 +112,7 @@ void InlineDocumentTest::onRun() {
     OATPP_ASSERT(clone->inlineDocument);
     OATPP_ASSERT(clone->f2 == obj->f2);
 
-    auto inlineClone = bsonMapper.readFromString<oatpp::Object<ObjWithInlineDocument>>(clone->inlineDocument.getPtr());
+    auto inlineClone = bsonMapper.readFromString<oatpp::Object<ObjWithInlineDocument>>(clone->inlineDocument.toString());
 
     OATPP_ASSERT(inlineClone);
     OATPP_ASSERT(inlineClone->f1 == inlineObj->f1);
@@ -127,7 +127,7 @@ void InlineDocumentTest::onRun() {
     auto inlineBson = bsonMapper.writeToString(inlineArr);
 
     auto obj = ObjWithInlineArray::createShared();
-    obj->inlineArray = oatpp::mongo::bson::InlineArray(inlineBson.getPtr());
+    obj->inlineArray = oatpp::mongo::bson::InlineArray(inlineBson);
 
     auto bson = bsonMapper.writeToString(obj);
     auto clone = bsonMapper.readFromString<oatpp::Object<ObjWithInlineArray>>(bson);
@@ -137,7 +137,7 @@ void InlineDocumentTest::onRun() {
     OATPP_ASSERT(clone->inlineArray);
     OATPP_ASSERT(clone->f2 == obj->f2);
 
-    auto inlineClone = bsonMapper.readFromString<oatpp::List<oatpp::Object<InlineObj>>>(clone->inlineArray.getPtr());
+    auto inlineClone = bsonMapper.readFromString<oatpp::List<oatpp::Object<InlineObj>>>(clone->inlineArray.toString());
 
     OATPP_ASSERT(inlineClone);
     OATPP_ASSERT(inlineClone->size() == 1);
@@ -149,6 +149,33 @@ void InlineDocumentTest::onRun() {
 
   }
 
+  {
+    OATPP_LOGI(TAG, "Zero-copy passthrough...");
+
+    auto inlineObj = InlineObj::createShared();
+    auto inlineBson = bsonMapper.writeToString(inlineObj);
+
+    auto obj = ObjWithInlineDocument::createShared();
+    obj->inlineDocument = oatpp::mongo::bson::InlineDocument(inlineBson);
+    OATPP_ASSERT(obj->inlineDocument.getData() == inlineBson->data());
+
+    auto bson = bsonMapper.writeToString(obj);
+    auto clone = bsonMapper.readFromString<oatpp::Object<ObjWithInlineDocument>>(bson);
+
+    OATPP_ASSERT(clone->inlineDocument);
+    OATPP_ASSERT(clone->inlineDocument.getSize() == inlineBson->size());
+
+    /* inline document points into the source buffer */
+    OATPP_ASSERT(clone->inlineDocument.getData() > bson->data());
+    OATPP_ASSERT(clone->inlineDocument.getData() + clone->inlineDocument.getSize() < bson->data() + bson->size());
+    OATPP_ASSERT(clone->inlineDocument->getMemoryHandle() == bson.getPtr());
+
+    /* and is written back untouched */
+    OATPP_ASSERT(bsonMapper.writeToString(clone) == bson);
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
 }
 
 }}}}
\ No newline at end of file
@@ -0,0 +1,271 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "JsonToBsonTest.hpp"
+
+#include "oatpp-mongo/bson/json/JsonToBson.hpp"
+#include "oatpp-mongo/bson/json/BsonToJson.hpp"
+#include "oatpp-mongo/bson/mapping/ObjectMapper.hpp"
+#include "oatpp-mongo/bson/Validator.hpp"
+
+#include "oatpp/Types.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+#include <clocale>
+#include <string>
+
+namespace oatpp { namespace mongo { namespace test { namespace bson {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Inner : public oatpp::DTO {
+
+  DTO_INIT(Inner, DTO)
+
+  DTO_FIELD(String, name);
+
+};
+
+class Obj : public oatpp::DTO {
+
+  DTO_INIT(Obj, DTO)
+
+  DTO_FIELD(oatpp::mongo::bson::ObjectId, _id);
+  DTO_FIELD(String, str);
+  DTO_FIELD(Int32, i32);
+  DTO_FIELD(Int64, i64);
+  DTO_FIELD(Float64, f64);
+  DTO_FIELD(Boolean, flag);
+  DTO_FIELD(String, none) = "not null";
+  DTO_FIELD(oatpp::mongo::bson::DateTime, date);
+  DTO_FIELD(oatpp::mongo::bson::Decimal128, decimal);
+  DTO_FIELD(List<Int32>, list);
+  DTO_FIELD(Object<Inner>, inner);
+
+};
+
+class Envelope : public oatpp::DTO {
+
+  DTO_INIT(Envelope, DTO)
+
+  DTO_FIELD(String, name);
+  DTO_FIELD(oatpp::mongo::bson::JsonDocument, payload);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+bool throws(const char* json) {
+  try {
+    oatpp::mongo::bson::json::JsonToBson::transcodeToString(json);
+  } catch (std::runtime_error&) {
+    return true;
+  }
+  return false;
+}
+
+}
+
+void JsonToBsonTest::onRun() {
+
+  typedef oatpp::mongo::bson::json::JsonToBson JsonToBson;
+  typedef oatpp::mongo::bson::json::BsonToJson BsonToJson;
+
+  oatpp::mongo::bson::mapping::ObjectMapper bsonMapper;
+
+  {
+    OATPP_LOGI(TAG, "JSON to DTO through BSON...");
+
+    auto bson = JsonToBson::transcodeToString(
+      "{ \"_id\": {\"$oid\": \"5f0000010203040506070809\"},\n"
+      "  \"str\": \"say \\\"hi\\\" \\u00e9\\ud83d\\ude00\",\n"
+      "  \"i32\": -42,\n"
+      "  \"i64\": 1234567890123,\n"
+      "  \"f64\": 0.5,\n"
+      "  \"flag\": true,\n"
+      "  \"none\": null,\n"
+      "  \"date\": {\"$date\": \"2012-12-24T12:15:30.501Z\"},\n"
+      "  \"decimal\": {\"$numberDecimal\": \"1.23\"},\n"
+      "  \"list\": [1, 2, 3],\n"
+      "  \"inner\": {\"name\": \"inner\"} }"
+    );
+
+    OATPP_ASSERT(oatpp::mongo::bson::Validator::validate(bson).valid);
+
+    auto obj = bsonMapper.readFromString<oatpp::Object<Obj>>(bson);
+    OATPP_ASSERT(obj);
+    OATPP_ASSERT(obj->_id);
+    OATPP_ASSERT(obj->_id->toString() == "5f0000010203040506070809");
+    OATPP_ASSERT(obj->str == "say \"hi\" \xc3\xa9\xf0\x9f\x98\x80");
+    OATPP_ASSERT(obj->i32 == -42);
+    OATPP_ASSERT(obj->i64 == 1234567890123);
+    OATPP_ASSERT(obj->f64 == 0.5);
+    OATPP_ASSERT(obj->flag == true);
+    OATPP_ASSERT(!obj->none);
+    OATPP_ASSERT(obj->date == 1356351330501);
+    OATPP_ASSERT(obj->decimal);
+    OATPP_ASSERT(*obj->decimal == oatpp::mongo::bson::type::Decimal128::fromString("1.23"));
+    OATPP_ASSERT(obj->list);
+    OATPP_ASSERT(obj->list->size() == 3);
+    OATPP_ASSERT(obj->inner);
+    OATPP_ASSERT(obj->inner->name == "inner");
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Canonical Extended JSON round-trip...");
+
+    oatpp::String json =
+      "{\"_id\":{\"$oid\":\"5f0000010203040506070809\"},"
+      "\"i32\":{\"$numberInt\":\"-42\"},"
+      "\"i64\":{\"$numberLong\":\"5\"},"
+      "\"f64\":{\"$numberDouble\":\"-Infinity\"},"
+      "\"date\":{\"$date\":{\"$numberLong\":\"-1\"}},"
+      "\"decimal\":{\"$numberDecimal\":\"1.23\"},"
+      "\"list\":[{\"$numberInt\":\"1\"},[],{}],"
+      "\"update\":{\"$set\":{\"a\":null}}}";
+
+    BsonToJson::Options options;
+    options.format = BsonToJson::Format::CANONICAL;
+    auto clone = BsonToJson::transcodeToString(JsonToBson::transcodeToString(json), options);
+    OATPP_ASSERT(clone == json);
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Extended JSON disabled...");
+    JsonToBson::Options options;
+    options.extendedJson = false;
+    auto json = BsonToJson::transcodeToString(JsonToBson::transcodeToString("{\"a\":{\"$numberLong\":\"5\"}}", options));
+    OATPP_ASSERT(json == "{\"a\":{\"$numberLong\":\"5\"}}");
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Numbers...");
+    auto json = BsonToJson::transcodeToString(JsonToBson::transcodeToString(
+      "{\"a\":2147483647,\"b\":-2147483649,\"c\":-9223372036854775808,\"d\":9223372036854775808,\"e\":-3e2}"
+    ));
+    OATPP_ASSERT(json == "{\"a\":2147483647,\"b\":-2147483649,\"c\":-9223372036854775808,\"d\":9.223372036854776e+18,\"e\":-300.0}");
+
+    json = BsonToJson::transcodeToString(JsonToBson::transcodeToString(
+      "{\"a\":0.1,\"b\":-12.375e-1,\"c\":1E+2,\"d\":{\"$numberDouble\":\"2.5\"},\"e\":{\"$numberDouble\":\"-1.0E-3\"}}"
+    ));
+    OATPP_ASSERT(json == "{\"a\":0.1,\"b\":-1.2375,\"c\":100.0,\"d\":2.5,\"e\":-0.001}");
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Numbers don't depend on the locale...");
+    const char* locales[] = {"de_DE.UTF-8", "de_DE.utf8", "fr_FR.UTF-8", "ru_RU.UTF-8"};
+    std::string previous = std::setlocale(LC_NUMERIC, nullptr);
+    for(const char* locale : locales) {
+      if(std::setlocale(LC_NUMERIC, locale) != nullptr) {
+        OATPP_LOGD(TAG, "locale='%s'", locale);
+        auto json = BsonToJson::transcodeToString(JsonToBson::transcodeToString("{\"a\":0.5,\"b\":{\"$numberDouble\":\"1.25\"}}"));
+        OATPP_ASSERT(json == "{\"a\":0.5,\"b\":1.25}");
+        break;
+      }
+    }
+    std::setlocale(LC_NUMERIC, previous.c_str());
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Dates...");
+    OATPP_ASSERT(!throws("{\"a\":{\"$date\":\"2012-02-29T00:00:00Z\"}}"));
+    OATPP_ASSERT(!throws("{\"a\":{\"$date\":\"2000-02-29T00:00:00Z\"}}"));
+    OATPP_ASSERT(!throws("{\"a\":{\"$date\":\"2012-12-31T23:59:59Z\"}}"));
+    OATPP_ASSERT(throws("{\"a\":{\"$date\":\"2013-02-29T00:00:00Z\"}}"));
+    OATPP_ASSERT(throws("{\"a\":{\"$date\":\"1900-02-29T00:00:00Z\"}}"));
+    OATPP_ASSERT(throws("{\"a\":{\"$date\":\"2012-04-31T00:00:00Z\"}}"));
+    OATPP_ASSERT(throws("{\"a\":{\"$date\":\"2012-02-30T00:00:00Z\"}}"));
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "JsonDocument through ObjectMapper...");
+
+    oatpp::String payload = "{\"a\":1,\"b\":[true,null],\"c\":{\"$numberLong\":\"5\"}}";
+
+    /* root object - same bytes as the standalone transcoder */
+    OATPP_ASSERT(bsonMapper.writeToString(oatpp::mongo::bson::JsonDocument(payload)) == JsonToBson::transcodeToString(payload));
+
+    auto envelope = Envelope::createShared();
+    envelope->name = "envelope";
+    envelope->payload = payload;
+
+    auto bson = bsonMapper.writeToString(envelope);
+    OATPP_ASSERT(oatpp::mongo::bson::Validator::validate(bson).valid);
+
+    auto clone = bsonMapper.readFromString<oatpp::Object<Envelope>>(bson);
+    OATPP_ASSERT(clone->name == "envelope");
+    OATPP_ASSERT(clone->payload);
+    OATPP_ASSERT(clone->payload.toString() == "{\"a\":1,\"b\":[true,null],\"c\":5}");
+    OATPP_ASSERT(bsonMapper.writeToString(clone) == bson);
+
+    const char* invalid[] = {"{\"a\":", "[1]", "{\"a\":1} {}"};
+    for(const char* json : invalid) {
+      envelope->payload = oatpp::String(json);
+      bool thrown = false;
+      try {
+        bsonMapper.writeToString(envelope);
+      } catch (const std::runtime_error&) {
+        thrown = true;
+      }
+      OATPP_ASSERT(thrown);
+    }
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Malformed JSON...");
+    OATPP_ASSERT(throws("[1, 2]"));
+    OATPP_ASSERT(throws("{\"a\":[1,]}"));
+    OATPP_ASSERT(throws("{\"a\":1,}"));
+    OATPP_ASSERT(throws("{\"a\" 1}"));
+    OATPP_ASSERT(throws("{\"a\":01}"));
+    OATPP_ASSERT(throws("{\"a\":tru}"));
+    OATPP_ASSERT(throws("{\"a\":\"unterminated"));
+    OATPP_ASSERT(throws("{\"a\":\"\\ud800\"}"));
+    OATPP_ASSERT(throws("{\"a\\u0000\":1}"));
+    OATPP_ASSERT(throws("{\"a\":{\"$oid\":\"123\"}}"));
+    OATPP_ASSERT(throws("{\"a\":{\"$oid\":\"5f0000010203040506070809\",\"b\":1}}"));
+    OATPP_ASSERT(throws("{\"a\":{\"$date\":\"2012-13-01T00:00:00Z\"}}"));
+    OATPP_ASSERT(throws("{\"a\":1"));
+    OATPP_ASSERT(throws("{\"a\":{\"$numberDouble\":\"0x10\"}}"));
+    OATPP_ASSERT(throws("{\"a\":{\"$numberDouble\":\"1.5 \"}}"));
+    OATPP_ASSERT(throws("{\"a\":{\"$numberDouble\":\"1e\"}}"));
+    OATPP_LOGI(TAG, "OK");
+  }
+
+}
+
+}}}}
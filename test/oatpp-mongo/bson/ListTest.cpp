@@ -312,6 +312,99 @@ void ListTest::onRun() {
     OATPP_LOGI(TAG, "OK");
   }
 
+  {
+    OATPP_LOGI(TAG, "Large array keys...");
+
+    auto list = oatpp::List<oatpp::Int32>::createShared();
+    for(v_int32 i = 0; i < 1200; i ++) {
+      list->push_back(i);
+    }
+
+    auto bson = bsonMapper.writeToString(list);
+
+    auto deserializerConfig = oatpp::mongo::bson::mapping::Deserializer::Config::createShared();
+    deserializerConfig->trustArrayKeys = true;
+    oatpp::mongo::bson::mapping::ObjectMapper trustingMapper(oatpp::mongo::bson::mapping::Serializer::Config::createShared(), deserializerConfig);
+
+    auto result = bsonMapper.readFromString<oatpp::List<oatpp::Int32>>(bson);
+    auto trustedResult = trustingMapper.readFromString<oatpp::List<oatpp::Int32>>(bson);
+
+    OATPP_ASSERT(result->size() == 1200);
+    OATPP_ASSERT(trustedResult->size() == 1200);
+
+    v_int32 i = 0;
+    for(auto it = result->begin(), trustedIt = trustedResult->begin(); it != result->end(); ++it, ++trustedIt) {
+      OATPP_ASSERT(*it == i);
+      OATPP_ASSERT(*trustedIt == i);
+      i ++;
+    }
+
+    std::string corrupted = *bson;
+    auto pos = corrupted.find(std::string("\x10" "100\0", 5));
+    OATPP_ASSERT(pos != std::string::npos);
+    corrupted[pos + 3] = '1';
+
+    {
+      oatpp::utils::parser::Caret caret(corrupted.data(), corrupted.size());
+      oatpp::data::mapping::ErrorStack errorStack;
+      bsonMapper.read(caret, oatpp::List<oatpp::Int32>::Class::getType(), errorStack);
+      OATPP_ASSERT(caret.hasError());
+    }
+
+    {
+      oatpp::utils::parser::Caret caret(corrupted.data(), corrupted.size());
+      oatpp::data::mapping::ErrorStack errorStack;
+      auto trusted = trustingMapper.read(caret, oatpp::List<oatpp::Int32>::Class::getType(), errorStack);
+      OATPP_ASSERT(!caret.hasError());
+      OATPP_ASSERT(trusted.cast<oatpp::List<oatpp::Int32>>()->size() == 1200);
+    }
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Vector capacity pre-sizing...");
+
+    auto vector = oatpp::Vector<oatpp::Int32>::createShared();
+    for(v_int32 i = 0; i < 50000; i ++) {
+      vector->push_back(i);
+    }
+
+    auto bson = bsonMapper.writeToString(vector);
+    auto result = bsonMapper.readFromString<oatpp::Vector<oatpp::Int32>>(bson);
+
+    OATPP_ASSERT(result->size() == 50000);
+    OATPP_ASSERT(result->capacity() == 50000);
+    for(v_int32 i = 0; i < 50000; i ++) {
+      OATPP_ASSERT(result[i] == i);
+    }
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Vector capacity pre-sizing - custom type...");
+
+    oatpp::mongo::bson::mapping::ObjectMapper mapper;
+    mapper.getDeserializer()->enableReserve<oatpp::Vector<oatpp::Vector<oatpp::String>>>();
+
+    auto vector = oatpp::Vector<oatpp::Vector<oatpp::String>>::createShared();
+    for(v_int32 i = 0; i < 100; i ++) {
+      auto inner = oatpp::Vector<oatpp::String>::createShared();
+      inner->push_back("item_" + std::to_string(i));
+      vector->push_back(inner);
+    }
+
+    auto bson = mapper.writeToString(vector);
+    auto result = mapper.readFromString<oatpp::Vector<oatpp::Vector<oatpp::String>>>(bson);
+
+    OATPP_ASSERT(result->size() == 100);
+    OATPP_ASSERT(result->capacity() == 100);
+    OATPP_ASSERT(result[99][0] == "item_99");
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
 }
 
 }}}}
\ No newline at end of file
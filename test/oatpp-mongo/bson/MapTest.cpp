@@ -262,6 +262,84 @@ void MapTest::onRun() {
 
   }
 
+  {
+    OATPP_LOGI(TAG, "Key interning...");
+
+    auto docs = oatpp::List<oatpp::Fields<oatpp::Any>>::createShared();
+    for(v_int32 i = 0; i < 100; i ++) {
+      auto doc = oatpp::Fields<oatpp::Any>::createShared();
+      doc->push_back({"name", oatpp::Any(oatpp::String("doc_" + std::to_string(i)))});
+      doc->push_back({"index", oatpp::Any(oatpp::Int32(i))});
+      doc->push_back({"a_very_long_key_which_is_not_interned", oatpp::Any(oatpp::Boolean(true))});
+      docs->push_back(doc);
+    }
+
+    auto bson = bsonMapper.writeToString(docs);
+
+    auto table = oatpp::mongo::bson::mapping::KeyInternTable::createShared(1024, 16);
+    auto deserializerConfig = oatpp::mongo::bson::mapping::Deserializer::Config::createShared();
+    deserializerConfig->keyInternTable = table;
+    oatpp::mongo::bson::mapping::ObjectMapper internMapper(oatpp::mongo::bson::mapping::Serializer::Config::createShared(), deserializerConfig);
+
+    auto result = internMapper.readFromString<oatpp::List<oatpp::Fields<oatpp::Any>>>(bson);
+    OATPP_ASSERT(result->size() == 100);
+    OATPP_ASSERT(table->getKeysCount() == 2);
+
+    auto first = result->front();
+    for(auto& doc : *result) {
+      OATPP_ASSERT(doc->size() == 3);
+      auto it = doc->begin();
+      auto firstIt = first->begin();
+      OATPP_ASSERT(it->first == "name");
+      OATPP_ASSERT(it->first.get() == firstIt->first.get());
+      ++ it; ++ firstIt;
+      OATPP_ASSERT(it->first == "index");
+      OATPP_ASSERT(it->first.get() == firstIt->first.get());
+      ++ it; ++ firstIt;
+      OATPP_ASSERT(it->first == "a_very_long_key_which_is_not_interned");
+      OATPP_ASSERT(doc.get() == first.get() || it->first.get() != firstIt->first.get());
+    }
+
+    OATPP_ASSERT(internMapper.writeToString(result) == bson);
+
+    /* frozen table keeps serving interned keys but doesn't grow */
+    OATPP_ASSERT(!table->isFrozen());
+    table->freeze();
+    OATPP_ASSERT(table->isFrozen());
+    auto frozenResult = internMapper.readFromString<oatpp::List<oatpp::Fields<oatpp::Any>>>(bson);
+    OATPP_ASSERT(table->getKeysCount() == 2);
+    OATPP_ASSERT(frozenResult->front()->begin()->first.get() == first->begin()->first.get());
+
+    bool thrown = false;
+    try {
+      table->clear();
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+
+    /* full table is not frozen - it can be cleared and reused for the next batch */
+    auto smallTable = oatpp::mongo::bson::mapping::KeyInternTable::createShared(1);
+    deserializerConfig->keyInternTable = smallTable;
+    auto smallResult = internMapper.readFromString<oatpp::List<oatpp::Fields<oatpp::Any>>>(bson);
+    OATPP_ASSERT(smallTable->getKeysCount() == 1);
+    OATPP_ASSERT(!smallTable->isFrozen());
+
+    auto generation = smallTable->getGeneration();
+    smallTable->clear();
+    OATPP_ASSERT(smallTable->getKeysCount() == 0);
+    OATPP_ASSERT(smallTable->getGeneration() != generation);
+
+    /* keys of the cleared generation are not served from the thread cache */
+    auto clearedResult = internMapper.readFromString<oatpp::List<oatpp::Fields<oatpp::Any>>>(bson);
+    OATPP_ASSERT(smallTable->getKeysCount() == 1);
+    OATPP_ASSERT(clearedResult->front()->begin()->first == "name");
+    OATPP_ASSERT(clearedResult->front()->begin()->first.get() != smallResult->front()->begin()->first.get());
+    OATPP_ASSERT(clearedResult->back()->begin()->first.get() == clearedResult->front()->begin()->first.get());
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
 }
 
 }}}}
\ No newline at end of file
@@ -0,0 +1,202 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "NestingTest.hpp"
+
+#include "oatpp-mongo/bson/mapping/ObjectMapper.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include "oatpp/Types.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+namespace oatpp { namespace mongo { namespace test { namespace bson {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Item : public oatpp::DTO {
+
+  DTO_INIT(Item, DTO)
+
+  DTO_FIELD(Int32, index);
+  DTO_FIELD(String, name);
+  DTO_FIELD(List<Float64>, values);
+
+};
+
+class Group : public oatpp::DTO {
+
+  DTO_INIT(Group, DTO)
+
+  DTO_FIELD(String, name);
+  DTO_FIELD(List<Object<Item>>, items) = List<Object<Item>>::createShared();
+  DTO_FIELD(Fields<Any>, meta);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+typedef oatpp::mongo::bson::mapping::ObjectMapper ObjectMapper;
+typedef oatpp::mongo::bson::mapping::Serializer Serializer;
+typedef oatpp::mongo::bson::mapping::Deserializer Deserializer;
+
+/* nest `depth` documents {"a": {"a": ... {}}} */
+oatpp::String makeNestedDocument(v_int32 depth) {
+  std::string doc = std::string("\x05\x00\x00\x00\x00", 5);
+  for(v_int32 i = 0; i < depth; i ++) {
+    std::string outer;
+    v_int32 size = 4 + 1 + 2 + (v_int32) doc.size() + 1;
+    outer.append((const char*) &size, 4);
+    outer.push_back(0x03);
+    outer.append("a", 2);
+    outer.append(doc);
+    outer.push_back(0);
+    doc = outer;
+  }
+  return doc;
+}
+
+oatpp::Object<Group> createGroup(v_int32 itemsCount) {
+  auto group = Group::createShared();
+  group->name = "group";
+  for(v_int32 i = 0; i < itemsCount; i ++) {
+    auto item = Item::createShared();
+    item->index = i;
+    item->name = "item_" + std::to_string(i);
+    item->values = oatpp::List<oatpp::Float64>::createShared();
+    item->values->push_back(i * 0.5);
+    item->values->push_back(i * 1.5);
+    group->items->push_back(item);
+  }
+  group->meta = oatpp::Fields<oatpp::Any>::createShared();
+  group->meta->push_back({"kind", oatpp::Any(oatpp::String("test"))});
+  return group;
+}
+
+std::shared_ptr<ObjectMapper> createMapper(v_int32 maxDepth) {
+  auto config = Deserializer::Config::createShared();
+  config->maxDepth = maxDepth;
+  return std::make_shared<ObjectMapper>(Serializer::Config::createShared(), config);
+}
+
+/* read nested document as Any and count its depth */
+v_int32 readDepth(const std::shared_ptr<ObjectMapper>& mapper, const oatpp::String& bson, bool& error) {
+
+  oatpp::utils::parser::Caret caret(bson);
+  oatpp::data::mapping::ErrorStack errorStack;
+  oatpp::Any any = mapper->read(caret, oatpp::Any::Class::getType(), errorStack).cast<oatpp::Any>();
+
+  error = caret.hasError();
+  if(error) {
+    return 0;
+  }
+
+  v_int32 depth = 0;
+  auto fields = any.retrieve<oatpp::Fields<oatpp::Any>>();
+  while(fields) {
+    depth ++;
+    if(fields->empty()) {
+      break;
+    }
+    fields = fields["a"].retrieve<oatpp::Fields<oatpp::Any>>();
+  }
+
+  return depth;
+
+}
+
+}
+
+void NestingTest::onRun() {
+
+  {
+    OATPP_LOGI(TAG, "max depth...");
+
+    auto mapper = createMapper(128);
+    bool error;
+
+    OATPP_ASSERT(readDepth(mapper, makeNestedDocument(127), error) == 128);
+    OATPP_ASSERT(!error);
+    readDepth(mapper, makeNestedDocument(128), error);
+    OATPP_ASSERT(error);
+
+    OATPP_LOGI(TAG, "max depth - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "deep document...");
+    auto mapper = createMapper(1001);
+    bool error;
+    OATPP_ASSERT(readDepth(mapper, makeNestedDocument(1000), error) == 1001);
+    OATPP_ASSERT(!error);
+    OATPP_LOGI(TAG, "deep document - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "malformed nested document...");
+    std::string doc = *makeNestedDocument(10);
+    doc[doc.size() - 3] = 1; // terminator of the inner document
+    auto mapper = createMapper(128);
+    bool error;
+    readDepth(mapper, doc, error);
+    OATPP_ASSERT(error);
+    OATPP_LOGI(TAG, "malformed nested document - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "explicit stack performance...");
+
+    auto mapper = createMapper(128);
+
+    auto bson = mapper->writeToString(createGroup(1000));
+    auto nested = makeNestedDocument(100);
+
+    auto group = mapper->readFromString<oatpp::Object<Group>>(bson);
+    OATPP_ASSERT(group->items->size() == 1000);
+    OATPP_ASSERT(mapper->writeToString(group) == bson);
+
+    const v_int32 iterations = 100;
+
+    {
+      oatpp::test::PerformanceChecker checker("explicit stack - wide");
+      for(v_int32 i = 0; i < iterations; i ++) {
+        mapper->readFromString<oatpp::Object<Group>>(bson);
+      }
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("explicit stack - deep");
+      for(v_int32 i = 0; i < iterations * 10; i ++) {
+        mapper->readFromString<oatpp::Any>(nested);
+      }
+    }
+    OATPP_LOGI(TAG, "explicit stack performance - OK");
+  }
+
+}
+
+}}}}
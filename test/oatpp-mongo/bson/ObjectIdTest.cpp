@@ -0,0 +1,368 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ObjectIdTest.hpp"
+
+#include "oatpp-mongo/bson/type/ObjectIdMap.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unordered_set>
+
+namespace oatpp { namespace mongo { namespace test { namespace bson {
+
+namespace {
+
+typedef oatpp::mongo::bson::type::ObjectId ObjectId;
+typedef oatpp::mongo::bson::type::ObjectIdSet ObjectIdSet;
+
+v_uint32 getCounter(const ObjectId& id) {
+  p_char8 data = id.getData();
+  return ((v_uint32) data[9] << 16) | ((v_uint32) data[10] << 8) | (v_uint32) data[11];
+}
+
+std::string getBytes(const ObjectId& id) {
+  return std::string((const char*) id.getData(), ObjectId::DATA_SIZE);
+}
+
+void runThreads(v_int32 threadsCount, const std::function<void()>& task) {
+  std::vector<std::thread> threads;
+  for(v_int32 i = 0; i < threadsCount; i ++) {
+    threads.emplace_back(task);
+  }
+  for(auto& thread : threads) {
+    thread.join();
+  }
+}
+
+}
+
+void ObjectIdTest::onRun() {
+
+  {
+    OATPP_LOGI(TAG, "timestamp...");
+    v_uint32 now = (v_uint32) std::chrono::duration_cast<std::chrono::seconds>
+      (std::chrono::system_clock::now().time_since_epoch()).count();
+    ObjectId id;
+    OATPP_ASSERT(id.getTimestamp() + 2 >= now && id.getTimestamp() <= now + 2);
+    OATPP_LOGI(TAG, "timestamp - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "counters of one thread are consecutive...");
+    /* fresh thread - starts with a new counter block */
+    std::thread thread([]{
+      ObjectId prev;
+      for(v_uint32 i = 1; i < ObjectId::COUNTER_BLOCK_SIZE; i ++) {
+        ObjectId id;
+        /* block is dropped when the second changes - counters restart from a new block */
+        if(id.getTimestamp() == prev.getTimestamp()) {
+          OATPP_ASSERT(getCounter(id) == ((getCounter(prev) + 1) & 0xFFFFFF));
+        }
+        prev = id;
+      }
+    });
+    thread.join();
+    OATPP_LOGI(TAG, "counters of one thread are consecutive - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "bulk generate...");
+
+    std::vector<ObjectId> ids;
+    ObjectId::generate(5000, ids);
+    OATPP_ASSERT(ids.size() == 5000);
+    for(v_int32 i = 1; i < 5000; i ++) {
+      OATPP_ASSERT(getCounter(ids[i]) == ((getCounter(ids[0]) + i) & 0xFFFFFF));
+    }
+
+    v_char8 raw[ObjectId::DATA_SIZE * 3];
+    ObjectId::generate(3, raw);
+    ObjectId last(raw + ObjectId::DATA_SIZE * 2);
+    OATPP_ASSERT(last.getTimestamp() >= ids[0].getTimestamp());
+    OATPP_ASSERT(last != ids.back());
+
+    bool thrown = false;
+    try {
+      ObjectId::generate(ObjectId::MAX_GENERATE_COUNT + 1, raw);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+
+    OATPP_LOGI(TAG, "bulk generate - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "uniqueness across threads...");
+
+    const v_int32 threadsCount = 8;
+    const v_int32 idsCount = 50000;
+
+    std::unordered_set<std::string> all;
+    std::mutex mutex;
+
+    runThreads(threadsCount, [&]{
+      std::vector<std::string> local;
+      for(v_int32 i = 0; i < idsCount; i ++) {
+        local.push_back(getBytes(ObjectId()));
+      }
+      std::vector<ObjectId> bulk;
+      ObjectId::generate(idsCount, bulk);
+      for(auto& id : bulk) {
+        local.push_back(getBytes(id));
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      all.insert(local.begin(), local.end());
+    });
+
+    OATPP_ASSERT(all.size() == (size_t) threadsCount * idsCount * 2);
+
+    OATPP_LOGI(TAG, "uniqueness across threads - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "hex string...");
+
+    ObjectId id = ObjectId::fromString("507F1F77bcf86cd799439011");
+    OATPP_ASSERT(id.toString() == "507f1f77bcf86cd799439011");
+    OATPP_ASSERT(id.getTimestamp() == 0x507f1f77);
+
+    char buffer[ObjectId::STRING_SIZE];
+    id.toString(buffer);
+    OATPP_ASSERT(std::string(buffer, ObjectId::STRING_SIZE) == "507f1f77bcf86cd799439011");
+
+    ObjectId generated;
+    OATPP_ASSERT(ObjectId::fromString(generated.toString()) == generated);
+
+    ObjectId result = id;
+    OATPP_ASSERT(!ObjectId::tryParse("507f1f77bcf86cd79943901g", 24, result));
+    OATPP_ASSERT(!ObjectId::tryParse("507f1f77bcf86cd79943901", 23, result));
+    OATPP_ASSERT(!ObjectId::tryParse("507f1f77bcf86cd7994390110", 25, result));
+    OATPP_ASSERT(!ObjectId::tryParse("507f1f77-cf86cd799439011", 24, result));
+    OATPP_ASSERT(!ObjectId::tryParse(nullptr, 24, result));
+    OATPP_ASSERT(result == id);
+
+    bool thrown = false;
+    try {
+      ObjectId::fromString(nullptr);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+
+    OATPP_LOGI(TAG, "hex string - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "hex performance...");
+
+    std::vector<ObjectId> ids;
+    ObjectId::generate(10000, ids);
+    std::vector<char> strings(ids.size() * ObjectId::STRING_SIZE);
+
+    {
+      oatpp::test::PerformanceChecker checker("encode 100 x 10000");
+      for(v_int32 i = 0; i < 100; i ++) {
+        for(size_t j = 0; j < ids.size(); j ++) {
+          ids[j].toString(&strings[j * ObjectId::STRING_SIZE]);
+        }
+      }
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("decode 100 x 10000");
+      ObjectId result = ids[0];
+      for(v_int32 i = 0; i < 100; i ++) {
+        for(size_t j = 0; j < ids.size(); j ++) {
+          OATPP_ASSERT(ObjectId::tryParse(&strings[j * ObjectId::STRING_SIZE], ObjectId::STRING_SIZE, result));
+        }
+      }
+      OATPP_ASSERT(result == ids.back());
+    }
+
+    OATPP_LOGI(TAG, "hex performance - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "ordering and hash...");
+
+    ObjectId a = ObjectId::fromString("000000010000000000000002");
+    ObjectId b = ObjectId::fromString("000000010000000000000010");
+    ObjectId c = ObjectId::fromString("ff0000000000000000000000");
+
+    OATPP_ASSERT(a < b && b < c && a < c);
+    OATPP_ASSERT(c > b && b >= b && a <= a && !(b < a));
+
+    std::set<ObjectId> sorted = {c, a, b};
+    OATPP_ASSERT(sorted.begin()->toString() == a.toString());
+    OATPP_ASSERT(sorted.rbegin()->toString() == c.toString());
+
+    OATPP_ASSERT(a.hashCode() == ObjectId::fromString(a.toString()).hashCode());
+    OATPP_ASSERT(a.hashCode() != b.hashCode());
+    OATPP_ASSERT(std::hash<ObjectId>()(c) == c.hashCode());
+
+    OATPP_LOGI(TAG, "ordering and hash - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "time bounds...");
+
+    OATPP_ASSERT(ObjectId::minForTime(0x507f1f77).toString() == "507f1f770000000000000000");
+    OATPP_ASSERT(ObjectId::maxForTime(0x507f1f77).toString() == "507f1f77ffffffffffffffff");
+    OATPP_ASSERT(ObjectId::maxForTime(0xFFFFFFFF).getTimestamp() == 0xFFFFFFFF);
+
+    ObjectId id;
+    OATPP_ASSERT(ObjectId::minForTime(id.getTimestamp()) <= id);
+    OATPP_ASSERT(id <= ObjectId::maxForTime(id.getTimestamp()));
+    OATPP_ASSERT(id < ObjectId::minForTime(id.getTimestamp() + 1));
+
+    auto ranges = ObjectId::splitTimeRange(1000, 1010, 3);
+    OATPP_ASSERT(ranges.size() == 3);
+    OATPP_ASSERT(ranges[0].lowerBound == ObjectId::minForTime(1000));
+    OATPP_ASSERT(ranges[0].upperBound == ObjectId::minForTime(1003));
+    OATPP_ASSERT(ranges[1].lowerBound == ranges[0].upperBound);
+    OATPP_ASSERT(ranges[2].lowerBound == ranges[1].upperBound);
+    OATPP_ASSERT(ranges[2].upperBound == ObjectId::minForTime(1010));
+
+    OATPP_ASSERT(ObjectId::splitTimeRange(1000, 1002, 4).size() == 2);
+    OATPP_ASSERT(ObjectId::splitTimeRange(1000, 1000, 4).empty());
+    OATPP_ASSERT(ObjectId::splitTimeRange(0, 0xFFFFFFFF, 7).back().upperBound == ObjectId::minForTime(0xFFFFFFFF));
+
+    bool thrown = false;
+    try {
+      ObjectId::splitTimeRange(10, 5, 1);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+
+    OATPP_LOGI(TAG, "time bounds - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "ObjectIdSet / ObjectIdMap...");
+
+    std::vector<ObjectId> ids;
+    ObjectId::generate(100000, ids);
+
+    ObjectIdSet set;
+    for(auto& id : ids) {
+      OATPP_ASSERT(set.insert(id));
+    }
+    for(auto& id : ids) {
+      OATPP_ASSERT(!set.insert(id));
+    }
+    OATPP_ASSERT(set.size() == (v_buff_size) ids.size());
+    for(v_buff_size i = 0; i < (v_buff_size) ids.size(); i ++) {
+      OATPP_ASSERT(set.indexOf(ids[i]) == i);
+      OATPP_ASSERT(set.get(i) == ids[i]);
+    }
+    OATPP_ASSERT(!set.contains(ObjectId()));
+
+    oatpp::mongo::bson::type::ObjectIdMap<v_int32> counts;
+    for(v_int32 i = 0; i < 1000; i ++) {
+      counts[ids[i % 100]] ++;
+    }
+    OATPP_ASSERT(counts.size() == 100);
+    OATPP_ASSERT(*counts.find(ids[5]) == 10);
+    OATPP_ASSERT(counts.find(ids[500]) == nullptr);
+    OATPP_ASSERT(!counts.insert(ids[0], 0));
+    OATPP_ASSERT(counts.getKey(7) == ids[7] && counts.getValue(7) == 10);
+
+    set.clear();
+    OATPP_ASSERT(set.size() == 0 && !set.contains(ids[0]));
+
+    OATPP_LOGI(TAG, "ObjectIdSet / ObjectIdMap - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "dedup performance...");
+
+    std::vector<ObjectId> ids;
+    ObjectId::generate(1000000, ids);
+
+    {
+      oatpp::test::PerformanceChecker checker("ObjectIdSet dedup 1M x 2");
+      ObjectIdSet set;
+      for(v_int32 pass = 0; pass < 2; pass ++) {
+        for(auto& id : ids) {
+          set.insert(id);
+        }
+      }
+      OATPP_ASSERT(set.size() == 1000000);
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("std::unordered_set<std::string> hex dedup 1M x 2");
+      std::unordered_set<std::string> set;
+      for(v_int32 pass = 0; pass < 2; pass ++) {
+        for(auto& id : ids) {
+          set.insert(*id.toString());
+        }
+      }
+      OATPP_ASSERT(set.size() == 1000000);
+    }
+
+    OATPP_LOGI(TAG, "dedup performance - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "multi-threaded throughput...");
+
+    const v_int32 threadsCount = 32;
+    const v_int32 idsCount = 100000;
+
+    {
+      oatpp::test::PerformanceChecker checker("32 threads x 100000 ObjectId()");
+      runThreads(threadsCount, [&]{
+        for(v_int32 i = 0; i < idsCount; i ++) {
+          ObjectId id;
+          (void) id;
+        }
+      });
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("32 threads x 100 x generate(1000)");
+      runThreads(threadsCount, [&]{
+        std::vector<v_char8> buffer(1000 * ObjectId::DATA_SIZE);
+        for(v_int32 i = 0; i < idsCount / 1000; i ++) {
+          ObjectId::generate(1000, buffer.data());
+        }
+      });
+    }
+
+    OATPP_LOGI(TAG, "multi-threaded throughput - OK");
+  }
+
+}
+
+}}}}
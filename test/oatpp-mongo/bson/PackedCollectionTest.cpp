@@ -0,0 +1,205 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "PackedCollectionTest.hpp"
+
+#include "oatpp-mongo/bson/mapping/ObjectMapper.hpp"
+
+#include "oatpp-test/Checker.hpp"
+
+#include "oatpp/Types.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+namespace oatpp { namespace mongo { namespace test { namespace bson {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Embedding : public oatpp::DTO {
+
+  DTO_INIT(Embedding, DTO)
+
+  DTO_FIELD(String, name);
+  DTO_FIELD(Vector<Float32>, values);
+  DTO_FIELD(List<Int64>, ids);
+  DTO_FIELD(Vector<Int32>, empty);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+typedef oatpp::mongo::bson::mapping::ObjectMapper ObjectMapper;
+
+template<class Collection>
+void disablePacked(const std::shared_ptr<ObjectMapper>& mapper) {
+  mapper->getSerializer()->setPackedMethod(Collection::Class::getType(), nullptr);
+  mapper->getDeserializer()->setPackedMethod(Collection::Class::getType(), nullptr);
+}
+
+std::shared_ptr<ObjectMapper> createGenericMapper() {
+  auto mapper = std::make_shared<ObjectMapper>();
+  disablePacked<oatpp::Vector<oatpp::Int32>>(mapper);
+  disablePacked<oatpp::Vector<oatpp::Int64>>(mapper);
+  disablePacked<oatpp::Vector<oatpp::Float32>>(mapper);
+  disablePacked<oatpp::Vector<oatpp::Float64>>(mapper);
+  disablePacked<oatpp::List<oatpp::Int32>>(mapper);
+  disablePacked<oatpp::List<oatpp::Int64>>(mapper);
+  disablePacked<oatpp::List<oatpp::Float32>>(mapper);
+  disablePacked<oatpp::List<oatpp::Float64>>(mapper);
+  return mapper;
+}
+
+oatpp::Object<Embedding> createEmbedding(v_int32 size) {
+  auto obj = Embedding::createShared();
+  obj->name = "embedding";
+  obj->values = oatpp::Vector<oatpp::Float32>::createShared();
+  obj->ids = oatpp::List<oatpp::Int64>::createShared();
+  obj->empty = oatpp::Vector<oatpp::Int32>::createShared();
+  for(v_int32 i = 0; i < size; i ++) {
+    obj->values->push_back(i * 0.5f);
+    obj->ids->push_back((v_int64) i * 100000000000);
+  }
+  return obj;
+}
+
+}
+
+void PackedCollectionTest::onRun() {
+
+  auto mapper = std::make_shared<ObjectMapper>();
+  auto genericMapper = createGenericMapper();
+
+  {
+    OATPP_LOGI(TAG, "packed vs generic encoding...");
+    auto obj = createEmbedding(1536);
+    auto bson = mapper->writeToString(obj);
+    OATPP_ASSERT(bson == genericMapper->writeToString(obj));
+
+    auto result = mapper->readFromString<oatpp::Object<Embedding>>(bson);
+    OATPP_ASSERT(result->name == "embedding");
+    OATPP_ASSERT(result->values->size() == 1536);
+    OATPP_ASSERT(result->ids->size() == 1536);
+    OATPP_ASSERT(result->empty->size() == 0);
+    OATPP_ASSERT(result->values[1535] == 767.5f);
+    OATPP_ASSERT(result->ids->back() == (v_int64) 1535 * 100000000000);
+    OATPP_ASSERT(genericMapper->writeToString(result) == bson);
+    OATPP_LOGI(TAG, "packed vs generic encoding - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "null items...");
+    oatpp::Vector<oatpp::Float64> vector = {1.5, nullptr, 3.5};
+    auto bson = mapper->writeToString(vector);
+    OATPP_ASSERT(bson == genericMapper->writeToString(vector));
+
+    auto result = mapper->readFromString<oatpp::Vector<oatpp::Float64>>(bson);
+    OATPP_ASSERT(result->size() == 3);
+    OATPP_ASSERT(result[0] == 1.5);
+    OATPP_ASSERT(!result[1]);
+    OATPP_ASSERT(result[2] == 3.5);
+
+    auto config = oatpp::mongo::bson::mapping::Serializer::Config::createShared();
+    config->includeNullFields = false;
+    ObjectMapper skipNullsMapper(config, oatpp::mongo::bson::mapping::Deserializer::Config::createShared());
+    auto skipped = mapper->readFromString<oatpp::Vector<oatpp::Float64>>(skipNullsMapper.writeToString(vector));
+    OATPP_ASSERT(skipped->size() == 2);
+    OATPP_ASSERT(skipped[1] == 3.5);
+    OATPP_LOGI(TAG, "null items - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "enabled packed types...");
+    auto packedMapper = std::make_shared<ObjectMapper>();
+    packedMapper->getSerializer()->enablePacked<oatpp::Vector<oatpp::Int8>>();
+    packedMapper->getSerializer()->enablePacked<oatpp::Vector<oatpp::UInt32>>();
+    packedMapper->getSerializer()->enablePacked<oatpp::List<oatpp::UInt64>>();
+
+    oatpp::Vector<oatpp::Int8> int8s = oatpp::Vector<oatpp::Int8>::createShared();
+    oatpp::Vector<oatpp::UInt32> uint32s = oatpp::Vector<oatpp::UInt32>::createShared();
+    oatpp::List<oatpp::UInt64> uint64s = oatpp::List<oatpp::UInt64>::createShared();
+    for(v_int32 i = 0; i < 2000; i ++) {
+      int8s->push_back((v_int8) (i % 256 - 128));
+      uint32s->push_back((v_uint32) i * 2000000);
+      uint64s->push_back((v_uint64) i << 40);
+    }
+
+    OATPP_ASSERT(packedMapper->writeToString(int8s) == mapper->writeToString(int8s));
+    OATPP_ASSERT(packedMapper->writeToString(uint32s) == mapper->writeToString(uint32s));
+    OATPP_ASSERT(packedMapper->writeToString(uint64s) == mapper->writeToString(uint64s));
+    OATPP_LOGI(TAG, "enabled packed types - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "type mismatch...");
+    oatpp::Vector<oatpp::Float64> vector = {1.5, 2.5};
+    oatpp::utils::parser::Caret caret(mapper->writeToString(vector));
+    oatpp::data::mapping::ErrorStack errorStack;
+    mapper->read(caret, oatpp::Vector<oatpp::Int32>::Class::getType(), errorStack);
+    OATPP_ASSERT(caret.hasError());
+    OATPP_LOGI(TAG, "type mismatch - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "packed vs generic path...");
+
+    auto obj = createEmbedding(1536);
+    auto bson = mapper->writeToString(obj);
+    const v_int32 iterations = 1000;
+
+    {
+      oatpp::test::PerformanceChecker checker("packed write");
+      for(v_int32 i = 0; i < iterations; i ++) {
+        mapper->writeToString(obj);
+      }
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("generic write");
+      for(v_int32 i = 0; i < iterations; i ++) {
+        genericMapper->writeToString(obj);
+      }
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("packed read");
+      for(v_int32 i = 0; i < iterations; i ++) {
+        mapper->readFromString<oatpp::Object<Embedding>>(bson);
+      }
+    }
+
+    {
+      oatpp::test::PerformanceChecker checker("generic read");
+      for(v_int32 i = 0; i < iterations; i ++) {
+        genericMapper->readFromString<oatpp::Object<Embedding>>(bson);
+      }
+    }
+
+    OATPP_LOGI(TAG, "packed vs generic path - OK");
+  }
+
+}
+
+}}}}
@@ -0,0 +1,196 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "RawValueTest.hpp"
+
+#include "oatpp-mongo/bson/mapping/ObjectMapper.hpp"
+
+#include "oatpp/Types.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace mongo { namespace test { namespace bson {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class ObjWithRawValue : public oatpp::DTO {
+
+  DTO_INIT(ObjWithRawValue, DTO)
+
+  DTO_FIELD(String, name);
+  DTO_FIELD(oatpp::mongo::bson::RawValue, code);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+typedef oatpp::mongo::bson::TypeCode TypeCode;
+
+void appendInt32(std::string& buffer, v_int32 value) {
+  buffer.append((const char*) &value, 4);
+}
+
+void appendElement(std::string& doc, v_char8 typeCode, const char* key, const std::string& value) {
+  doc.push_back((char) typeCode);
+  doc.append(key, std::strlen(key) + 1);
+  doc.append(value);
+}
+
+std::string makeString(const std::string& value) {
+  std::string result;
+  appendInt32(result, (v_int32) value.size() + 1);
+  result.append(value);
+  result.push_back(0);
+  return result;
+}
+
+std::string makeDocument(const std::string& elements) {
+  std::string doc;
+  appendInt32(doc, (v_int32) elements.size() + 5);
+  doc.append(elements);
+  doc.push_back(0);
+  return doc;
+}
+
+/* document with an element of every BSON type */
+oatpp::String makeAllTypesDocument() {
+
+  std::string e;
+  v_int64 i64 = 1234567890123;
+  v_float64 f64 = 0.5;
+
+  appendElement(e, TypeCode::DOUBLE, "double", std::string((const char*) &f64, 8));
+  appendElement(e, TypeCode::STRING, "string", makeString("hello"));
+  appendElement(e, TypeCode::DOCUMENT_EMBEDDED, "doc", makeDocument(""));
+  appendElement(e, TypeCode::DOCUMENT_ARRAY, "array", makeDocument(""));
+  appendElement(e, TypeCode::BINARY, "binary", std::string("\x03\x00\x00\x00\x00" "abc", 8));
+  appendElement(e, TypeCode::UNDEFINED, "undefined", "");
+  appendElement(e, TypeCode::OBJECT_ID, "oid", std::string("0123456789ab"));
+  appendElement(e, TypeCode::BOOLEAN, "bool", std::string("\x01", 1));
+  appendElement(e, TypeCode::DATE_TIME, "date", std::string((const char*) &i64, 8));
+  appendElement(e, TypeCode::NULL_VALUE, "null", "");
+  appendElement(e, TypeCode::REGEXP, "regexp", std::string("^a.*b$\0imsx\0", 12));
+  appendElement(e, TypeCode::BD_POINTER, "dbPointer", makeString("db.coll") + "0123456789ab");
+  appendElement(e, TypeCode::JAVASCRIPT_CODE, "code", makeString("function() {}"));
+  appendElement(e, TypeCode::SYMBOL, "symbol", makeString("sym"));
+
+  std::string codeWithScope = makeString("function() { return x; }") + makeDocument("");
+  std::string codeWithScopeValue;
+  appendInt32(codeWithScopeValue, (v_int32) codeWithScope.size() + 4);
+  appendElement(e, TypeCode::JAVASCRIPT_CODE_WS, "codeWithScope", codeWithScopeValue + codeWithScope);
+
+  appendElement(e, TypeCode::INT_32, "int32", std::string("\x07\x00\x00\x00", 4));
+  appendElement(e, TypeCode::TIMESTAMP, "timestamp", std::string((const char*) &i64, 8));
+  appendElement(e, TypeCode::INT_64, "int64", std::string((const char*) &i64, 8));
+  appendElement(e, TypeCode::DECIMAL_128, "decimal", std::string("\x0A\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x3E\x30", 16));
+  appendElement(e, TypeCode::MIN_KEY, "minKey", "");
+  appendElement(e, TypeCode::MAX_KEY, "maxKey", "");
+
+  return makeDocument(e);
+
+}
+
+}
+
+void RawValueTest::onRun() {
+
+  oatpp::mongo::bson::mapping::ObjectMapper mapper;
+
+  {
+    OATPP_LOGI(TAG, "lossless Fields<Any>...");
+
+    auto bson = makeAllTypesDocument();
+    auto fields = mapper.readFromString<oatpp::Fields<oatpp::Any>>(bson);
+
+    OATPP_ASSERT(fields->size() == 21);
+    OATPP_ASSERT(fields["date"].getStoredType() == oatpp::mongo::bson::DateTime::Class::getType());
+
+    auto regexp = fields["regexp"].retrieve<oatpp::mongo::bson::RawValue>();
+    OATPP_ASSERT(regexp->getTypeCode() == TypeCode::REGEXP);
+    OATPP_ASSERT(regexp->getSize() == 12);
+
+    /* raw values point into the source buffer */
+    OATPP_ASSERT(regexp->getLabel().getMemoryHandle() == bson.getPtr());
+
+    auto minKey = fields["minKey"].retrieve<oatpp::mongo::bson::RawValue>();
+    OATPP_ASSERT(minKey->getTypeCode() == TypeCode::MIN_KEY);
+    OATPP_ASSERT(minKey->getSize() == 0);
+
+    OATPP_ASSERT(mapper.writeToString(fields) == bson);
+
+    OATPP_LOGI(TAG, "lossless Fields<Any> - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "nested unknown types...");
+
+    std::string nested;
+    appendElement(nested, TypeCode::MAX_KEY, "0", "");
+    appendElement(nested, TypeCode::SYMBOL, "1", makeString("sym"));
+
+    std::string e;
+    appendElement(e, TypeCode::DOCUMENT_ARRAY, "list", makeDocument(nested));
+    oatpp::String bson = makeDocument(e);
+
+    auto fields = mapper.readFromString<oatpp::Fields<oatpp::Any>>(bson);
+    auto list = fields["list"].retrieve<oatpp::List<oatpp::Any>>();
+    OATPP_ASSERT(list->size() == 2);
+    OATPP_ASSERT(mapper.writeToString(fields) == bson);
+
+    OATPP_LOGI(TAG, "nested unknown types - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "RawValue DTO field...");
+
+    std::string e;
+    appendElement(e, TypeCode::STRING, "name", makeString("obj"));
+    appendElement(e, TypeCode::JAVASCRIPT_CODE, "code", makeString("function() {}"));
+    oatpp::String bson = makeDocument(e);
+
+    auto obj = mapper.readFromString<oatpp::Object<ObjWithRawValue>>(bson);
+    OATPP_ASSERT(obj->name == "obj");
+    OATPP_ASSERT(obj->code->getTypeCode() == TypeCode::JAVASCRIPT_CODE);
+    OATPP_ASSERT(mapper.writeToString(obj) == bson);
+
+    /* RawValue field accepts element of any type */
+    std::string e2;
+    appendElement(e2, TypeCode::STRING, "name", makeString("obj"));
+    appendElement(e2, TypeCode::STRING, "code", makeString("not a code"));
+    oatpp::String bson2 = makeDocument(e2);
+
+    auto obj2 = mapper.readFromString<oatpp::Object<ObjWithRawValue>>(bson2);
+    OATPP_ASSERT(obj2->code->getTypeCode() == TypeCode::STRING);
+    OATPP_ASSERT(mapper.writeToString(obj2) == bson2);
+
+    OATPP_LOGI(TAG, "RawValue DTO field - OK");
+  }
+
+}
+
+}}}}
@@ -0,0 +1,265 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ReadIntoTest.hpp"
+
+#include "oatpp-mongo/bson/mapping/ObjectMapper.hpp"
+
+#include "oatpp/Types.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+namespace oatpp { namespace mongo { namespace test { namespace bson {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Item : public oatpp::DTO {
+
+  DTO_INIT(Item, DTO)
+
+  DTO_FIELD(String, name);
+  DTO_FIELD(Int32, value);
+
+};
+
+class Config : public oatpp::DTO {
+
+  DTO_INIT(Config, DTO)
+
+  DTO_FIELD(String, title);
+  DTO_FIELD(Int64, version);
+  DTO_FIELD(Boolean, enabled);
+  DTO_FIELD(Float64, ratio);
+  DTO_FIELD(Object<Item>, main);
+  DTO_FIELD(List<Object<Item>>, items);
+
+};
+
+class Tags : public oatpp::DTO {
+
+  DTO_INIT(Tags, DTO)
+
+  DTO_FIELD(UnorderedSet<String>, tags);
+
+};
+
+class PartialConfig : public oatpp::DTO {
+
+  DTO_INIT(PartialConfig, DTO)
+
+  DTO_FIELD(Int64, version);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+oatpp::Object<Config> createConfig(v_int64 version, v_int32 itemsCount) {
+  auto config = Config::createShared();
+  config->title = "config-" + std::to_string(version);
+  config->version = version;
+  config->enabled = (version % 2 == 0);
+  config->ratio = version * 0.5;
+  config->main = Item::createShared();
+  config->main->name = "main";
+  config->main->value = (v_int32) version;
+  config->items = oatpp::List<oatpp::Object<Item>>::createShared();
+  for(v_int32 i = 0; i < itemsCount; i ++) {
+    auto item = Item::createShared();
+    item->name = "item-" + std::to_string(i);
+    item->value = i + (v_int32) version;
+    config->items->push_back(item);
+  }
+  return config;
+}
+
+}
+
+void ReadIntoTest::onRun() {
+
+  oatpp::mongo::bson::mapping::ObjectMapper mapper;
+
+  {
+    OATPP_LOGI(TAG, "Read into existing object...");
+
+    auto target = createConfig(0, 3);
+
+    auto mainPtr = target->main.get();
+    auto titlePtr = target->title.get();
+    auto item0Ptr = target->items->front().get();
+
+    for(v_int64 version = 1; version <= 10; version ++) {
+
+      auto bson = mapper.writeToString(createConfig(version, 3));
+      auto object = target;
+      mapper.readInto(bson, object);
+
+      OATPP_ASSERT(object.get() == target.get());
+      OATPP_ASSERT(target->main.get() == mainPtr);
+      OATPP_ASSERT(target->title.get() == titlePtr);
+      OATPP_ASSERT(target->items->front().get() == item0Ptr);
+
+      OATPP_ASSERT(target->title == "config-" + std::to_string(version));
+      OATPP_ASSERT(target->version == version);
+      OATPP_ASSERT(target->enabled == (version % 2 == 0));
+      OATPP_ASSERT(target->ratio == version * 0.5);
+      OATPP_ASSERT(target->main->name == "main");
+      OATPP_ASSERT(target->main->value == version);
+      OATPP_ASSERT(target->items->size() == 3);
+
+      v_int32 i = 0;
+      for(auto& item : *target->items) {
+        OATPP_ASSERT(item->name == "item-" + std::to_string(i));
+        OATPP_ASSERT(item->value == i + version);
+        i ++;
+      }
+
+    }
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Read into existing object - collection resize...");
+
+    auto target = createConfig(0, 2);
+
+    auto object = target;
+    mapper.readInto(mapper.writeToString(createConfig(1, 5)), object);
+    OATPP_ASSERT(target->items->size() == 5);
+    OATPP_ASSERT(target->items->back()->name == "item-4");
+
+    mapper.readInto(mapper.writeToString(createConfig(2, 1)), object);
+    OATPP_ASSERT(target->items->size() == 1);
+    OATPP_ASSERT(target->items->front()->value == 2);
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Read into existing object - absent fields are kept...");
+
+    auto partial = PartialConfig::createShared();
+    partial->version = 77;
+
+    auto target = createConfig(0, 2);
+    auto object = target;
+    mapper.readInto(mapper.writeToString(partial), object);
+
+    OATPP_ASSERT(target->version == 77);
+    OATPP_ASSERT(target->title == "config-0");
+    OATPP_ASSERT(target->items->size() == 2);
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Read into existing object - nulls...");
+
+    auto source = createConfig(3, 2);
+    source->title = nullptr;
+    source->main = nullptr;
+
+    auto target = createConfig(0, 2);
+    auto object = target;
+    mapper.readInto(mapper.writeToString(source), object);
+
+    OATPP_ASSERT(target->title == nullptr);
+    OATPP_ASSERT(target->main == nullptr);
+    OATPP_ASSERT(target->version == 3);
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Read into existing object - shared values are not modified...");
+
+    auto target = createConfig(1, 2);
+
+    oatpp::String sharedTitle = target->title;
+    oatpp::Object<Item> sharedMain = target->main;
+    oatpp::Object<Item> sharedItem = target->items->front();
+
+    auto object = target;
+    mapper.readInto(mapper.writeToString(createConfig(5, 2)), object);
+
+    OATPP_ASSERT(target->title == "config-5");
+    OATPP_ASSERT(target->title.get() != sharedTitle.get());
+    OATPP_ASSERT(sharedTitle == "config-1");
+
+    OATPP_ASSERT(target->main->value == 5);
+    OATPP_ASSERT(target->main.get() != sharedMain.get());
+    OATPP_ASSERT(sharedMain->value == 1);
+
+    OATPP_ASSERT(target->items->front()->value == 5);
+    OATPP_ASSERT(target->items->front().get() != sharedItem.get());
+    OATPP_ASSERT(sharedItem->value == 1);
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Read into existing object - set items are not reused...");
+
+    auto source = Tags::createShared();
+    source->tags = oatpp::UnorderedSet<oatpp::String>::createShared();
+    source->tags->insert("x");
+    source->tags->insert("y");
+
+    oatpp::String a = "a";
+    auto target = Tags::createShared();
+    target->tags = oatpp::UnorderedSet<oatpp::String>::createShared();
+    target->tags->insert(a);
+    target->tags->insert("b");
+
+    auto object = target;
+    mapper.readInto(mapper.writeToString(source), object);
+
+    OATPP_ASSERT(target->tags->size() == 2);
+    OATPP_ASSERT(target->tags->find("x") != target->tags->end());
+    OATPP_ASSERT(target->tags->find("y") != target->tags->end());
+    OATPP_ASSERT(a == "a");
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "Read into null object...");
+
+    oatpp::Object<Config> target;
+    bool thrown = false;
+    try {
+      mapper.readInto(mapper.writeToString(createConfig(1, 1)), target);
+    } catch (const std::runtime_error& e) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+
+    OATPP_LOGI(TAG, "OK");
+  }
+
+}
+
+}}}}
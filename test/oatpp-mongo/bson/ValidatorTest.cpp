@@ -0,0 +1,196 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ValidatorTest.hpp"
+
+#include "oatpp-mongo/bson/Validator.hpp"
+#include "oatpp-mongo/bson/mapping/ObjectMapper.hpp"
+
+#include "oatpp/Types.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+namespace oatpp { namespace mongo { namespace test { namespace bson {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Nested : public oatpp::DTO {
+
+  DTO_INIT(Nested, DTO)
+
+  DTO_FIELD(String, name) = "nested";
+  DTO_FIELD(List<Int32>, values);
+
+};
+
+class Obj : public oatpp::DTO {
+
+  DTO_INIT(Obj, DTO)
+
+  DTO_FIELD(String, str) = "Hello World!";
+  DTO_FIELD(Int32, i32) = 32;
+  DTO_FIELD(Int64, i64) = 64;
+  DTO_FIELD(Float64, f64) = 0.64;
+  DTO_FIELD(Boolean, b) = true;
+  DTO_FIELD(String, nullStr);
+  DTO_FIELD(Object<Nested>, nested);
+  DTO_FIELD(List<Object<Nested>>, list);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+typedef oatpp::mongo::bson::Validator Validator;
+
+oatpp::Object<Nested> createNested() {
+  auto nested = Nested::createShared();
+  nested->values = oatpp::List<oatpp::Int32>::createShared();
+  nested->values->push_back(1);
+  nested->values->push_back(2);
+  nested->values->push_back(3);
+  return nested;
+}
+
+oatpp::Object<Obj> createObj() {
+  auto obj = Obj::createShared();
+  obj->nested = createNested();
+  obj->list = oatpp::List<oatpp::Object<Nested>>::createShared();
+  obj->list->push_back(createNested());
+  obj->list->push_back(createNested());
+  return obj;
+}
+
+/* {"a": <value>} where value is a string built from raw bytes */
+oatpp::String makeStringDocument(const std::string& value) {
+  std::string doc;
+  v_int32 docSize = 4 + 1 + 2 + 4 + (v_int32) value.size() + 1 + 1;
+  v_int32 strSize = (v_int32) value.size() + 1;
+  doc.append((const char*) &docSize, 4);
+  doc.push_back(0x02);
+  doc.append("a", 2);
+  doc.append((const char*) &strSize, 4);
+  doc.append(value);
+  doc.push_back(0);
+  doc.push_back(0);
+  return doc;
+}
+
+/* nest `depth` empty documents */
+oatpp::String makeNestedDocument(v_int32 depth) {
+  std::string doc = std::string("\x05\x00\x00\x00\x00", 5);
+  for(v_int32 i = 0; i < depth; i ++) {
+    std::string outer;
+    v_int32 size = 4 + 1 + 2 + (v_int32) doc.size() + 1;
+    outer.append((const char*) &size, 4);
+    outer.push_back(0x03);
+    outer.append("a", 2);
+    outer.append(doc);
+    outer.push_back(0);
+    doc = outer;
+  }
+  return doc;
+}
+
+}
+
+void ValidatorTest::onRun() {
+
+  oatpp::mongo::bson::mapping::ObjectMapper mapper;
+
+  auto bson = mapper.writeToString(createObj());
+
+  {
+    OATPP_LOGI(TAG, "valid document...");
+    Validator::Options options;
+    options.checkUtf8 = true;
+    auto result = Validator::validate(bson, options);
+    OATPP_ASSERT(result.valid);
+    OATPP_ASSERT(result.errorMessage == nullptr);
+    OATPP_LOGI(TAG, "valid document - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "truncated documents...");
+    for(v_buff_size i = 0; i < bson->size(); i ++) {
+      OATPP_ASSERT(!Validator::validate(bson->data(), i).valid);
+    }
+    OATPP_LOGI(TAG, "truncated documents - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "corrupted documents...");
+    std::string corrupted = *bson;
+    corrupted[corrupted.size() - 1] = 1;
+    OATPP_ASSERT(!Validator::validate(corrupted.data(), corrupted.size()).valid);
+
+    corrupted = *bson;
+    corrupted[4] = 0x42; // unknown type-code of the first element
+    auto result = Validator::validate(corrupted.data(), corrupted.size());
+    OATPP_ASSERT(!result.valid);
+    OATPP_ASSERT(result.errorPosition > 4);
+    OATPP_LOGI(TAG, "corrupted documents - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "array indexes...");
+    std::string arrDoc = *mapper.writeToString(createNested());
+    auto pos = arrDoc.find(std::string("1\0", 2));
+    OATPP_ASSERT(pos != std::string::npos);
+    arrDoc[pos] = '5';
+
+    OATPP_ASSERT(!Validator::validate(arrDoc.data(), arrDoc.size()).valid);
+
+    Validator::Options options;
+    options.checkArrayIndexes = false;
+    OATPP_ASSERT(Validator::validate(arrDoc.data(), arrDoc.size(), options).valid);
+    OATPP_LOGI(TAG, "array indexes - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "utf-8...");
+    Validator::Options options;
+    options.checkUtf8 = true;
+    OATPP_ASSERT(Validator::validate(makeStringDocument("Привіт"), options).valid);
+    OATPP_ASSERT(!Validator::validate(makeStringDocument("\xC0\xAF"), options).valid); // overlong
+    OATPP_ASSERT(!Validator::validate(makeStringDocument("\xED\xA0\x80"), options).valid); // surrogate
+    OATPP_ASSERT(!Validator::validate(makeStringDocument("abc\xE2\x82"), options).valid); // truncated
+    OATPP_ASSERT(Validator::validate(makeStringDocument("\xC0\xAF")).valid); // utf-8 is not checked by default
+    OATPP_LOGI(TAG, "utf-8 - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "depth...");
+    Validator::Options options;
+    options.maxDepth = 10;
+    OATPP_ASSERT(Validator::validate(makeNestedDocument(9), options).valid);
+    OATPP_ASSERT(!Validator::validate(makeNestedDocument(10), options).valid);
+    OATPP_ASSERT(!Validator::validate(makeNestedDocument(Validator::MAX_DEPTH + 10)).valid);
+    OATPP_LOGI(TAG, "depth - OK");
+  }
+
+}
+
+}}}}
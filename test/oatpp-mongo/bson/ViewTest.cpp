@@ -0,0 +1,160 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "ViewTest.hpp"
+
+#include "oatpp-mongo/bson/View.hpp"
+#include "oatpp-mongo/bson/mapping/ObjectMapper.hpp"
+
+#include "oatpp/Types.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+namespace oatpp { namespace mongo { namespace test { namespace bson {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Nested : public oatpp::DTO {
+
+  DTO_INIT(Nested, DTO)
+
+  DTO_FIELD(String, name) = "nested";
+  DTO_FIELD(List<Int32>, values);
+
+};
+
+class Obj : public oatpp::DTO {
+
+  DTO_INIT(Obj, DTO)
+
+  DTO_FIELD(String, str) = "Hello World!";
+  DTO_FIELD(Int32, i32) = 32;
+  DTO_FIELD(Int64, i64) = 64;
+  DTO_FIELD(Float64, f64) = 0.64;
+  DTO_FIELD(Boolean, b) = true;
+  DTO_FIELD(String, nullStr);
+  DTO_FIELD(Object<Nested>, nested);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+typedef oatpp::mongo::bson::View View;
+typedef oatpp::mongo::bson::Element Element;
+typedef oatpp::mongo::bson::ElementIterator ElementIterator;
+typedef oatpp::mongo::bson::TypeCode TypeCode;
+
+oatpp::Object<Obj> createObj() {
+  auto obj = Obj::createShared();
+  obj->nested = Nested::createShared();
+  obj->nested->values = oatpp::List<oatpp::Int32>::createShared();
+  obj->nested->values->push_back(1);
+  obj->nested->values->push_back(2);
+  obj->nested->values->push_back(3);
+  return obj;
+}
+
+}
+
+void ViewTest::onRun() {
+
+  oatpp::mongo::bson::mapping::ObjectMapper mapper;
+
+  auto bson = mapper.writeToString(createObj());
+  View view(bson);
+
+  OATPP_ASSERT(view.isValid());
+
+  {
+    OATPP_LOGI(TAG, "iterate...");
+    const char* keys[] = {"str", "i32", "i64", "f64", "b", "nullStr", "nested"};
+    v_int32 index = 0;
+    ElementIterator it = view.begin();
+    for(; it != view.end(); ++it) {
+      OATPP_ASSERT(index < 7);
+      OATPP_ASSERT(it->getKey() == keys[index]);
+      index ++;
+    }
+    OATPP_ASSERT(index == 7);
+    OATPP_ASSERT(!it.hasError());
+    OATPP_LOGI(TAG, "iterate - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "typed accessors...");
+    OATPP_ASSERT(view.find("str").asStringView() == "Hello World!");
+    OATPP_ASSERT(view.find("i32").asInt32() == 32);
+    OATPP_ASSERT(view.find("i32").asInt64() == 32);
+    OATPP_ASSERT(view.find("i64").asInt64() == 64);
+    OATPP_ASSERT(view.find("f64").asFloat64() == 0.64);
+    OATPP_ASSERT(view.find("b").asBoolean() == true);
+    OATPP_ASSERT(view.find("nullStr").isNull());
+
+    OATPP_ASSERT(view.find("str").asInt32(-1) == -1);
+    OATPP_ASSERT(view.find("i32").asStringView().data == nullptr);
+    OATPP_ASSERT(!view.find("unknown"));
+    OATPP_LOGI(TAG, "typed accessors - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "nested documents...");
+    View nested = view.find("nested").asDocumentView();
+    OATPP_ASSERT(nested.isValid());
+    OATPP_ASSERT(nested.find("name").asStringView() == "nested");
+
+    Element values = nested.find("values");
+    OATPP_ASSERT(values.getTypeCode() == TypeCode::DOCUMENT_ARRAY);
+
+    v_int32 expected = 1;
+    View array = values.asDocumentView();
+    for(ElementIterator it = array.begin(); it != array.end(); ++it) {
+      OATPP_ASSERT(it->asInt32() == expected);
+      expected ++;
+    }
+    OATPP_ASSERT(expected == 4);
+    OATPP_LOGI(TAG, "nested documents - OK");
+  }
+
+  {
+    OATPP_LOGI(TAG, "malformed documents...");
+    for(v_buff_size i = 0; i < bson->size(); i ++) {
+      View truncated(bson->data(), i);
+      OATPP_ASSERT(!truncated.isValid());
+      OATPP_ASSERT(truncated.begin().hasError() || truncated.begin() == truncated.end());
+    }
+
+    std::string corrupted = *bson;
+    corrupted[4] = 0x42; // unknown type-code of the first element
+    View corruptedView(corrupted.data(), corrupted.size());
+    ElementIterator it = corruptedView.begin();
+    OATPP_ASSERT(it == corruptedView.end());
+    OATPP_ASSERT(it.hasError());
+    OATPP_LOGI(TAG, "malformed documents - OK");
+  }
+
+}
+
+}}}}
@@ -0,0 +1,205 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "CursorBatchTest.hpp"
+
+#include "oatpp-mongo/driver/command/CursorBatch.hpp"
+#include "oatpp-mongo/bson/mapping/ObjectMapper.hpp"
+#include "oatpp-mongo/bson/Utils.hpp"
+
+#include "oatpp/Types.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace oatpp { namespace mongo { namespace test { namespace driver {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Doc : public oatpp::DTO {
+
+  DTO_INIT(Doc, DTO)
+
+  DTO_FIELD(Int32, index);
+  DTO_FIELD(String, name);
+
+};
+
+class Cursor : public oatpp::DTO {
+
+  DTO_INIT(Cursor, DTO)
+
+  DTO_FIELD(List<Object<Doc>>, firstBatch) = List<Object<Doc>>::createShared();
+  DTO_FIELD(Int64, id) = 123;
+  DTO_FIELD(String, ns) = "db.collection";
+
+};
+
+class Reply : public oatpp::DTO {
+
+  DTO_INIT(Reply, DTO)
+
+  DTO_FIELD(Object<Cursor>, cursor) = Cursor::createShared();
+  DTO_FIELD(Float64, ok) = 1.0;
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+}
+
+void CursorBatchTest::onRun() {
+
+  oatpp::mongo::bson::mapping::ObjectMapper bsonMapper;
+
+  const v_int32 docsCount = 1000;
+
+  auto reply = Reply::createShared();
+  for(v_int32 i = 0; i < docsCount; i ++) {
+    auto doc = Doc::createShared();
+    doc->index = i;
+    doc->name = "doc_" + std::to_string(i);
+    reply->cursor->firstBatch->push_back(doc);
+  }
+
+  auto body = std::make_shared<oatpp::mongo::driver::wire::BodySection>();
+  body->document = bsonMapper.writeToString(reply);
+
+  oatpp::mongo::driver::wire::OpMsg msg;
+  msg.sections.push_back(body);
+
+  oatpp::mongo::driver::command::CursorBatch batch;
+  batch.readFromOpMsg(msg);
+
+  OATPP_ASSERT(batch.getCursorId() == 123);
+  OATPP_ASSERT(batch.getNamespace() == "db.collection");
+  OATPP_ASSERT(batch.getDocuments().size() == docsCount);
+
+  {
+    auto docs = batch.deserialize<oatpp::Object<Doc>>(bsonMapper);
+    OATPP_ASSERT(docs.size() == docsCount);
+    for(v_int32 i = 0; i < docsCount; i ++) {
+      OATPP_ASSERT(docs[i]);
+      OATPP_ASSERT(docs[i]->index == i);
+    }
+  }
+
+  for(v_int32 threads = 1; threads <= 8; threads *= 2) {
+
+    oatpp::mongo::driver::command::WorkerPool pool(threads);
+    OATPP_ASSERT(pool.getThreadsCount() == threads);
+
+    /* same pool threads are reused by subsequent calls */
+    for(v_int32 round = 0; round < 3; round ++) {
+
+      auto docs = batch.deserialize<oatpp::Object<Doc>>(bsonMapper, &pool);
+      OATPP_ASSERT(docs.size() == docsCount);
+
+      for(v_int32 i = 0; i < docsCount; i ++) {
+        OATPP_ASSERT(docs[i]);
+        OATPP_ASSERT(docs[i]->index == i);
+        OATPP_ASSERT(docs[i]->name == "doc_" + std::to_string(i));
+      }
+
+    }
+
+  }
+
+  {
+    /* one document of the batch has an invalid type code of the 'index' field - slicing still succeeds */
+    std::string corrupted = *body->document;
+    const v_int32 badIndex = docsCount / 2;
+    v_char8 badIndexData[4];
+    oatpp::mongo::bson::Utils::storeLE<v_int32>(badIndexData, badIndex);
+    std::string pattern("\x10index\0", 7);
+    pattern.append((const char*) badIndexData, 4);
+    auto pos = corrupted.find(pattern);
+    OATPP_ASSERT(pos != std::string::npos);
+    corrupted[pos] = (char) 0x7E;
+
+    auto badBody = std::make_shared<oatpp::mongo::driver::wire::BodySection>();
+    badBody->document = oatpp::String(corrupted);
+
+    oatpp::mongo::driver::wire::OpMsg badMsg;
+    badMsg.sections.push_back(badBody);
+
+    oatpp::mongo::driver::command::CursorBatch badBatch;
+    badBatch.readFromOpMsg(badMsg);
+    OATPP_ASSERT(badBatch.getDocuments().size() == docsCount);
+
+    bool thrown = false;
+    try {
+      badBatch.deserialize<oatpp::Object<Doc>>(bsonMapper);
+    } catch (const std::runtime_error& e) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+
+    oatpp::mongo::driver::command::WorkerPool pool(4);
+
+    for(v_int32 round = 0; round < 3; round ++) {
+
+      thrown = false;
+      try {
+        badBatch.deserialize<oatpp::Object<Doc>>(bsonMapper, &pool);
+      } catch (const std::runtime_error& e) {
+        OATPP_LOGI(TAG, "Error: '%s'", e.what());
+        thrown = true;
+      }
+      OATPP_ASSERT(thrown);
+
+      /* the pool is still usable after a failed call */
+      auto docs = batch.deserialize<oatpp::Object<Doc>>(bsonMapper, &pool);
+      OATPP_ASSERT(docs.size() == docsCount);
+      for(v_int32 i = 0; i < docsCount; i ++) {
+        OATPP_ASSERT(docs[i]);
+        OATPP_ASSERT(docs[i]->index == i);
+      }
+
+    }
+  }
+
+  {
+    auto emptyReply = Reply::createShared();
+    auto emptyBody = std::make_shared<oatpp::mongo::driver::wire::BodySection>();
+    emptyBody->document = bsonMapper.writeToString(emptyReply);
+
+    oatpp::mongo::driver::wire::OpMsg emptyMsg;
+    emptyMsg.sections.push_back(emptyBody);
+
+    oatpp::mongo::driver::command::CursorBatch emptyBatch;
+    emptyBatch.readFromOpMsg(emptyMsg);
+
+    OATPP_ASSERT(emptyBatch.getDocuments().empty());
+    oatpp::mongo::driver::command::WorkerPool pool(4);
+    OATPP_ASSERT(emptyBatch.deserialize<oatpp::Object<Doc>>(bsonMapper, &pool).empty());
+  }
+
+}
+
+}}}}
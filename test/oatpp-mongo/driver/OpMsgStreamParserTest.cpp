@@ -0,0 +1,207 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *                         Benedikt-Alexander Mokroß <bam@icognize.de>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+#include "OpMsgStreamParserTest.hpp"
+
+#include "oatpp-mongo/driver/wire/OpMsgStreamParser.hpp"
+#include "oatpp-mongo/driver/wire/OpMsg.hpp"
+#include "oatpp-mongo/bson/mapping/ObjectMapper.hpp"
+
+#include "oatpp/data/stream/BufferStream.hpp"
+#include "oatpp/Types.hpp"
+#include "oatpp/macro/codegen.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace oatpp { namespace mongo { namespace test { namespace driver {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Doc : public oatpp::DTO {
+
+  DTO_INIT(Doc, DTO)
+
+  DTO_FIELD(Int32, index);
+  DTO_FIELD(String, name);
+
+};
+
+class Cursor : public oatpp::DTO {
+
+  DTO_INIT(Cursor, DTO)
+
+  DTO_FIELD(String, comment) = "skipped by the parser";
+  DTO_FIELD(List<Object<Doc>>, firstBatch) = List<Object<Doc>>::createShared();
+  DTO_FIELD(Int64, id) = 123;
+  DTO_FIELD(String, ns) = "db.collection";
+
+};
+
+class Reply : public oatpp::DTO {
+
+  DTO_INIT(Reply, DTO)
+
+  DTO_FIELD(Object<Doc>, header) = Doc::createShared();
+  DTO_FIELD(Object<Cursor>, cursor) = Cursor::createShared();
+  DTO_FIELD(Float64, ok) = 1.0;
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+}
+
+void OpMsgStreamParserTest::onRun() {
+
+  oatpp::mongo::bson::mapping::ObjectMapper bsonMapper;
+
+  const v_int32 batchCount = 100;
+  const v_int32 sequenceCount = 10;
+
+  auto reply = Reply::createShared();
+  for(v_int32 i = 0; i < batchCount; i ++) {
+    auto doc = Doc::createShared();
+    doc->index = i;
+    doc->name = "doc_" + std::to_string(i);
+    reply->cursor->firstBatch->push_back(doc);
+  }
+
+  auto body = std::make_shared<oatpp::mongo::driver::wire::BodySection>();
+  body->document = bsonMapper.writeToString(reply);
+
+  auto sequence = std::make_shared<oatpp::mongo::driver::wire::DocumentSequenceSection>("documents");
+  for(v_int32 i = 0; i < sequenceCount; i ++) {
+    auto doc = Doc::createShared();
+    doc->index = batchCount + i;
+    doc->name = "doc_" + std::to_string(batchCount + i);
+    sequence->documents.push_back(bsonMapper.writeToString(doc));
+  }
+
+  oatpp::mongo::driver::wire::OpMsg msg;
+  msg.sections.push_back(body);
+  msg.sections.push_back(sequence);
+
+  oatpp::data::stream::BufferOutputStream stream;
+  msg.writeToStream(&stream);
+  oatpp::String data = stream.toString();
+
+  const v_buff_size chunkSizes[] = {1, 3, 7, 64, 4096, (v_buff_size) data->size()};
+
+  for(v_buff_size chunkSize : chunkSizes) {
+
+    std::vector<oatpp::Object<Doc>> docs;
+
+    oatpp::mongo::driver::wire::OpMsgStreamParser parser([&docs, &bsonMapper](const oatpp::String& document) {
+      docs.push_back(bsonMapper.readFromString<oatpp::Object<Doc>>(document));
+    });
+
+    parser.reset(data->size());
+
+    for(v_buff_size pos = 0; pos < (v_buff_size) data->size(); pos += chunkSize) {
+      v_buff_size size = std::min(chunkSize, (v_buff_size) data->size() - pos);
+      OATPP_ASSERT(parser.feed(data->data() + pos, size) == size);
+    }
+
+    OATPP_ASSERT(parser.isFinished());
+    OATPP_ASSERT(!parser.hasError());
+    OATPP_ASSERT(parser.getCursorId() == 123);
+    OATPP_ASSERT(parser.getNamespace() == "db.collection");
+    OATPP_ASSERT(parser.getOk() == 1.0);
+    OATPP_ASSERT(parser.getSequenceIdentifier() == "documents");
+    OATPP_ASSERT(parser.getDocumentsCount() == batchCount + sequenceCount);
+    OATPP_ASSERT(docs.size() == batchCount + sequenceCount);
+
+    for(v_int32 i = 0; i < batchCount + sequenceCount; i ++) {
+      OATPP_ASSERT(docs[i]);
+      OATPP_ASSERT(docs[i]->index == i);
+      OATPP_ASSERT(docs[i]->name == "doc_" + std::to_string(i));
+    }
+
+  }
+
+  {
+    OATPP_LOGI(TAG, "Truncated message...");
+    oatpp::mongo::driver::wire::OpMsgStreamParser parser([](const oatpp::String& document) {});
+    parser.reset(data->size());
+    parser.feed(data->data(), data->size() - 1);
+    OATPP_ASSERT(!parser.isFinished());
+    OATPP_ASSERT(!parser.hasError());
+  }
+
+  {
+    OATPP_LOGI(TAG, "Corrupted document size...");
+    std::string corrupted = *data;
+    corrupted[5] = (char) 0xFF; // low byte of the body document size
+    corrupted[6] = (char) 0xFF;
+    oatpp::mongo::driver::wire::OpMsgStreamParser parser([](const oatpp::String& document) {});
+    parser.reset(corrupted.size());
+    parser.feed(corrupted.data(), corrupted.size());
+    OATPP_ASSERT(parser.hasError());
+    OATPP_LOGI(TAG, "Error: '%s'", parser.getErrorMessage());
+  }
+
+  {
+    OATPP_LOGI(TAG, "Throwing callback...");
+    v_int32 calls = 0;
+    bool fail = true;
+    oatpp::mongo::driver::wire::OpMsgStreamParser parser([&calls, &fail](const oatpp::String& document) {
+      calls ++;
+      if(fail) {
+        throw std::runtime_error("callback error");
+      }
+    });
+    parser.reset(data->size());
+
+    bool thrown = false;
+    try {
+      parser.feed(data->data(), data->size());
+    } catch (const std::runtime_error& e) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+    OATPP_ASSERT(calls == 1);
+    OATPP_ASSERT(parser.hasError());
+    OATPP_ASSERT(!parser.isFinished());
+
+    /* parser in the error state doesn't consume more data */
+    OATPP_ASSERT(parser.feed(data->data(), data->size()) == 0);
+    OATPP_ASSERT(calls == 1);
+
+    /* and is reusable after reset */
+    calls = 0;
+    fail = false;
+    parser.reset(data->size());
+    parser.feed(data->data(), data->size());
+    OATPP_ASSERT(parser.isFinished());
+    OATPP_ASSERT(calls == batchCount + sequenceCount);
+  }
+
+}
+
+}}}}
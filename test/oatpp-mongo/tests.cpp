@@ -35,6 +35,24 @@
 #include "oatpp-mongo/bson/MapTest.hpp"
 #include "oatpp-mongo/bson/ObjectTest.hpp"
 #include "oatpp-mongo/bson/InlineDocumentTest.hpp"
+#include "oatpp-mongo/bson/ReadIntoTest.hpp"
+#include "oatpp-mongo/bson/ValidatorTest.hpp"
+#include "oatpp-mongo/bson/ViewTest.hpp"
+#include "oatpp-mongo/bson/NestingTest.hpp"
+#include "oatpp-mongo/bson/DecodePlanTest.hpp"
+#include "oatpp-mongo/bson/PackedCollectionTest.hpp"
+#include "oatpp-mongo/bson/BinaryTest.hpp"
+#include "oatpp-mongo/bson/Decimal128Test.hpp"
+#include "oatpp-mongo/bson/RawValueTest.hpp"
+#include "oatpp-mongo/bson/ByteOrderTest.hpp"
+#include "oatpp-mongo/bson/ObjectIdTest.hpp"
+#include "oatpp-mongo/bson/DocumentTest.hpp"
+#include "oatpp-mongo/bson/BsonToJsonTest.hpp"
+#include "oatpp-mongo/bson/JsonToBsonTest.hpp"
+#include "oatpp-mongo/bson/ConcurrentMapperTest.hpp"
+
+#include "oatpp-mongo/driver/CursorBatchTest.hpp"
+#include "oatpp-mongo/driver/OpMsgStreamParserTest.hpp"
 
 #include "oatpp-test/UnitTest.hpp"
 
@@ -248,6 +266,24 @@ void runTests() {
   OATPP_RUN_TEST(oatpp::mongo::test::bson::ObjectTest);
 
   OATPP_RUN_TEST(oatpp::mongo::test::bson::InlineDocumentTest);
+  OATPP_RUN_TEST(oatpp::mongo::test::bson::ReadIntoTest);
+  OATPP_RUN_TEST(oatpp::mongo::test::bson::ValidatorTest);
+  OATPP_RUN_TEST(oatpp::mongo::test::bson::ViewTest);
+  OATPP_RUN_TEST(oatpp::mongo::test::bson::NestingTest);
+  OATPP_RUN_TEST(oatpp::mongo::test::bson::DecodePlanTest);
+  OATPP_RUN_TEST(oatpp::mongo::test::bson::PackedCollectionTest);
+  OATPP_RUN_TEST(oatpp::mongo::test::bson::BinaryTest);
+  OATPP_RUN_TEST(oatpp::mongo::test::bson::Decimal128Test);
+  OATPP_RUN_TEST(oatpp::mongo::test::bson::RawValueTest);
+  OATPP_RUN_TEST(oatpp::mongo::test::bson::ByteOrderTest);
+  OATPP_RUN_TEST(oatpp::mongo::test::bson::ObjectIdTest);
+  OATPP_RUN_TEST(oatpp::mongo::test::bson::DocumentTest);
+  OATPP_RUN_TEST(oatpp::mongo::test::bson::BsonToJsonTest);
+  OATPP_RUN_TEST(oatpp::mongo::test::bson::JsonToBsonTest);
+  OATPP_RUN_TEST(oatpp::mongo::test::bson::ConcurrentMapperTest);
+
+  OATPP_RUN_TEST(oatpp::mongo::test::driver::CursorBatchTest);
+  OATPP_RUN_TEST(oatpp::mongo::test::driver::OpMsgStreamParserTest);
 
 }
 